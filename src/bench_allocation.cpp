@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "s21_allocator.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+// Типичный обработчик запроса: много временных матриц разного размера.
+void Handler(const S21Matrix &a, const S21Matrix &b) {
+  S21Matrix sum = a + b;
+  S21Matrix transpose = sum.Transpose();
+  S21Matrix minor = transpose.Minor(0, 0);
+  S21Matrix product = a;
+  product.MulMatrix(b);
+  (void)minor;
+}
+
+template <typename Setup>
+void Measure(const char *name, const S21Matrix &a, const S21Matrix &b,
+             int requests, Setup setup) {
+  using Clock = std::chrono::steady_clock;
+  s21::ResetAllocationStats();
+  Clock::time_point start = Clock::now();
+  for (int request = 0; request < requests; ++request)
+    setup([&] { Handler(a, b); });
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  s21::AllocationStats stats = s21::GetAllocationStats();
+  std::printf("%-8s %12.1f %14zu %16zu %14zu\n", name,
+              1e6 * seconds / requests, stats.allocations,
+              stats.system_allocations, stats.system_bytes);
+}
+
+}  // namespace
+
+// Использование: ./allocation_bench [size] [requests]
+int main(int argc, char **argv) {
+  int size = argc > 1 ? std::atoi(argv[1]) : 32;
+  int requests = argc > 2 ? std::atoi(argv[2]) : 20000;
+  S21Matrix a(size, size), b(size, size);
+  for (int i = 0; i < size; ++i)
+    for (int j = 0; j < size; ++j) {
+      a[i][j] = i + j * 0.5;
+      b[i][j] = i - j;
+    }
+
+  std::printf("matrix %dx%d, %d requests\n", size, size, requests);
+  std::printf("%-8s %12s %14s %16s %14s\n", "mode", "us/request",
+              "allocations", "system allocs", "system bytes");
+  Measure("system", a, b, requests, [](auto handler) { handler(); });
+  s21::PoolAllocator pool;
+  Measure("pool", a, b, requests, [&](auto handler) {
+    s21::AllocatorScope scope(pool);
+    handler();
+  });
+  Measure("arena", a, b, requests, [](auto handler) {
+    s21::ArenaScope arena(1 << 16);
+    handler();
+  });
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "s21_matrix_batch.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+template <typename Function>
+double BestSeconds(Function function, int repeats) {
+  using Clock = std::chrono::steady_clock;
+  double best = 1e30;
+  for (int run = 0; run < repeats; ++run) {
+    Clock::time_point start = Clock::now();
+    function();
+    best = std::min(
+        best, std::chrono::duration<double>(Clock::now() - start).count());
+  }
+  return best;
+}
+
+// Одни и те же count матриц n x n по одной в S21Matrix и пакетом.
+void Measure(int n, int count, int repeats) {
+  S21MatrixBatch batch(count, n, n);
+  std::vector<S21Matrix> matrices(count, S21Matrix(n, n));
+  for (int b = 0; b < count; ++b) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        double value = (b + i * 5 + j * 3) % 9 - 4 + (i == j) * 20;
+        batch(b, i, j) = value;
+        matrices[b](i, j) = value;
+      }
+    }
+  }
+  double multiply_single = BestSeconds(
+      [&] {
+        for (const S21Matrix &matrix : matrices) matrix * matrix;
+      },
+      repeats);
+  double multiply_batch = BestSeconds([&] { batch * batch; }, repeats);
+  double determinant_single = BestSeconds(
+      [&] {
+        for (const S21Matrix &matrix : matrices) matrix.Determinant();
+      },
+      repeats);
+  double determinant_batch =
+      BestSeconds([&] { batch.Determinant(); }, repeats);
+  double inverse_single = BestSeconds(
+      [&] {
+        for (const S21Matrix &matrix : matrices) matrix.InverseMatrix();
+      },
+      repeats);
+  double inverse_batch = BestSeconds([&] { batch.InverseMatrix(); }, repeats);
+  double transpose_single = BestSeconds(
+      [&] {
+        for (const S21Matrix &matrix : matrices) matrix.Transpose();
+      },
+      repeats);
+  double transpose_batch = BestSeconds([&] { batch.Transpose(); }, repeats);
+  double millions = count / 1e6;
+  std::printf("%4dx%-4d %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n", n,
+              n, millions / multiply_single, millions / multiply_batch,
+              millions / determinant_single, millions / determinant_batch,
+              millions / inverse_single, millions / inverse_batch,
+              millions / transpose_single, millions / transpose_batch);
+}
+
+}  // namespace
+
+// Миллионов матриц в секунду: по одной S21Matrix против S21MatrixBatch.
+// Использование: ./batch_bench [count] [repeats]
+int main(int argc, char **argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : 1 << 16;
+  int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+  std::printf("%9s %9s %9s %9s %9s %9s %9s %9s %9s\n", "size", "mul one",
+              "mul batch", "det one", "det batch", "inv one", "inv batch",
+              "tr one", "tr batch");
+  const int sizes[] = {3, 4, 8, 16};
+  for (int n : sizes) Measure(n, count, repeats);
+  return 0;
+}
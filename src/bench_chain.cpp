@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "s21_matrix_chain.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+template <typename Function>
+double BestSeconds(Function function, int repeats) {
+  using Clock = std::chrono::steady_clock;
+  double best = 1e30;
+  for (int run = 0; run < repeats; ++run) {
+    Clock::time_point start = Clock::now();
+    function();
+    best = std::min(
+        best, std::chrono::duration<double>(Clock::now() - start).count());
+  }
+  return best;
+}
+
+}  // namespace
+
+// Цепочки с размерами из конвейеров: узкие проекции между широкими
+// матрицами. Для каждой — оценка операций слева направо и в выбранном
+// порядке, сам порядок и время operator* против S21MatrixChain
+// (повторное умножение, буферы уже выделены).
+// Использование: ./chain_bench [repeats]
+int main(int argc, char **argv) {
+  int repeats = argc > 1 ? std::atoi(argv[1]) : 5;
+  const std::vector<std::vector<int>> chains = {
+      {1000, 5, 1000, 1},
+      {2000, 10, 2000, 10, 2000},
+      {50, 400, 400, 400, 3},
+      {300, 300, 300, 300, 300},
+      {8, 1000, 20, 1000, 30, 1000, 4}};
+  for (const std::vector<int> &dimensions : chains) {
+    std::vector<S21Matrix> factors;
+    for (std::size_t i = 0; i + 1 < dimensions.size(); ++i) {
+      factors.push_back(S21Matrix(dimensions[i], dimensions[i + 1]));
+      for (int r = 0; r < dimensions[i]; ++r)
+        for (int c = 0; c < dimensions[i + 1]; ++c)
+          factors[i](r, c) = (r * 7 + c * 3 + i) % 11 - 5;
+    }
+    S21MatrixChain chain;
+    for (const S21Matrix &factor : factors) chain.Add(factor);
+    S21Matrix product;
+    chain.Multiply(product);
+    double naive = BestSeconds(
+        [&] {
+          S21Matrix result = factors[0];
+          for (std::size_t i = 1; i < factors.size(); ++i)
+            result *= factors[i];
+        },
+        repeats);
+    double planned = BestSeconds([&] { chain.Multiply(product); }, repeats);
+    std::printf("dims");
+    for (int dimension : dimensions) std::printf(" %d", dimension);
+    std::printf("\n  order %s\n", chain.GetOrder().c_str());
+    std::printf("  Mflop %12.2f -> %10.2f   time %9.4f s -> %9.4f s\n",
+                chain.GetLeftToRightFlops() * 1e-6, chain.GetFlops() * 1e-6,
+                naive, planned);
+  }
+  return 0;
+}
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Сравнивает два JSON-отчёта Google Benchmark (make bench).
+
+Использование: bench_compare.py baseline.json current.json [threshold]
+
+Для каждого теста берётся cpu_time; при запуске с повторениями —
+медиана из агрегатов. Регрессия — если текущее время больше базового
+в 1 + threshold раз (по умолчанию 0.10). Код выхода 1, если есть
+регрессии, 2 — при ошибке в аргументах или файлах.
+"""
+
+import json
+import sys
+
+UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path):
+    with open(path) as file:
+        report = json.load(file)
+    times = {}
+    for entry in report.get("benchmarks", []):
+        if entry.get("error_occurred"):
+            continue
+        name = entry.get("run_name", entry["name"])
+        nanoseconds = entry["cpu_time"] * UNITS[entry.get("time_unit", "ns")]
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                times[name] = nanoseconds
+        elif name not in times:
+            times[name] = nanoseconds
+    return times
+
+
+def main(argv):
+    if len(argv) not in (3, 4):
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+    try:
+        baseline, current = load(argv[1]), load(argv[2])
+        threshold = float(argv[3]) if len(argv) == 4 else 0.10
+    except (OSError, ValueError, KeyError) as error:
+        print("bench_compare: %s" % error, file=sys.stderr)
+        return 2
+    regressions = 0
+    print("%-28s %12s %12s %8s" % ("benchmark", "baseline", "current",
+                                   "change"))
+    for name, time in current.items():
+        if name not in baseline:
+            print("%-28s %12s %12.0f %8s" % (name, "-", time, "new"))
+            continue
+        change = time / baseline[name] - 1.0
+        mark = ""
+        if change > threshold:
+            mark = "  REGRESSION"
+            regressions += 1
+        print("%-28s %12.0f %12.0f %+7.1f%%%s" %
+              (name, baseline[name], time, 100.0 * change, mark))
+    for name in baseline:
+        if name not in current:
+            print("%-28s %12.0f %12s %8s" % (name, baseline[name], "-",
+                                             "missing"))
+    print("%d regression(s) over %.0f%%" % (regressions, 100.0 * threshold))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
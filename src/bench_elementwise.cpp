@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "s21_cpu.h"
+#include "s21_kernels.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+template <typename Function>
+double BestSeconds(Function function, int repeats) {
+  using Clock = std::chrono::steady_clock;
+  double best = 1e30;
+  for (int run = 0; run < repeats; ++run) {
+    Clock::time_point start = Clock::now();
+    function();
+    best = std::min(
+        best, std::chrono::duration<double>(Clock::now() - start).count());
+  }
+  return best;
+}
+
+// Пиковая пропускная способность в духе STREAM: лучший из Copy, Scale, Add
+// и Triad на голых массивах того же объёма, что и матрицы. Scale, Add и
+// Triad идут через самые широкие ядра, так что пик не занижен скалярным
+// кодом самого бенчмарка.
+double StreamPeak(std::size_t count, int repeats) {
+  std::vector<double> a(count, 1.0), b(count, 2.0), c(count, 0.5);
+  const s21::ElementwiseKernels &kernels = s21::GetElementwiseKernels();
+  double copy = BestSeconds(
+      [&] { std::memcpy(c.data(), a.data(), count * sizeof(double)); },
+      repeats);
+  double scale =
+      BestSeconds([&] { kernels.scale(b.data(), 1.0000001, count); }, repeats);
+  double add =
+      BestSeconds([&] { kernels.add(c.data(), a.data(), count); }, repeats);
+  double triad = BestSeconds(
+      [&] { kernels.add_scaled(a.data(), c.data(), 1e-3, count); }, repeats);
+  double bytes = static_cast<double>(count) * sizeof(double);
+  return std::max({2 * bytes / copy, 2 * bytes / scale, 3 * bytes / add,
+                   3 * bytes / triad});
+}
+
+// Тот же допуск, что у EqMatrix(other, absolute, relative), но циклом
+// через operator(), который проверяет индексы на каждом элементе.
+bool NearByElements(const S21Matrix &a, const S21Matrix &b, double absolute,
+                    double relative) {
+  for (int i = 0; i < a.GetRows(); ++i)
+    for (int j = 0; j < a.GetCols(); ++j) {
+      double x = a(i, j), y = b(i, j);
+      double bound = relative * std::max(std::fabs(x), std::fabs(y));
+      if (x != y && !(std::fabs(x - y) <= std::max(absolute, bound)))
+        return false;
+    }
+  return true;
+}
+
+}  // namespace
+
+// Использование: ./elementwise_bench [size] [repeats]
+int main(int argc, char **argv) {
+  int size = argc > 1 ? std::atoi(argv[1]) : 4096;
+  int repeats = argc > 2 ? std::atoi(argv[2]) : 10;
+  std::size_t count = static_cast<std::size_t>(size) * size;
+  double bytes = static_cast<double>(count) * sizeof(double);
+
+  S21Matrix a(size, size), b(size, size);
+  for (int i = 0; i < size; ++i)
+    for (int j = 0; j < size; ++j) {
+      a[i][j] = i - j * 0.5;
+      b[i][j] = j + i * 0.25;
+    }
+  S21Matrix a_copy(a), a_near(a);
+  a_near.MulNumber(1 + 1e-12);
+
+  double peak = StreamPeak(count, repeats);
+  std::printf("matrix %dx%d, STREAM-like peak %.1f GB/s, best level %s\n",
+              size, size, peak * 1e-9,
+              s21::SimdLevelName(s21::GetSimdLevel()));
+  std::printf("%-8s %-16s %10s %8s\n", "level", "operation", "GB/s",
+              "% peak");
+
+  const s21::SimdLevel levels[] = {s21::SimdLevel::kScalar,
+                                   s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2,
+                                   s21::SimdLevel::kAvx512};
+  for (s21::SimdLevel level : levels) {
+    s21::SetSimdLevelLimit(level);
+    if (s21::GetSimdLevel() != level) continue;
+    struct {
+      const char *name;
+      double bytes_moved;
+      double seconds;
+    } results[] = {
+        {"SumMatrix", 3 * bytes,
+         BestSeconds([&] { a.SumMatrix(b); }, repeats)},
+        {"SubMatrix", 3 * bytes,
+         BestSeconds([&] { a.SubMatrix(b); }, repeats)},
+        {"MulNumber", 2 * bytes,
+         BestSeconds([&] { a.MulNumber(1.0000001); }, repeats)},
+        {"SumScaledMatrix", 3 * bytes,
+         BestSeconds([&] { a.SumScaledMatrix(b, 1e-3); }, repeats)},
+        {"EqMatrix", 2 * bytes,
+         BestSeconds([&] { (void)a_copy.EqMatrix(a_copy); }, repeats)},
+        {"EqMatrix near", 2 * bytes,
+         BestSeconds([&] { (void)a_copy.EqMatrix(a_near, 1e-9, 1e-9); },
+                     repeats)},
+        {"operator() near", 2 * bytes,
+         BestSeconds(
+             [&] { (void)NearByElements(a_copy, a_near, 1e-9, 1e-9); },
+             repeats)},
+        {"Hash", bytes, BestSeconds([&] { (void)a_copy.Hash(); }, repeats)},
+        {"Hash quantum", bytes,
+         BestSeconds([&] { (void)a_copy.Hash(1e-9); }, repeats)},
+    };
+    for (const auto &result : results) {
+      double bandwidth = result.bytes_moved / result.seconds;
+      std::printf("%-8s %-16s %10.1f %7.0f%%\n", s21::SimdLevelName(level),
+                  result.name, bandwidth * 1e-9, 100 * bandwidth / peak);
+    }
+  }
+  return 0;
+}
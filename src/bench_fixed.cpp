@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "s21_fixed_matrix.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+template <typename Function>
+double NanosecondsPerCall(Function function, int iterations) {
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start = Clock::now();
+  double sink = 0;
+  for (int i = 0; i < iterations; ++i) sink += function(i);
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  if (sink == 0.123456789) std::printf("%f\n", sink);
+  return 1e9 * seconds / iterations;
+}
+
+// Одинаковые операции над S21Matrix и S21FixedMatrix<N, N>; номер итерации
+// меняет матрицу, чтобы вызовы не выносились из цикла.
+template <int N>
+void Measure(int iterations) {
+  S21FixedMatrix<N, N> fixed;
+  for (int i = 0; i < N; ++i)
+    for (int j = 0; j < N; ++j)
+      fixed(i, j) = (i * 3 + j * 5) % 7 + (i == j) * 9;
+  S21Matrix dynamic = fixed;
+  double multiply_dynamic = NanosecondsPerCall(
+      [&](int i) {
+        dynamic(0, 0) = i;
+        return (dynamic * dynamic)(N - 1, N - 1);
+      },
+      iterations);
+  double multiply_fixed = NanosecondsPerCall(
+      [&](int i) {
+        fixed(0, 0) = i;
+        return (fixed * fixed)(N - 1, N - 1);
+      },
+      iterations);
+  double inverse_dynamic = NanosecondsPerCall(
+      [&](int i) {
+        dynamic(0, 0) = 20 + i % 3;
+        return dynamic.InverseMatrix()(0, 0);
+      },
+      iterations);
+  double inverse_fixed = NanosecondsPerCall(
+      [&](int i) {
+        fixed(0, 0) = 20 + i % 3;
+        return fixed.InverseMatrix()(0, 0);
+      },
+      iterations);
+  double determinant_dynamic = NanosecondsPerCall(
+      [&](int i) {
+        dynamic(0, 0) = i;
+        return dynamic.Determinant();
+      },
+      iterations);
+  double determinant_fixed = NanosecondsPerCall(
+      [&](int i) {
+        fixed(0, 0) = i;
+        return fixed.Determinant();
+      },
+      iterations);
+  std::printf("%4dx%-4d %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", N, N,
+              multiply_dynamic, multiply_fixed, inverse_dynamic, inverse_fixed,
+              determinant_dynamic, determinant_fixed);
+}
+
+}  // namespace
+
+// Время одного вызова в наносекундах.
+// Использование: ./fixed_bench [iterations]
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  std::printf("%9s %10s %10s %10s %10s %10s %10s\n", "size", "mul dyn",
+              "mul fixed", "inv dyn", "inv fixed", "det dyn", "det fixed");
+  Measure<2>(iterations);
+  Measure<3>(iterations);
+  Measure<4>(iterations);
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "s21_matrix_oop.h"
+
+namespace {
+
+void FillRandom(S21Matrix &matrix, std::mt19937 &generator) {
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  for (int i = 0; i < matrix.GetRows(); ++i)
+    for (int j = 0; j < matrix.GetCols(); ++j)
+      matrix[i][j] = distribution(generator);
+}
+
+// Прежний вариант MulMatrix: тройной цикл i-j-k с проходом B по столбцам.
+S21Matrix ReferenceMul(const S21Matrix &a, const S21Matrix &b) {
+  S21Matrix result(a.GetRows(), b.GetCols());
+  double **a_rows = a.GetMatrix(), **b_rows = b.GetMatrix();
+  double **result_rows = result.GetMatrix();
+  for (int i = 0; i < a.GetRows(); ++i) {
+    for (int j = 0; j < b.GetCols(); ++j) {
+      double sum = 0;
+      for (int k = 0; k < a.GetCols(); ++k) sum += a_rows[i][k] * b_rows[k][j];
+      result_rows[i][j] = sum;
+    }
+  }
+  return result;
+}
+
+template <typename Function>
+double SecondsPerRun(Function function, double min_seconds) {
+  using Clock = std::chrono::steady_clock;
+  int runs = 0;
+  Clock::time_point start = Clock::now();
+  double elapsed = 0;
+  do {
+    function();
+    ++runs;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < min_seconds);
+  return elapsed / runs;
+}
+
+}  // namespace
+
+// Использование: ./gemm_bench [max_size] [max_reference_size]
+int main(int argc, char **argv) {
+  int max_size = argc > 1 ? std::atoi(argv[1]) : 4096;
+  int max_reference_size = argc > 2 ? std::atoi(argv[2]) : max_size;
+  std::mt19937 generator(21);
+  std::printf("%6s %14s %14s %9s %12s\n", "n", "loop GFLOP/s", "gemm GFLOP/s",
+              "speedup", "max |diff|");
+  for (int n = 64; n <= max_size; n *= 2) {
+    S21Matrix a(n, n), b(n, n);
+    FillRandom(a, generator);
+    FillRandom(b, generator);
+    double flops = 2.0 * n * n * n;
+    S21Matrix fast;
+    double fast_time = SecondsPerRun([&] { fast = a * b; }, 0.5);
+    if (n > max_reference_size) {
+      std::printf("%6d %14s %14.2f %9s %12s\n", n, "-",
+                  flops / fast_time * 1e-9, "-", "-");
+      continue;
+    }
+    S21Matrix reference;
+    double reference_time =
+        SecondsPerRun([&] { reference = ReferenceMul(a, b); }, 0.5);
+    double max_diff = 0;
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j)
+        max_diff = std::fmax(max_diff, std::fabs(fast(i, j) - reference(i, j)));
+    std::printf("%6d %14.2f %14.2f %8.1fx %12.3g\n", n,
+                flops / reference_time * 1e-9, flops / fast_time * 1e-9,
+                reference_time / fast_time, max_diff);
+  }
+  return 0;
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "s21_matrix_io.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+template <typename Function>
+double BestSeconds(Function function, int repeats) {
+  using Clock = std::chrono::steady_clock;
+  double best = 1e30;
+  for (int run = 0; run < repeats; ++run) {
+    Clock::time_point start = Clock::now();
+    function();
+    best = std::min(
+        best, std::chrono::duration<double>(Clock::now() - start).count());
+  }
+  return best;
+}
+
+// Прежний путь: текст, по числу на элемент.
+void WriteText(const std::string &path, const S21Matrix &matrix) {
+  std::ofstream file(path);
+  file.precision(17);
+  file << matrix.GetRows() << ' ' << matrix.GetCols() << '\n';
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    for (int j = 0; j < matrix.GetCols(); ++j) file << matrix(i, j) << ' ';
+    file << '\n';
+  }
+}
+
+S21Matrix ReadText(const std::string &path) {
+  std::ifstream file(path);
+  int rows = 0, cols = 0;
+  file >> rows >> cols;
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j) file >> matrix[i][j];
+  return matrix;
+}
+
+}  // namespace
+
+// Время в миллисекундах: запись и чтение текстом, двоичная запись и
+// чтение, отображение файла (без обращения к данным) и отображение с
+// проходом по всем строкам.
+// Использование: ./io_bench [max_size] [repeats]
+int main(int argc, char **argv) {
+  int max_size = argc > 1 ? std::atoi(argv[1]) : 2048;
+  int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+  const std::string text = "io_bench.txt", binary = "io_bench.s21m";
+  std::printf("%6s %10s %10s %10s %10s %10s %10s\n", "size", "text wr",
+              "text rd", "bin wr", "bin rd", "map", "map+scan");
+  for (int size = 256; size <= max_size; size *= 2) {
+    S21Matrix matrix(size, size);
+    for (int i = 0; i < size; ++i)
+      for (int j = 0; j < size; ++j) matrix[i][j] = (i - j) / 7.0;
+    double text_write = BestSeconds([&] { WriteText(text, matrix); }, 1);
+    double text_read = BestSeconds([&] { ReadText(text); }, 1);
+    double write =
+        BestSeconds([&] { s21::WriteMatrix(binary, matrix); }, repeats);
+    double read =
+        BestSeconds([&] { s21::ReadMatrix<double>(binary); }, repeats);
+    double map = BestSeconds(
+        [&] { S21Matrix mapped(binary, s21::MapMode::kReadOnly); }, repeats);
+    double sink = 0;
+    double scan = BestSeconds(
+        [&] {
+          S21Matrix mapped(binary, s21::MapMode::kReadOnly);
+          for (int i = 0; i < size; ++i) sink += mapped[i][i];
+        },
+        repeats);
+    if (sink == 0.123456789) std::printf("%f\n", sink);
+    std::printf("%6d %10.2f %10.2f %10.2f %10.2f %10.3f %10.3f\n", size,
+                1e3 * text_write, 1e3 * text_read, 1e3 * write, 1e3 * read,
+                1e3 * map, 1e3 * scan);
+  }
+  std::remove(text.c_str());
+  std::remove(binary.c_str());
+  return 0;
+}
@@ -0,0 +1,86 @@
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "s21_matrix_io.h"
+#include "s21_matrix_oop.h"
+#include "s21_out_of_core.h"
+
+namespace {
+
+// Пиковый размер резидентной памяти процесса, МБ.
+double PeakRssMegabytes() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / 1024.0;
+}
+
+// Файл заполняется по строкам, не собирая матрицу в памяти.
+void WriteSample(const std::string &path, int size, double shift) {
+  s21::FileHeader header = s21::CreateMatrixFile<double>(path, size, size);
+  std::FILE *file = std::fopen(path.c_str(), "r+b");
+  std::vector<double> row(header.stride);
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) row[j] = (i * 7 + j * 3) % 11 - shift;
+    std::fseek(file, header.payload_offset + i * row.size() * sizeof(double),
+               SEEK_SET);
+    std::fwrite(row.data(), sizeof(double), row.size(), file);
+  }
+  std::fclose(file);
+}
+
+template <typename Function>
+double Seconds(Function function) {
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point start = Clock::now();
+  function();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void Report(const char *name, double seconds, const s21::OutOfCoreStats &stats,
+            double flops) {
+  std::printf("%-6s %9.3f %9.1f %9.2f %9.3f %9.2f %9.1f\n", name, seconds,
+              stats.buffer_bytes / 1048576.0,
+              stats.bytes_read / seconds / 1e9, stats.wait_seconds,
+              flops / seconds / 1e9, PeakRssMegabytes());
+}
+
+}  // namespace
+
+// Сложение и умножение матриц size x size из файлов с бюджетом памяти
+// budget МБ: время в секундах, память буферов, скорость чтения (ГБ/с),
+// ожидание диска, GFLOP/s и пиковый RSS процесса (МБ). В конце те же
+// операции в памяти для сравнения времени и RSS.
+// Использование: ./out_of_core_bench [size] [budget]
+int main(int argc, char **argv) {
+  int size = argc > 1 ? std::atoi(argv[1]) : 2048;
+  std::size_t budget = (argc > 2 ? std::atoi(argv[2]) : 8) << 20;
+  const std::string a = "ooc_bench_a.s21m", b = "ooc_bench_b.s21m",
+                    c = "ooc_bench_c.s21m";
+  WriteSample(a, size, 5.0);
+  WriteSample(b, size, 3.0);
+  std::printf("%-6s %9s %9s %9s %9s %9s %9s\n", "op", "seconds", "buffers",
+              "read", "wait", "gflops", "peak rss");
+  s21::OutOfCoreStats stats;
+  double seconds = Seconds(
+      [&] { stats = s21::SumMatrixFiles<double>(a, b, c, budget); });
+  Report("sum", seconds, stats, double(size) * size);
+  seconds = Seconds(
+      [&] { stats = s21::MulMatrixFiles<double>(a, b, c, budget); });
+  Report("mul", seconds, stats, 2.0 * size * size * size);
+  S21Matrix left = s21::ReadMatrix<double>(a);
+  S21Matrix right = s21::ReadMatrix<double>(b);
+  seconds = Seconds([&] { S21Matrix(left + right); });
+  std::printf("%-6s %9.3f %49.1f\n", "sum", seconds, PeakRssMegabytes());
+  seconds = Seconds([&] { left * right; });
+  std::printf("%-6s %9.3f %39.2f %9.1f\n", "mul", seconds,
+              2.0 * size * size * size / seconds / 1e9, PeakRssMegabytes());
+  std::remove(a.c_str());
+  std::remove(b.c_str());
+  std::remove(c.c_str());
+  return 0;
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "s21_matrix_oop.h"
+#include "s21_parallel.h"
+
+namespace {
+
+template <typename Function>
+double BestSeconds(Function function, int repeats) {
+  using Clock = std::chrono::steady_clock;
+  double best = 1e30;
+  for (int run = 0; run < repeats; ++run) {
+    Clock::time_point start = Clock::now();
+    function();
+    best = std::min(
+        best, std::chrono::duration<double>(Clock::now() - start).count());
+  }
+  return best;
+}
+
+S21Matrix MakeMatrix(int size) {
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i)
+    for (int j = 0; j < size; ++j)
+      matrix[i][j] = (i * 7 + j * 13) % 17 * 0.125 + (i == j ? size : 0);
+  return matrix;
+}
+
+}  // namespace
+
+// Сильное масштабирование: размер задачи фиксирован, число потоков растёт.
+// Использование: ./scaling_bench [size] [max_threads] [repeats]
+int main(int argc, char **argv) {
+  int size = argc > 1 ? std::atoi(argv[1]) : 1024;
+  int max_threads = argc > 2 ? std::atoi(argv[2]) : s21::GetThreadCount();
+  int repeats = argc > 3 ? std::atoi(argv[3]) : 3;
+  S21Matrix a = MakeMatrix(size), b = MakeMatrix(size);
+
+  struct {
+    const char *name;
+    double (*run)(const S21Matrix &, const S21Matrix &, int);
+  } operations[] = {
+      {"MulMatrix",
+       [](const S21Matrix &a, const S21Matrix &b, int repeats) {
+         return BestSeconds([&] { S21Matrix c = a * b; }, repeats);
+       }},
+      {"Transpose",
+       [](const S21Matrix &a, const S21Matrix &, int repeats) {
+         return BestSeconds([&] { S21Matrix t = a.Transpose(); }, repeats);
+       }},
+      {"SumMatrix",
+       [](const S21Matrix &a, const S21Matrix &b, int repeats) {
+         S21Matrix c(a);
+         return BestSeconds([&] { c.SumMatrix(b); }, repeats);
+       }},
+      {"a + b * 2.0",
+       [](const S21Matrix &a, const S21Matrix &b, int repeats) {
+         S21Matrix c(a);
+         return BestSeconds([&] { c = a + b * 2.0; }, repeats);
+       }},
+      {"Determinant",
+       [](const S21Matrix &a, const S21Matrix &, int repeats) {
+         return BestSeconds([&] { (void)a.Determinant(); }, repeats);
+       }},
+      {"InverseMatrix",
+       [](const S21Matrix &a, const S21Matrix &, int repeats) {
+         return BestSeconds([&] { S21Matrix i = a.InverseMatrix(); }, repeats);
+       }},
+      {"CalcComplements",
+       [](const S21Matrix &a, const S21Matrix &, int repeats) {
+         return BestSeconds([&] { S21Matrix c = a.CalcComplements(); },
+                            repeats);
+       }},
+  };
+
+  std::printf("matrix %dx%d, threads 1..%d\n", size, size, max_threads);
+  std::printf("%-16s %8s %12s %8s %11s\n", "operation", "threads", "seconds",
+              "speedup", "efficiency");
+  for (const auto &operation : operations) {
+    double serial = 0;
+    // 1, 2, 4, ... и max_threads
+    for (int threads = 1;; threads = std::min(threads * 2, max_threads)) {
+      s21::ThreadCountScope scope(threads);
+      double seconds = operation.run(a, b, repeats);
+      if (threads == 1) serial = seconds;
+      double speedup = serial / seconds;
+      std::printf("%-16s %8d %12.6f %8.2f %10.0f%%\n", operation.name,
+                  threads, seconds, speedup, 100 * speedup / threads);
+      if (threads >= max_threads) break;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_sparse_matrix.h"
+
+namespace {
+
+template <typename Function>
+double BestSeconds(Function function, int repeats) {
+  using Clock = std::chrono::steady_clock;
+  double best = 1e30;
+  for (int run = 0; run < repeats; ++run) {
+    Clock::time_point start = Clock::now();
+    function();
+    best = std::min(
+        best, std::chrono::duration<double>(Clock::now() - start).count());
+  }
+  return best;
+}
+
+// Равномерно случайные позиции с заданной долей ненулевых.
+S21Matrix Uniform(int size, double density, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i)
+    for (int j = 0; j < size; ++j)
+      if (unit(generator) < density) matrix[i][j] = unit(generator) + 0.5;
+  return matrix;
+}
+
+// Лента шириной 2 * half + 1 вокруг диагонали.
+S21Matrix Banded(int size, int half) {
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i)
+    for (int j = std::max(0, i - half); j <= std::min(size - 1, i + half); ++j)
+      matrix[i][j] = 1.0 + (i + j) % 5;
+  return matrix;
+}
+
+// Плотные диагональные блоки block x block.
+S21Matrix BlockDiagonal(int size, int block) {
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i)
+    for (int j = i / block * block;
+         j < std::min(size, (i / block + 1) * block); ++j)
+      matrix[i][j] = 1.0 + (i * 3 + j) % 7;
+  return matrix;
+}
+
+void Measure(const char *name, const S21Matrix &dense, int repeats) {
+  const int size = dense.GetRows();
+  S21SparseMatrix sparse(dense);
+  S21Matrix other = Uniform(size, 1.0, 7);
+  std::vector<double> vector(size, 1.0);
+  S21Matrix column(size, 1);
+  for (int i = 0; i < size; ++i) column[i][0] = 1.0;
+  double spmm_dense = BestSeconds([&] { dense * other; }, repeats);
+  double spmm_sparse = BestSeconds([&] { sparse * other; }, repeats);
+  double spmv_dense = BestSeconds([&] { dense * column; }, repeats);
+  double spmv_sparse =
+      BestSeconds([&] { sparse.Multiply(vector); }, repeats);
+  double spgemm = BestSeconds([&] { sparse * sparse; }, repeats);
+  double sum_dense = BestSeconds([&] { S21Matrix(dense + dense); }, repeats);
+  double sum_sparse = BestSeconds([&] { sparse + sparse; }, repeats);
+  double density = 100.0 * sparse.GetNonZeros() / size / size;
+  std::printf("%-8s %5d %6.2f%% %9.2f %9.2f %9.3f %9.3f %9.2f %9.3f %9.3f\n",
+              name, size, density, 1e3 * spmm_dense, 1e3 * spmm_sparse,
+              1e3 * spmv_dense, 1e3 * spmv_sparse, 1e3 * spgemm,
+              1e3 * sum_dense, 1e3 * sum_sparse);
+}
+
+}  // namespace
+
+// Время в миллисекундах: dense * dense против sparse * dense, умножение
+// на вектор, sparse * sparse и сложение плотных против разреженных.
+// Использование: ./sparse_bench [size] [repeats]
+int main(int argc, char **argv) {
+  int size = argc > 1 ? std::atoi(argv[1]) : 1024;
+  int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+  std::printf("%-8s %5s %7s %9s %9s %9s %9s %9s %9s %9s\n", "pattern",
+              "size", "density", "gemm", "spmm", "gemv", "spmv", "spgemm",
+              "sum", "spsum");
+  Measure("uniform", Uniform(size, 0.01, 1), repeats);
+  Measure("uniform", Uniform(size, 0.05, 2), repeats);
+  Measure("banded", Banded(size, 4), repeats);
+  Measure("blocks", BlockDiagonal(size, 16), repeats);
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "s21_matrix_oop.h"
+#include "s21_strassen.h"
+
+namespace {
+
+template <typename Function>
+double BestSeconds(Function function, int repeats) {
+  using Clock = std::chrono::steady_clock;
+  double best = 1e30;
+  for (int run = 0; run < repeats; ++run) {
+    Clock::time_point start = Clock::now();
+    function();
+    best = std::min(
+        best, std::chrono::duration<double>(Clock::now() - start).count());
+  }
+  return best;
+}
+
+template <typename T>
+S21BasicMatrix<T> Sample(int size, int seed) {
+  S21BasicMatrix<T> matrix(size, size);
+  for (int i = 0; i < size; ++i)
+    for (int j = 0; j < size; ++j)
+      matrix(i, j) = std::sin(i * 0.7 + j * 1.3 + seed);
+  return matrix;
+}
+
+// Максимум |C_strassen - C_classical| относительно max|C_classical|.
+template <typename T>
+double RelativeError(int size, int crossover) {
+  S21BasicMatrix<T> a = Sample<T>(size, 0), b = Sample<T>(size, 1);
+  S21BasicMatrix<T> classical = a * b;
+  S21BasicMatrix<T> fast = s21::StrassenMultiply(a, b, crossover);
+  double error = 0, scale = 0;
+  for (int i = 0; i < size; ++i)
+    for (int j = 0; j < size; ++j) {
+      error = std::max(error, static_cast<double>(
+                                  std::fabs(fast(i, j) - classical(i, j))));
+      scale = std::max(scale, static_cast<double>(std::fabs(classical(i, j))));
+    }
+  return error / scale;
+}
+
+}  // namespace
+
+// Время double-произведения классическим Gemm и по Штрассену с порогом
+// по умолчанию, рабочая память и относительная погрешность для double и
+// float; затем время при разных порогах на одном размере.
+// Использование: ./strassen_bench [max_size] [repeats]
+int main(int argc, char **argv) {
+  int max_size = argc > 1 ? std::atoi(argv[1]) : 4096;
+  int repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+  std::printf("%8s %12s %12s %8s %10s %12s %12s\n", "size", "gemm s",
+              "strassen s", "speedup", "work MB", "double err", "float err");
+  const int sizes[] = {512, 1024, 1536, 2048, 3001, 4096, 6144, 8192};
+  for (int size : sizes) {
+    if (size > max_size) break;
+    S21Matrix a = Sample<double>(size, 0), b = Sample<double>(size, 1);
+    double gemm = BestSeconds([&] { S21Matrix product = a * b; }, repeats);
+    double strassen = BestSeconds(
+        [&] { s21::StrassenMultiply(a, b, s21::kStrassenCrossover); },
+        repeats);
+    double work = s21::StrassenWorkspace(size, size, size,
+                                         s21::kStrassenCrossover) *
+                  sizeof(double) / 1048576.0;
+    std::printf("%8d %12.3f %12.3f %8.2f %10.1f %12.2e %12.2e\n", size, gemm,
+                strassen, gemm / strassen, work,
+                RelativeError<double>(size, s21::kStrassenCrossover),
+                RelativeError<float>(size, s21::kStrassenCrossover));
+  }
+
+  const int size = std::min(max_size, 4096);
+  S21Matrix a = Sample<double>(size, 0), b = Sample<double>(size, 1);
+  std::printf("\n%8s %12s %12s  (size %d)\n", "crossover", "strassen s",
+              "double err", size);
+  for (int crossover = 128; crossover <= size; crossover *= 2) {
+    double seconds =
+        BestSeconds([&] { s21::StrassenMultiply(a, b, crossover); }, repeats);
+    std::printf("%8d %12.3f %12.2e\n", crossover, seconds,
+                RelativeError<double>(size, crossover));
+  }
+  return 0;
+}
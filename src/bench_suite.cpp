@@ -0,0 +1,205 @@
+#include <benchmark/benchmark.h>
+
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+namespace {
+
+// Диагональное преобладание: матрица невырождена при любом размере.
+S21Matrix Sample(int size, int seed) {
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i)
+    for (int j = 0; j < size; ++j)
+      matrix[i][j] = i == j ? 2.0 * size : (i * 7 + j * 3 + seed) % 11 - 5;
+  return matrix;
+}
+
+// Объём данных, которые операция читает и пишет за итерацию.
+void SetBytes(benchmark::State &state, int size, int matrices) {
+  state.SetBytesProcessed(state.iterations() * matrices * size * size *
+                          static_cast<int64_t>(sizeof(double)));
+}
+
+void SetFlops(benchmark::State &state, double flops) {
+  state.counters["flops"] = benchmark::Counter(
+      flops, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void Construct(benchmark::State &state) {
+  const int size = state.range(0);
+  for (auto _ : state) {
+    S21Matrix matrix(size, size);
+    benchmark::DoNotOptimize(matrix.GetData());
+  }
+  SetBytes(state, size, 1);
+}
+
+void Copy(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix source = Sample(size, 0);
+  for (auto _ : state) {
+    S21Matrix copy(source);
+    benchmark::DoNotOptimize(copy.GetData());
+  }
+  SetBytes(state, size, 2);
+}
+
+void Move(benchmark::State &state) {
+  S21Matrix source = Sample(state.range(0), 0);
+  for (auto _ : state) {
+    S21Matrix moved(std::move(source));
+    source = std::move(moved);
+    benchmark::DoNotOptimize(source.GetData());
+  }
+}
+
+// Строка добавляется и убирается, чтобы размер не рос от итерации.
+void SetRows(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix matrix = Sample(size, 0);
+  for (auto _ : state) {
+    matrix.SetRows(size + 1);
+    matrix.SetRows(size);
+    benchmark::DoNotOptimize(matrix.GetData());
+  }
+}
+
+void SetCols(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix matrix = Sample(size, 0);
+  for (auto _ : state) {
+    matrix.SetCols(size + 1);
+    matrix.SetCols(size);
+    benchmark::DoNotOptimize(matrix.GetData());
+  }
+}
+
+// Потоковое наполнение: size строк по одной в матрицу из одной строки.
+void AppendRow(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix source = Sample(size, 0);
+  for (auto _ : state) {
+    S21Matrix matrix(1, size);
+    for (int i = 1; i < size; ++i) matrix.AppendRow(source[i]);
+    benchmark::DoNotOptimize(matrix.GetData());
+  }
+  SetBytes(state, size, 1);
+}
+
+void EqMatrix(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix a = Sample(size, 0), b = Sample(size, 0);
+  for (auto _ : state) benchmark::DoNotOptimize(a.EqMatrix(b));
+  SetBytes(state, size, 2);
+}
+
+void SumMatrix(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix a = Sample(size, 0), b = Sample(size, 1);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  SetBytes(state, size, 3);
+}
+
+void SubMatrix(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix a = Sample(size, 0), b = Sample(size, 1);
+  for (auto _ : state) {
+    a.SubMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  SetBytes(state, size, 3);
+}
+
+void MulNumber(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix a = Sample(size, 0);
+  for (auto _ : state) {
+    a.MulNumber(1.0000001);
+    benchmark::ClobberMemory();
+  }
+  SetBytes(state, size, 2);
+}
+
+void MulMatrix(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix a = Sample(size, 0), b = Sample(size, 1);
+  for (auto _ : state) {
+    S21Matrix product = a * b;
+    benchmark::DoNotOptimize(product.GetData());
+  }
+  SetFlops(state, 2.0 * size * size * size);
+}
+
+// Произведение в заранее выделенную матрицу, без выделений на итерации.
+void MultiplyInto(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix a = Sample(size, 0), b = Sample(size, 1), product(size, size);
+  for (auto _ : state) {
+    s21::Multiply(a, b, product);
+    benchmark::DoNotOptimize(product.GetData());
+  }
+  SetFlops(state, 2.0 * size * size * size);
+}
+
+void Transpose(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix a = Sample(size, 0);
+  for (auto _ : state) {
+    S21Matrix transposed = a.Transpose();
+    benchmark::DoNotOptimize(transposed.GetData());
+  }
+  SetBytes(state, size, 2);
+}
+
+void Determinant(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix a = Sample(size, 0);
+  for (auto _ : state) benchmark::DoNotOptimize(a.Determinant());
+  SetFlops(state, 2.0 / 3.0 * size * size * size);
+}
+
+void CalcComplements(benchmark::State &state) {
+  S21Matrix a = Sample(state.range(0), 0);
+  for (auto _ : state) {
+    S21Matrix complements = a.CalcComplements();
+    benchmark::DoNotOptimize(complements.GetData());
+  }
+}
+
+void InverseMatrix(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix a = Sample(size, 0);
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.GetData());
+  }
+  SetFlops(state, 2.0 * size * size * size);
+}
+
+}  // namespace
+
+// Размеры от малых, где видны накладные расходы вызова, до тех, что не
+// помещаются в кэш второго уровня. Кубические операции ограничены, чтобы
+// весь набор проходил за пару минут.
+BENCHMARK(Construct)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(Copy)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(Move)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(SetRows)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(SetCols)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(AppendRow)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(EqMatrix)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(SumMatrix)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(SubMatrix)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(MulNumber)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(MulMatrix)->RangeMultiplier(4)->Range(4, 512);
+BENCHMARK(MultiplyInto)->RangeMultiplier(4)->Range(4, 512);
+BENCHMARK(Transpose)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK(Determinant)->RangeMultiplier(4)->Range(4, 512);
+BENCHMARK(CalcComplements)->RangeMultiplier(2)->Range(4, 64);
+BENCHMARK(InverseMatrix)->RangeMultiplier(4)->Range(4, 256);
+
+BENCHMARK_MAIN();
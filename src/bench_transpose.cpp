@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "s21_matrix_oop.h"
+
+namespace {
+
+template <typename Function>
+double BestSeconds(Function function, int repeats) {
+  using Clock = std::chrono::steady_clock;
+  double best = 1e30;
+  for (int run = 0; run < repeats; ++run) {
+    Clock::time_point start = Clock::now();
+    function();
+    best = std::min(
+        best, std::chrono::duration<double>(Clock::now() - start).count());
+  }
+  return best;
+}
+
+// Прежняя реализация: запись с шагом в строку результата.
+S21Matrix LoopTranspose(const S21Matrix &matrix) {
+  S21Matrix result(matrix.GetCols(), matrix.GetRows());
+  for (int i = 0; i < matrix.GetRows(); ++i)
+    for (int j = 0; j < matrix.GetCols(); ++j) result[j][i] = matrix[i][j];
+  return result;
+}
+
+}  // namespace
+
+// Пропускная способность считается по чтению и записи всей матрицы.
+// Использование: ./transpose_bench [max_size] [repeats]
+int main(int argc, char **argv) {
+  int max_size = argc > 1 ? std::atoi(argv[1]) : 4096;
+  int repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+  std::printf("%12s %12s %12s %12s %12s\n", "size", "loop GB/s",
+              "tiled GB/s", "square GB/s", "rect GB/s");
+  for (int size = 256; size <= max_size; size *= 2) {
+    S21Matrix square(size, size), rectangular(size, size / 2 + 3);
+    for (int i = 0; i < size; ++i)
+      for (int j = 0; j < size; ++j) square[i][j] = i - j;
+    double bytes = 2.0 * size * size * sizeof(double);
+    double rect_bytes = 2.0 * size * (size / 2 + 3) * sizeof(double);
+    double loop = BestSeconds([&] { LoopTranspose(square); }, repeats);
+    double tiled = BestSeconds([&] { square.Transpose(); }, repeats);
+    double in_place = BestSeconds([&] { square.TransposeInPlace(); }, repeats);
+    double cycles =
+        BestSeconds([&] { rectangular.TransposeInPlace(); }, repeats);
+    std::printf("%12d %12.2f %12.2f %12.2f %12.2f\n", size,
+                bytes / loop * 1e-9, bytes / tiled * 1e-9,
+                bytes / in_place * 1e-9, rect_bytes / cycles * 1e-9);
+  }
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "s21_maintained_inverse.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Seconds(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+S21Matrix Sample(int size) {
+  S21Matrix matrix(size, size);
+  for (int i = 0; i < size; ++i)
+    for (int j = 0; j < size; ++j)
+      matrix(i, j) = i == j ? size : std::sin(i * 1.7 + j * 0.9);
+  return matrix;
+}
+
+// Новая строка события: диагональный элемент остаётся преобладающим.
+void EventRow(int size, int event, std::vector<double> &row) {
+  for (int j = 0; j < size; ++j)
+    row[j] = std::cos(event * 0.37 + j * 1.1) + (j == event % size ? size : 0);
+}
+
+}  // namespace
+
+// Поток событий «заменить строку и узнать определитель и обратную»:
+// пересчёт с нуля (Determinant и InverseMatrix) против
+// S21MaintainedInverse. В конце — отличие поддерживаемой обратной от
+// посчитанной заново и число разложений.
+// Использование: ./update_bench [max_size] [events]
+int main(int argc, char **argv) {
+  int max_size = argc > 1 ? std::atoi(argv[1]) : 1000;
+  int events = argc > 2 ? std::atoi(argv[2]) : 20;
+  std::printf("%8s %14s %14s %10s %12s %10s\n", "size", "scratch ms/ev",
+              "update ms/ev", "speedup", "inverse err", "refactors");
+  for (int size = 125; size <= max_size; size *= 2) {
+    std::vector<double> row(size);
+    S21Matrix matrix = Sample(size);
+    Clock::time_point start = Clock::now();
+    for (int event = 0; event < events; ++event) {
+      EventRow(size, event, row);
+      std::copy(row.begin(), row.end(), matrix[event % size]);
+      matrix.Determinant();
+      matrix.InverseMatrix();
+    }
+    double scratch = Seconds(start) / events;
+
+    S21MaintainedInverse maintained(Sample(size));
+    start = Clock::now();
+    for (int event = 0; event < events; ++event) {
+      EventRow(size, event, row);
+      maintained.UpdateRow(event % size, row.data());
+      maintained.Determinant();
+      maintained.GetInverse();
+    }
+    double update = Seconds(start) / events;
+
+    S21Matrix inverse = matrix.InverseMatrix();
+    double error = 0;
+    for (int i = 0; i < size; ++i)
+      for (int j = 0; j < size; ++j)
+        error = std::max(
+            error, std::fabs(maintained.GetInverse()(i, j) - inverse(i, j)));
+    std::printf("%8d %14.3f %14.3f %10.1f %12.2e %10d\n", size,
+                scratch * 1e3, update * 1e3, scratch / update, error,
+                maintained.GetRefactorCount());
+  }
+  return 0;
+}
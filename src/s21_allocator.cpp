@@ -0,0 +1,336 @@
+#include "s21_allocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <utility>
+
+#include "s21_profile.h"
+
+namespace s21 {
+namespace {
+
+// Выравнивание блоков пула и шаг его классов размеров.
+constexpr std::size_t kAlignment = kBufferAlignment;
+// Классы: 64, 128, 192, 256 байт, затем по четыре на степень двойки до
+// 2^kMaxPooledPower. Более крупные буферы пул не удерживает.
+constexpr int kSmallClasses = 4;
+constexpr int kFirstPower = 8;
+constexpr int kMaxPooledPower = 28;
+constexpr int kClassCount =
+    kSmallClasses + (kMaxPooledPower - kFirstPower) * 4;
+constexpr std::size_t kMaxPooledBytes = std::size_t(1) << kMaxPooledPower;
+
+struct Counters {
+  std::atomic<std::size_t> allocations{0};
+  std::atomic<std::size_t> deallocations{0};
+  std::atomic<std::size_t> bytes_allocated{0};
+  std::atomic<std::size_t> bytes_in_use{0};
+  std::atomic<std::size_t> peak_bytes_in_use{0};
+  std::atomic<std::size_t> system_allocations{0};
+  std::atomic<std::size_t> system_bytes{0};
+};
+
+Counters counters;
+
+std::atomic<MatrixAllocator *> global_allocator{nullptr};
+thread_local MatrixAllocator *scope_allocator = nullptr;
+
+void *SystemAllocate(std::size_t bytes) {
+  void *buffer = ::operator new(bytes, std::align_val_t(kAlignment));
+  counters.system_allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.system_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  return buffer;
+}
+
+void SystemFree(void *buffer) noexcept {
+  ::operator delete(buffer, std::align_val_t(kAlignment));
+}
+
+std::size_t RoundUp(std::size_t bytes) {
+  return (std::max<std::size_t>(bytes, 1) + kAlignment - 1) / kAlignment *
+         kAlignment;
+}
+
+int HighestBit(std::size_t value) {
+  return static_cast<int>(sizeof(unsigned long long) * 8 - 1) -
+         __builtin_clzll(value);
+}
+
+// Класс размера для bytes <= kMaxPooledBytes и его объём в байтах.
+std::pair<int, std::size_t> SizeClass(std::size_t bytes) {
+  bytes = RoundUp(bytes);
+  if (bytes <= kSmallClasses * kAlignment)
+    return {static_cast<int>(bytes / kAlignment) - 1, bytes};
+  int power = HighestBit(bytes - 1);  //2^power < bytes <= 2^(power + 1)
+  std::size_t base = std::size_t(1) << power, step = base / 4;
+  std::size_t sub = (bytes - base + step - 1) / step;  //от 1 до 4
+  int index = kSmallClasses + (power - kFirstPower) * 4 + static_cast<int>(sub);
+  return {index - 1, base + sub * step};
+}
+
+struct BufferHeader {
+  MatrixAllocator *allocator;
+  std::size_t bytes;
+  bool adopted;  //из AdoptMatrixBuffer
+};
+static_assert(sizeof(BufferHeader) <= kBufferHeader &&
+                  kBufferHeader % kBufferAlignment == 0,
+              "Header must fit a line and keep the data aligned");
+
+void UpdatePeak(std::size_t in_use) {
+  std::atomic<std::size_t> &peak_counter = counters.peak_bytes_in_use;
+  std::size_t peak = peak_counter.load(std::memory_order_relaxed);
+  while (peak < in_use &&
+         !peak_counter.compare_exchange_weak(peak, in_use,
+                                             std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+// Арена живёт в куче: её куски нужны, пока жива хоть одна матрица из неё,
+// даже если ArenaScope уже закрыт.
+class Arena : public MatrixAllocator {
+ public:
+  explicit Arena(std::size_t chunk_bytes)
+      : chunk_bytes_(RoundUp(chunk_bytes)),
+        current_(0),
+        offset_(0),
+        live_(0),
+        closed_(false) {}
+
+  ~Arena() override {
+    for (const Chunk &chunk : chunks_) SystemFree(chunk.data);
+  }
+
+  void *Allocate(std::size_t bytes) override {
+    bytes = RoundUp(bytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (current_ < chunks_.size() &&
+           chunks_[current_].bytes - offset_ < bytes) {
+      ++current_;
+      offset_ = 0;
+    }
+    if (current_ == chunks_.size()) {
+      std::size_t chunk_bytes = std::max(chunk_bytes_, bytes);
+      chunks_.reserve(chunks_.size() + 1);
+      chunks_.push_back({static_cast<char *>(SystemAllocate(chunk_bytes)),
+                         chunk_bytes});
+      offset_ = 0;
+    }
+    void *buffer = chunks_[current_].data + offset_;
+    offset_ += bytes;
+    ++live_;
+    return buffer;
+  }
+
+  void Deallocate(void *, std::size_t) noexcept override {
+    bool release = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--live_ == 0) {
+        release = closed_;
+        current_ = 0;
+        offset_ = 0;
+      }
+    }
+    if (release) delete this;
+  }
+
+  // Область закрыта: куски освобождаются сейчас или вместе с последней
+  // матрицей, которая пережила область.
+  void Close() noexcept {
+    bool release = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+      release = live_ == 0;
+    }
+    if (release) delete this;
+  }
+
+  std::size_t GetReservedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t bytes = 0;
+    for (const Chunk &chunk : chunks_) bytes += chunk.bytes;
+    return bytes;
+  }
+
+ private:
+  struct Chunk {
+    char *data;
+    std::size_t bytes;
+  };
+
+  std::vector<Chunk> chunks_;
+  std::size_t chunk_bytes_;
+  std::size_t current_;  //кусок, из которого идёт выделение
+  std::size_t offset_;   //занятая часть текущего куска
+  std::size_t live_;     //живые буферы из арены
+  bool closed_;
+  mutable std::mutex mutex_;
+};
+
+void *SystemAllocator::Allocate(std::size_t bytes) {
+  return SystemAllocate(bytes);
+}
+
+void SystemAllocator::Deallocate(void *buffer, std::size_t) noexcept {
+  SystemFree(buffer);
+}
+
+PoolAllocator::PoolAllocator(std::size_t max_cached_bytes)
+    : free_lists_(kClassCount),
+      cached_bytes_(0),
+      max_cached_bytes_(max_cached_bytes) {}
+
+PoolAllocator::~PoolAllocator() { Trim(); }
+
+void *PoolAllocator::Allocate(std::size_t bytes) {
+  if (bytes > kMaxPooledBytes) return SystemAllocate(bytes);
+  std::pair<int, std::size_t> size_class = SizeClass(bytes);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<void *> &free_list = free_lists_[size_class.first];
+    if (!free_list.empty()) {
+      void *buffer = free_list.back();
+      free_list.pop_back();
+      cached_bytes_ -= size_class.second;
+      return buffer;
+    }
+  }
+  return SystemAllocate(size_class.second);
+}
+
+void PoolAllocator::Deallocate(void *buffer, std::size_t bytes) noexcept {
+  if (bytes <= kMaxPooledBytes) {
+    std::pair<int, std::size_t> size_class = SizeClass(bytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cached_bytes_ + size_class.second <= max_cached_bytes_) {
+      try {
+        free_lists_[size_class.first].push_back(buffer);
+        cached_bytes_ += size_class.second;
+        return;
+      } catch (const std::bad_alloc &) {
+        //список не вырос — буфер уходит системе
+      }
+    }
+  }
+  SystemFree(buffer);
+}
+
+std::size_t PoolAllocator::GetCachedBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cached_bytes_;
+}
+
+void PoolAllocator::Trim() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (std::vector<void *> &free_list : free_lists_) {
+    for (void *buffer : free_list) SystemFree(buffer);
+    free_list.clear();
+  }
+  cached_bytes_ = 0;
+}
+
+PoolAllocator &GetPoolAllocator() {
+  static PoolAllocator *pool = new PoolAllocator();
+  return *pool;
+}
+
+MatrixAllocator &GetAllocator() {
+  if (scope_allocator != nullptr) return *scope_allocator;
+  MatrixAllocator *allocator = global_allocator.load();
+  if (allocator != nullptr) return *allocator;
+  static SystemAllocator *system = new SystemAllocator();
+  return *system;
+}
+
+void SetAllocator(MatrixAllocator *allocator) {
+  global_allocator.store(allocator);
+}
+
+AllocatorScope::AllocatorScope(MatrixAllocator &allocator)
+    : previous_(scope_allocator) {
+  scope_allocator = &allocator;
+}
+
+AllocatorScope::~AllocatorScope() { scope_allocator = previous_; }
+
+ArenaScope::ArenaScope(std::size_t chunk_bytes)
+    : arena_(new Arena(chunk_bytes)), previous_(scope_allocator) {
+  scope_allocator = arena_;
+}
+
+ArenaScope::~ArenaScope() {
+  scope_allocator = previous_;
+  arena_->Close();
+}
+
+std::size_t ArenaScope::GetReservedBytes() const {
+  return arena_->GetReservedBytes();
+}
+
+AllocationStats GetAllocationStats() {
+  AllocationStats stats;
+  stats.allocations = counters.allocations.load();
+  stats.deallocations = counters.deallocations.load();
+  stats.bytes_allocated = counters.bytes_allocated.load();
+  stats.bytes_in_use = counters.bytes_in_use.load();
+  stats.peak_bytes_in_use = counters.peak_bytes_in_use.load();
+  stats.system_allocations = counters.system_allocations.load();
+  stats.system_bytes = counters.system_bytes.load();
+  return stats;
+}
+
+// Живые буферы остаются живыми: сбрасываются только накопленные счётчики.
+void ResetAllocationStats() {
+  counters.allocations.store(0);
+  counters.deallocations.store(0);
+  counters.bytes_allocated.store(0);
+  counters.peak_bytes_in_use.store(counters.bytes_in_use.load());
+  counters.system_allocations.store(0);
+  counters.system_bytes.store(0);
+}
+
+void *AllocateMatrixBuffer(std::size_t bytes) {
+  MatrixAllocator &allocator = GetAllocator();
+  std::size_t total = bytes + kBufferHeader;
+  char *block = static_cast<char *>(allocator.Allocate(total));
+  *reinterpret_cast<BufferHeader *>(block) = {&allocator, total, false};
+  counters.allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+  UpdatePeak(counters.bytes_in_use.fetch_add(bytes) + bytes);
+#ifdef S21_INSTRUMENTATION
+  profile::CountAllocation(bytes);
+#endif
+  return block + kBufferHeader;
+}
+
+void *AdoptMatrixBuffer(void *block, std::size_t bytes,
+                        MatrixAllocator &allocator) {
+  *static_cast<BufferHeader *>(block) = {&allocator, bytes, true};
+  std::size_t payload = bytes - kBufferHeader;
+  counters.allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.bytes_allocated.fetch_add(payload, std::memory_order_relaxed);
+  UpdatePeak(counters.bytes_in_use.fetch_add(payload) + payload);
+  return static_cast<char *>(block) + kBufferHeader;
+}
+
+std::size_t GetMatrixBufferCapacity(const void *buffer) noexcept {
+  const BufferHeader &header = *reinterpret_cast<const BufferHeader *>(
+      static_cast<const char *>(buffer) - kBufferHeader);
+  return header.adopted ? 0 : header.bytes - kBufferHeader;
+}
+
+void FreeMatrixBuffer(void *buffer) noexcept {
+  if (buffer == nullptr) return;
+  char *block = static_cast<char *>(buffer) - kBufferHeader;
+  BufferHeader header = *reinterpret_cast<BufferHeader *>(block);
+  counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+  counters.bytes_in_use.fetch_sub(header.bytes - kBufferHeader);
+  header.allocator->Deallocate(block, header.bytes);
+}
+
+}  // namespace s21
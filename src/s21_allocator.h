@@ -0,0 +1,139 @@
+#ifndef S21_ALLOCATOR
+#define S21_ALLOCATOR
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace s21 {
+
+// Источник памяти для буферов S21Matrix. Allocate возвращает блок,
+// выровненный на 64 байта; Deallocate получает тот же размер в байтах.
+class MatrixAllocator {
+ public:
+  virtual ~MatrixAllocator() = default;
+  virtual void *Allocate(std::size_t bytes) = 0;
+  virtual void Deallocate(void *buffer, std::size_t bytes) noexcept = 0;
+};
+
+// Каждый буфер — отдельный вызов operator new. Используется по умолчанию.
+class SystemAllocator : public MatrixAllocator {
+ public:
+  void *Allocate(std::size_t bytes) override;
+  void Deallocate(void *buffer, std::size_t bytes) noexcept override;
+};
+
+// Пул с классами размеров: освобождённые буферы не возвращаются системе,
+// а ждут следующего запроса своего класса. Классы идут по четыре на каждую
+// степень двойки, так что запас памяти не больше 25%. Потокобезопасен.
+class PoolAllocator : public MatrixAllocator {
+ public:
+  // max_cached_bytes — предел памяти, удерживаемой в свободных списках;
+  // сверх него буферы возвращаются системе.
+  explicit PoolAllocator(std::size_t max_cached_bytes = std::size_t(1) << 30);
+  ~PoolAllocator() override;
+  PoolAllocator(const PoolAllocator &) = delete;
+  PoolAllocator &operator=(const PoolAllocator &) = delete;
+
+  void *Allocate(std::size_t bytes) override;
+  void Deallocate(void *buffer, std::size_t bytes) noexcept override;
+
+  std::size_t GetCachedBytes() const;  //память в свободных списках
+  void Trim();                         //вернуть свободные буферы системе
+
+ private:
+  std::vector<std::vector<void *>> free_lists_;
+  std::size_t cached_bytes_;
+  std::size_t max_cached_bytes_;
+  mutable std::mutex mutex_;
+};
+
+// Общий пул библиотеки. Живёт до конца программы, поэтому матрицы
+// в статических переменных можно освобождать в любом порядке.
+PoolAllocator &GetPoolAllocator();
+
+// Распределитель для новых матриц из текущего потока: заданный
+// AllocatorScope, иначе глобальный.
+MatrixAllocator &GetAllocator();
+
+// Глобальный распределитель; nullptr — SystemAllocator. Матрица помнит,
+// откуда взят её буфер, так что смена распределителя безопасна для
+// существующих матриц, но сам распределитель должен их пережить.
+void SetAllocator(MatrixAllocator *allocator);
+
+// Подменяет распределитель для матриц, создаваемых в текущем потоке,
+// пока объект жив.
+class AllocatorScope {
+ public:
+  explicit AllocatorScope(MatrixAllocator &allocator);
+  ~AllocatorScope();
+  AllocatorScope(const AllocatorScope &) = delete;
+  AllocatorScope &operator=(const AllocatorScope &) = delete;
+
+ private:
+  MatrixAllocator *previous_;
+};
+
+class Arena;
+
+// Все матрицы, созданные в текущем потоке внутри области, берут память
+// сдвигом указателя в общих кусках арены. Освобождение отдельной матрицы
+// ничего не стоит; куски возвращаются системе разом, когда область
+// закрыта и уничтожена последняя матрица из неё. Если внутри области
+// освобождены все её матрицы, арена начинает заполняться заново.
+class ArenaScope {
+ public:
+  explicit ArenaScope(std::size_t chunk_bytes = std::size_t(1) << 20);
+  ~ArenaScope();
+  ArenaScope(const ArenaScope &) = delete;
+  ArenaScope &operator=(const ArenaScope &) = delete;
+
+  std::size_t GetReservedBytes() const;  //память кусков арены
+
+ private:
+  Arena *arena_;
+  MatrixAllocator *previous_;
+};
+
+// Счётчики выделений буферов матриц с начала программы или с последнего
+// ResetAllocationStats. system_* показывают реальные обращения к
+// operator new, по ним видно, сколько запросов поглотили пул и арена.
+struct AllocationStats {
+  std::size_t allocations = 0;       //выделено буферов матриц
+  std::size_t deallocations = 0;     //освобождено буферов матриц
+  std::size_t bytes_allocated = 0;   //суммарный объём выделенных буферов
+  std::size_t bytes_in_use = 0;      //объём живых буферов
+  std::size_t peak_bytes_in_use = 0;  //максимум bytes_in_use
+  std::size_t system_allocations = 0;  //вызовов operator new
+  std::size_t system_bytes = 0;        //байт, запрошенных у operator new
+};
+
+AllocationStats GetAllocationStats();
+void ResetAllocationStats();
+
+// Буферы матриц выровнены под кэш-линию. Заголовок перед данными
+// занимает ровно одну линию, так что данные остаются выровненными; он
+// входит и в размер блока, и в любые бюджеты памяти на матрицу.
+constexpr std::size_t kBufferAlignment = 64;
+constexpr std::size_t kBufferHeader = 64;
+
+// Буфер матрицы: запоминает распределитель и размер в заголовке перед
+// данными, чтобы освободить его туда же, откуда он взят.
+void *AllocateMatrixBuffer(std::size_t bytes);
+void FreeMatrixBuffer(void *buffer) noexcept;
+
+// Берёт под управление блок, полученный в обход распределителя, например
+// отображённый файл: первые 64 байта блока станут заголовком, данные
+// начинаются за ними. FreeMatrixBuffer вернёт весь блок в
+// allocator.Deallocate с тем же bytes.
+void *AdoptMatrixBuffer(void *block, std::size_t bytes,
+                        MatrixAllocator &allocator);
+
+// Байт данных, под которые выделен буфер. Для блоков из AdoptMatrixBuffer
+// — 0: отображение может быть только для чтения, и запас в нём не
+// используется.
+std::size_t GetMatrixBufferCapacity(const void *buffer) noexcept;
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,58 @@
+#include "s21_cpu.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace s21 {
+namespace {
+
+CpuFeatures DetectCpuFeatures() {
+  CpuFeatures features;
+#if defined(__x86_64__) && defined(__GNUC__)
+  __builtin_cpu_init();
+  features.sse2 = __builtin_cpu_supports("sse2");
+  features.avx2 = __builtin_cpu_supports("avx2");
+  features.fma = __builtin_cpu_supports("fma");
+  features.avx512f = __builtin_cpu_supports("avx512f");
+#endif
+  return features;
+}
+
+std::atomic<int> simd_level_limit{static_cast<int>(SimdLevel::kAvx512)};
+
+}  // namespace
+
+const CpuFeatures &GetCpuFeatures() {
+  static const CpuFeatures features = DetectCpuFeatures();
+  return features;
+}
+
+SimdLevel GetSimdLevel() {
+  const CpuFeatures &features = GetCpuFeatures();
+  SimdLevel supported = SimdLevel::kScalar;
+  if (features.sse2) supported = SimdLevel::kSse2;
+  if (features.avx2 && features.fma) supported = SimdLevel::kAvx2;
+  if (features.avx512f && supported == SimdLevel::kAvx2)
+    supported = SimdLevel::kAvx512;
+  return static_cast<SimdLevel>(
+      std::min(static_cast<int>(supported), simd_level_limit.load()));
+}
+
+void SetSimdLevelLimit(SimdLevel limit) {
+  simd_level_limit.store(static_cast<int>(limit));
+}
+
+const char *SimdLevelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kSse2:
+      return "sse2";
+    case SimdLevel::kAvx2:
+      return "avx2";
+    case SimdLevel::kAvx512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace s21
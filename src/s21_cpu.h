@@ -0,0 +1,31 @@
+#ifndef S21_CPU
+#define S21_CPU
+
+namespace s21 {
+
+// Наборы векторных инструкций в порядке возрастания ширины.
+enum class SimdLevel { kScalar = 0, kSse2 = 1, kAvx2 = 2, kAvx512 = 3 };
+
+// Что умеет процессор, на котором запущена программа. Определяется один раз.
+struct CpuFeatures {
+  bool sse2 = false;
+  bool avx2 = false;
+  bool fma = false;
+  bool avx512f = false;
+};
+
+const CpuFeatures &GetCpuFeatures();
+
+// Наибольший уровень, который поддерживает процессор и не запрещён
+// SetSimdLevelLimit.
+SimdLevel GetSimdLevel();
+
+// Ограничивает уровень сверху, например для сравнения ядер в бенчмарке.
+// Действует на все последующие вызовы ядер.
+void SetSimdLevelLimit(SimdLevel limit);
+
+const char *SimdLevelName(SimdLevel level);
+
+}  // namespace s21
+
+#endif
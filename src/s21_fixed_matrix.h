@@ -0,0 +1,392 @@
+#ifndef S21_FIXED_MATRIX
+#define S21_FIXED_MATRIX
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_oop.h"
+
+// Матрица с размерами времени компиляции для мелких преобразований
+// (2x2, 3x3, 4x4): элементы лежат в самом объекте, без кучи и без проверок
+// размеров во время работы. Циклы с постоянными границами разворачиваются
+// полностью, определитель и обратная до 4x4 считаются явными формулами.
+// Операции над матрицами несовместимых размеров не компилируются.
+//
+// С S21Matrix матрица совместима в обе стороны: неявно превращается в
+// S21Matrix, явно строится из S21Matrix или вида, View() даёт вид на её
+// элементы; смешанные +, -, * и == возвращают S21Matrix. Тип элементов T
+// (по умолчанию double) должен совпадать с типом S21BasicMatrix.
+namespace s21 {
+namespace fixed {
+
+struct Uninitialized {};
+
+}  // namespace fixed
+}  // namespace s21
+
+template <int R, int C, typename T = double>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "Matrix dimensions must be positive");
+
+ private:
+  T data_[R][C];
+
+  // Для результатов, которые целиком перезаписываются: без обнуления.
+  explicit S21FixedMatrix(s21::fixed::Uninitialized) {}
+  template <int, int, typename>
+  friend class S21FixedMatrix;
+
+  void CheckIndex(int row_index, int col_index) const {
+    if (row_index < 0 || col_index < 0 || row_index >= R || col_index >= C)
+      throw std::out_of_range("Index is out of range");
+  }
+
+ public:
+  typedef T Scalar;
+
+  S21FixedMatrix() : data_() {}
+  // Элементы по строкам: S21FixedMatrix<2, 2> m(1, 2, 3, 4).
+  template <typename... Values,
+            typename = std::enable_if_t<
+                (sizeof...(Values) > 1 || R * C == 1) &&
+                std::conjunction<std::is_arithmetic<Values>...>::value>>
+  S21FixedMatrix(Values... values) {
+    static_assert(sizeof...(Values) == R * C,
+                  "The number of values must equal R * C");
+    const T flat[] = {static_cast<T>(values)...};
+#pragma GCC unroll 16
+    for (int k = 0; k < R * C; ++k) data_[k / C][k % C] = flat[k];
+  }
+  explicit S21FixedMatrix(const S21BasicMatrixView<T> &other) : data_() {
+    if (other.GetRows() != R || other.GetCols() != C)
+      throw std::logic_error("Matrix sizes are different");
+    for (int i = 0; i < R; ++i)
+      for (int j = 0; j < C; ++j) data_[i][j] = other(i, j);
+  }
+
+  static constexpr int GetRows() { return R; }
+  static constexpr int GetCols() { return C; }
+  T *GetData() { return &data_[0][0]; }
+  const T *GetData() const { return &data_[0][0]; }
+  S21BasicMatrixView<T> View() const {
+    return S21BasicMatrixView<T>(const_cast<T *>(&data_[0][0]), R, C, C);
+  }
+  operator S21BasicMatrix<T>() const { return S21BasicMatrix<T>(View()); }
+
+  // Доступ без проверки во время работы: индексы проверяются компилятором.
+  template <int I, int J>
+  T &At() {
+    static_assert(I >= 0 && I < R && J >= 0 && J < C, "Index out of range");
+    return data_[I][J];
+  }
+  template <int I, int J>
+  T At() const {
+    static_assert(I >= 0 && I < R && J >= 0 && J < C, "Index out of range");
+    return data_[I][J];
+  }
+
+  bool EqMatrix(const S21FixedMatrix &other) const {
+    bool equal = true;
+#pragma GCC unroll 16
+    for (int k = 0; k < R * C; ++k)
+      equal &= data_[k / C][k % C] == other.data_[k / C][k % C];
+    return equal;
+  }
+
+  void SumMatrix(const S21FixedMatrix &other) {
+#pragma GCC unroll 16
+    for (int k = 0; k < R * C; ++k)
+      data_[k / C][k % C] += other.data_[k / C][k % C];
+  }
+
+  void SubMatrix(const S21FixedMatrix &other) {
+#pragma GCC unroll 16
+    for (int k = 0; k < R * C; ++k)
+      data_[k / C][k % C] -= other.data_[k / C][k % C];
+  }
+
+  void MulNumber(const T num) {
+#pragma GCC unroll 16
+    for (int k = 0; k < R * C; ++k) data_[k / C][k % C] *= num;
+  }
+
+  template <int K>
+  S21FixedMatrix<R, K, T> Multiply(
+      const S21FixedMatrix<C, K, T> &other) const {
+    S21FixedMatrix<R, K, T> result{s21::fixed::Uninitialized()};
+#pragma GCC unroll 16
+    for (int i = 0; i < R; ++i)
+#pragma GCC unroll 16
+      for (int j = 0; j < K; ++j) {
+        T sum = data_[i][0] * other.data_[0][j];
+#pragma GCC unroll 16
+        for (int k = 1; k < C; ++k) sum += data_[i][k] * other.data_[k][j];
+        result.data_[i][j] = sum;
+      }
+    return result;
+  }
+
+  // Как и у S21Matrix, размер this не меняется только для квадратной other.
+  void MulMatrix(const S21FixedMatrix<C, C, T> &other) {
+    *this = Multiply(other);
+  }
+
+  S21FixedMatrix<C, R, T> Transpose() const {
+    S21FixedMatrix<C, R, T> result{s21::fixed::Uninitialized()};
+#pragma GCC unroll 16
+    for (int k = 0; k < R * C; ++k)
+      result.data_[k % C][k / C] = data_[k / C][k % C];
+    return result;
+  }
+
+  S21FixedMatrix<R - 1, C - 1, T> Minor(int skip_row, int skip_colm) const {
+    CheckIndex(skip_row, skip_colm);
+    S21FixedMatrix<R - 1, C - 1, T> minor_matrix{
+        s21::fixed::Uninitialized()};
+#pragma GCC unroll 16
+    for (int i = 0; i < R - 1; ++i)
+#pragma GCC unroll 16
+      for (int j = 0; j < C - 1; ++j)
+        minor_matrix.data_[i][j] =
+            data_[i + (i >= skip_row)][j + (j >= skip_colm)];
+    return minor_matrix;
+  }
+
+  T Determinant() const {
+    static_assert(R == C, "The matrix isn't square");
+    const T(&a)[R][C] = data_;
+    if constexpr (R == 1) {
+      return a[0][0];
+    } else if constexpr (R == 2) {
+      return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+    } else if constexpr (R == 3) {
+      return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+             a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+             a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    } else if constexpr (R == 4) {
+      //разложение Лапласа по парам строк: 12 миноров 2x2
+      T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+      T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+      T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+      T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+      T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+      T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+      T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+      T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+      T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+      T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+      T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+      T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+      return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    } else {
+      return S21BasicMatrix<T>(*this).Determinant();
+    }
+  }
+
+  S21FixedMatrix CalcComplements() const {
+    static_assert(R == C, "The matrix isn't square");
+    if constexpr (R == 1) {
+      return S21FixedMatrix(1.0);
+    } else if constexpr (R <= 4) {
+      S21FixedMatrix complements_matrix{s21::fixed::Uninitialized()};
+#pragma GCC unroll 16
+      for (int i = 0; i < R; ++i)
+#pragma GCC unroll 16
+        for (int j = 0; j < C; ++j) {
+          T minor_determinant = Minor(i, j).Determinant();
+          complements_matrix.data_[i][j] =
+              (i + j) % 2 == 0 ? minor_determinant : -minor_determinant;
+        }
+      return complements_matrix;
+    } else {
+      return S21FixedMatrix(S21BasicMatrix<T>(*this).CalcComplements());
+    }
+  }
+
+  S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "The matrix isn't square");
+    if constexpr (R <= 3) {
+      T determinant = Determinant();
+      if (determinant == 0) throw std::logic_error("The determinant is zero");
+      //присоединённая матрица — транспонированные дополнения
+      S21FixedMatrix inverse_matrix = CalcComplements().Transpose();
+      inverse_matrix.MulNumber(1 / determinant);
+      return inverse_matrix;
+    } else if constexpr (R == 4) {
+      //те же миноры 2x2, что и в определителе, дают все дополнения
+      const T(&a)[R][C] = data_;
+      T s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+      T s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+      T s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+      T s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+      T s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+      T s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+      T c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+      T c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+      T c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+      T c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+      T c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+      T c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+      T determinant =
+          s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+      if (determinant == 0) throw std::logic_error("The determinant is zero");
+      S21FixedMatrix inverse_matrix{s21::fixed::Uninitialized()};
+      T(&b)[R][C] = inverse_matrix.data_;
+      const T scale = 1 / determinant;
+      b[0][0] = (a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * scale;
+      b[0][1] = (-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * scale;
+      b[0][2] = (a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * scale;
+      b[0][3] = (-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * scale;
+      b[1][0] = (-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * scale;
+      b[1][1] = (a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * scale;
+      b[1][2] = (-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * scale;
+      b[1][3] = (a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * scale;
+      b[2][0] = (a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * scale;
+      b[2][1] = (-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * scale;
+      b[2][2] = (a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * scale;
+      b[2][3] = (-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * scale;
+      b[3][0] = (-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * scale;
+      b[3][1] = (a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * scale;
+      b[3][2] = (-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * scale;
+      b[3][3] = (a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * scale;
+      return inverse_matrix;
+    } else {
+      return S21FixedMatrix(S21BasicMatrix<T>(*this).InverseMatrix());
+    }
+  }
+
+  T *operator[](int index) {
+    CheckIndex(index, 0);
+    return data_[index];
+  }
+  const T *operator[](int index) const {
+    CheckIndex(index, 0);
+    return data_[index];
+  }
+  T &operator()(int row_index, int col_index) {
+    CheckIndex(row_index, col_index);
+    return data_[row_index][col_index];
+  }
+  T operator()(int row_index, int col_index) const {
+    CheckIndex(row_index, col_index);
+    return data_[row_index][col_index];
+  }
+
+  bool operator==(const S21FixedMatrix &other) const {
+    return EqMatrix(other);
+  }
+  S21FixedMatrix operator+(const S21FixedMatrix &other) const {
+    S21FixedMatrix result(*this);
+    result.SumMatrix(other);
+    return result;
+  }
+  S21FixedMatrix operator-(const S21FixedMatrix &other) const {
+    S21FixedMatrix result(*this);
+    result.SubMatrix(other);
+    return result;
+  }
+  S21FixedMatrix operator*(const T num) const {
+    S21FixedMatrix result(*this);
+    result.MulNumber(num);
+    return result;
+  }
+  template <int K>
+  S21FixedMatrix<R, K, T> operator*(
+      const S21FixedMatrix<C, K, T> &other) const {
+    return Multiply(other);
+  }
+  S21FixedMatrix &operator+=(const S21FixedMatrix &other) {
+    SumMatrix(other);
+    return *this;
+  }
+  S21FixedMatrix &operator-=(const S21FixedMatrix &other) {
+    SubMatrix(other);
+    return *this;
+  }
+  S21FixedMatrix &operator*=(const S21FixedMatrix<C, C, T> &other) {
+    MulMatrix(other);
+    return *this;
+  }
+  S21FixedMatrix &operator*=(const T num) {
+    MulNumber(num);
+    return *this;
+  }
+};
+
+template <int R, int C, typename T>
+S21FixedMatrix<R, C, T> operator*(
+    const typename S21FixedMatrix<R, C, T>::Scalar num,
+    const S21FixedMatrix<R, C, T> &matrix) {
+  return matrix * num;
+}
+
+// Несовместимые размеры или типы: без этих перегрузок одна из матриц
+// неявно превратилась бы в S21Matrix и ошибка всплыла бы только во время
+// работы.
+template <int R1, int C1, typename T1, int R2, int C2, typename T2>
+void operator+(const S21FixedMatrix<R1, C1, T1> &,
+               const S21FixedMatrix<R2, C2, T2> &) = delete;
+
+template <int R1, int C1, typename T1, int R2, int C2, typename T2>
+void operator-(const S21FixedMatrix<R1, C1, T1> &,
+               const S21FixedMatrix<R2, C2, T2> &) = delete;
+
+template <int R1, int C1, typename T1, int R2, int C2, typename T2>
+void operator*(const S21FixedMatrix<R1, C1, T1> &,
+               const S21FixedMatrix<R2, C2, T2> &) = delete;
+
+template <int R1, int C1, typename T1, int R2, int C2, typename T2>
+bool operator==(const S21FixedMatrix<R1, C1, T1> &,
+                const S21FixedMatrix<R2, C2, T2> &) = delete;
+
+// Смешанные операции: размеры S21Matrix известны только во время работы,
+// несовпадение даёт то же исключение, что и у S21Matrix.
+template <int R, int C, typename T>
+S21BasicMatrix<T> operator+(const S21FixedMatrix<R, C, T> &lhs,
+                            const S21BasicMatrix<T> &rhs) {
+  return lhs.View() + rhs;
+}
+
+template <int R, int C, typename T>
+S21BasicMatrix<T> operator+(const S21BasicMatrix<T> &lhs,
+                            const S21FixedMatrix<R, C, T> &rhs) {
+  return lhs + rhs.View();
+}
+
+template <int R, int C, typename T>
+S21BasicMatrix<T> operator-(const S21FixedMatrix<R, C, T> &lhs,
+                            const S21BasicMatrix<T> &rhs) {
+  return lhs.View() - rhs;
+}
+
+template <int R, int C, typename T>
+S21BasicMatrix<T> operator-(const S21BasicMatrix<T> &lhs,
+                            const S21FixedMatrix<R, C, T> &rhs) {
+  return lhs - rhs.View();
+}
+
+template <int R, int C, typename T>
+S21BasicMatrix<T> operator*(const S21FixedMatrix<R, C, T> &lhs,
+                            const S21BasicMatrix<T> &rhs) {
+  return lhs.View() * rhs;
+}
+
+template <int R, int C, typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &lhs,
+                            const S21FixedMatrix<R, C, T> &rhs) {
+  return lhs * rhs.View();
+}
+
+template <int R, int C, typename T>
+bool operator==(const S21FixedMatrix<R, C, T> &lhs,
+                const S21BasicMatrix<T> &rhs) {
+  return lhs.View() == rhs;
+}
+
+template <int R, int C, typename T>
+bool operator==(const S21BasicMatrix<T> &lhs,
+                const S21FixedMatrix<R, C, T> &rhs) {
+  return lhs == rhs.View();
+}
+
+#endif
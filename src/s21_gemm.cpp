@@ -0,0 +1,326 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "s21_cpu.h"
+#include "s21_parallel.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define S21_GEMM_X86_DISPATCH 1
+#endif
+
+namespace s21 {
+namespace {
+
+// Размеры блоков: микропанель B (kKc x kNr) и панель A (kMr x kKc) вместе
+// помещаются в L1, блок A (kMc x kKc) — в L2, панель B (kKc x kNc) — в L3.
+constexpr int kMr = 6;
+constexpr int kKc = 256;
+constexpr int kMc = 120;
+constexpr int kNc = 2048;
+// Ниже этого числа умножений упаковка не окупается.
+constexpr long kSmallProduct = 32L * 32L * 32L;
+// Ниже этого числа умножений запуск задач в пуле не окупается.
+constexpr long kParallelProduct = 128L * 128L * 128L;
+
+constexpr std::size_t kPackAlignment = 64;
+
+// Векторный регистр AVX2 из 32 байт: 4 double или 8 float. Полоса B —
+// два регистра, так что у float она вдвое шире при том же объёме в байтах.
+template <typename T>
+struct Register {
+  typedef T Vec __attribute__((vector_size(32)));
+  static constexpr int kLanes = 32 / sizeof(T);
+  static constexpr int kNr = 2 * kLanes;
+};
+
+template <typename T>
+class PackBuffer {
+ public:
+  ~PackBuffer() { Free(); }
+
+  T *Reserve(std::size_t count) {
+    if (count > capacity_) {
+      Free();
+      data_ = static_cast<T *>(
+          ::operator new(count * sizeof(T), std::align_val_t(kPackAlignment)));
+      capacity_ = count;
+    }
+    return data_;
+  }
+
+ private:
+  void Free() noexcept {
+    if (data_ != nullptr)
+      ::operator delete(data_, std::align_val_t(kPackAlignment));
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  T *data_ = nullptr;
+  std::size_t capacity_ = 0;
+};
+
+// Буферы упаковки свои у каждого потока и каждого типа элементов.
+// Статические в функции, а не шаблоны переменных: деструктор thread_local
+// шаблона переменной при завершении потока не вызывался, и буферы текли.
+template <typename T>
+PackBuffer<T> &APackBuffer() {
+  thread_local PackBuffer<T> buffer;
+  return buffer;
+}
+
+template <typename T>
+PackBuffer<T> &BPackBuffer() {
+  thread_local PackBuffer<T> buffer;
+  return buffer;
+}
+
+template <typename T>
+void ScaleC(int m, int n, T beta, T *c, int ldc) {
+  if (beta == 1) return;
+  for (int i = 0; i < m; ++i) {
+    T *c_row = c + static_cast<std::size_t>(i) * ldc;
+    if (beta == 0)
+      std::fill(c_row, c_row + n, T(0));
+    else
+      for (int j = 0; j < n; ++j) c_row[j] *= beta;
+  }
+}
+
+template <typename T>
+void SmallGemm(int m, int n, int k, T alpha, const T *a, int lda, const T *b,
+               int ldb, T *c, int ldc) {
+  for (int i = 0; i < m; ++i) {
+    const T *a_row = a + static_cast<std::size_t>(i) * lda;
+    T *c_row = c + static_cast<std::size_t>(i) * ldc;
+    for (int p = 0; p < k; ++p) {
+      const T factor = alpha * a_row[p];
+      const T *b_row = b + static_cast<std::size_t>(p) * ldb;
+      for (int j = 0; j < n; ++j) c_row[j] += factor * b_row[j];
+    }
+  }
+}
+
+// Панель A раскладывается полосами по kMr строк: a_pack[p * kMr + i].
+// Неполная последняя полоса дополняется нулями, alpha вносится здесь же.
+template <typename T>
+void PackA(int mc, int kc, const T *a, int lda, T alpha, T *a_pack) {
+  for (int ir = 0; ir < mc; ir += kMr) {
+    int mr = std::min(kMr, mc - ir);
+    for (int p = 0; p < kc; ++p) {
+      for (int i = 0; i < mr; ++i)
+        a_pack[p * kMr + i] =
+            alpha * a[static_cast<std::size_t>(ir + i) * lda + p];
+      for (int i = mr; i < kMr; ++i) a_pack[p * kMr + i] = 0;
+    }
+    a_pack += static_cast<std::size_t>(kc) * kMr;
+  }
+}
+
+// Панель B раскладывается полосами по kNr столбцов: b_pack[p * kNr + j].
+template <typename T>
+void PackB(int kc, int nc, const T *b, int ldb, T *b_pack) {
+  constexpr int kNr = Register<T>::kNr;
+  for (int jr = 0; jr < nc; jr += kNr) {
+    int nr = std::min(kNr, nc - jr);
+    for (int p = 0; p < kc; ++p) {
+      const T *b_row = b + static_cast<std::size_t>(p) * ldb + jr;
+      std::memcpy(b_pack + p * kNr, b_row, nr * sizeof(T));
+      for (int j = nr; j < kNr; ++j) b_pack[p * kNr + j] = 0;
+    }
+    b_pack += static_cast<std::size_t>(kc) * kNr;
+  }
+}
+
+// Регистровое ядро: блок kMr x kNr копится в 12 векторных аккумуляторах.
+template <typename T>
+inline __attribute__((always_inline)) void MicroKernel(int kc,
+                                                       const T *a_pack,
+                                                       const T *b_pack, T *c,
+                                                       int ldc, int mr,
+                                                       int nr) {
+  typedef typename Register<T>::Vec Vec;
+  constexpr int kLanes = Register<T>::kLanes, kNr = Register<T>::kNr;
+  Vec acc[kMr][2] = {};
+  for (int p = 0; p < kc; ++p) {
+    Vec b0, b1;
+    std::memcpy(&b0, b_pack, sizeof(Vec));
+    std::memcpy(&b1, b_pack + kLanes, sizeof(Vec));
+#pragma GCC unroll 6
+    for (int i = 0; i < kMr; ++i) {
+      acc[i][0] += a_pack[i] * b0;
+      acc[i][1] += a_pack[i] * b1;
+    }
+    a_pack += kMr;
+    b_pack += kNr;
+  }
+  if (mr == kMr && nr == kNr) {
+#pragma GCC unroll 6
+    for (int i = 0; i < kMr; ++i) {
+      T *c_row = c + static_cast<std::size_t>(i) * ldc;
+      Vec c0, c1;
+      std::memcpy(&c0, c_row, sizeof(Vec));
+      std::memcpy(&c1, c_row + kLanes, sizeof(Vec));
+      c0 += acc[i][0];
+      c1 += acc[i][1];
+      std::memcpy(c_row, &c0, sizeof(Vec));
+      std::memcpy(c_row + kLanes, &c1, sizeof(Vec));
+    }
+  } else {
+    for (int i = 0; i < mr; ++i) {
+      T *c_row = c + static_cast<std::size_t>(i) * ldc;
+      for (int j = 0; j < nr; ++j)
+        c_row[j] += acc[i][j / kLanes][j % kLanes];
+    }
+  }
+}
+
+template <typename T>
+inline __attribute__((always_inline)) void MacroKernelBody(
+    int mc, int nc, int kc, const T *a_pack, const T *b_pack, T *c, int ldc) {
+  constexpr int kNr = Register<T>::kNr;
+  for (int jr = 0; jr < nc; jr += kNr) {
+    int nr = std::min(kNr, nc - jr);
+    const T *b_panel = b_pack + static_cast<std::size_t>(jr) * kc;
+    for (int ir = 0; ir < mc; ir += kMr) {
+      int mr = std::min(kMr, mc - ir);
+      const T *a_panel = a_pack + static_cast<std::size_t>(ir) * kc;
+      MicroKernel(kc, a_panel, b_panel,
+                  c + static_cast<std::size_t>(ir) * ldc + jr, ldc, mr, nr);
+    }
+  }
+}
+
+template <typename T>
+using MacroKernelFunction = void (*)(int, int, int, const T *, const T *, T *,
+                                     int);
+
+template <typename T>
+void MacroKernelGeneric(int mc, int nc, int kc, const T *a_pack,
+                        const T *b_pack, T *c, int ldc) {
+  MacroKernelBody(mc, nc, kc, a_pack, b_pack, c, ldc);
+}
+
+#ifdef S21_GEMM_X86_DISPATCH
+template <typename T>
+__attribute__((target("avx2,fma"))) void MacroKernelAvx2(
+    int mc, int nc, int kc, const T *a_pack, const T *b_pack, T *c, int ldc) {
+  MacroKernelBody(mc, nc, kc, a_pack, b_pack, c, ldc);
+}
+#endif
+
+// Ядро выбирается по возможностям процессора, на котором запущены.
+template <typename T>
+MacroKernelFunction<T> SelectMacroKernel() {
+#ifdef S21_GEMM_X86_DISPATCH
+  if (GetSimdLevel() >= SimdLevel::kAvx2) return MacroKernelAvx2<T>;
+#endif
+  return MacroKernelGeneric<T>;
+}
+
+// У long double нет векторных типов: строки C считаются простым циклом,
+// большие произведения — в несколько потоков.
+void ScalarGemm(int m, int n, int k, long double alpha, const long double *a,
+                int lda, const long double *b, int ldb, long double *c,
+                int ldc) {
+  long row_work = static_cast<long>(n) * k;
+  int grain = static_cast<int>(kSmallProduct / (row_work + 1) + 1);
+  ParallelFor(0, m, grain, [&](int first, int last) {
+    SmallGemm(last - first, n, k, alpha,
+              a + static_cast<std::size_t>(first) * lda, lda, b, ldb,
+              c + static_cast<std::size_t>(first) * ldc, ldc);
+  });
+}
+
+template <typename T>
+void PackedGemm(int m, int n, int k, T alpha, const T *a, int lda, const T *b,
+                int ldb, T beta, T *c, int ldc) {
+  if (m <= 0 || n <= 0) return;
+  ScaleC(m, n, beta, c, ldc);
+  if (k <= 0 || alpha == 0) return;
+  if (static_cast<long>(m) * n * k <= kSmallProduct) {
+    SmallGemm(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+    return;
+  }
+  if constexpr (std::is_same<T, long double>::value) {
+    ScalarGemm(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+    return;
+  } else {
+    constexpr int kNr = Register<T>::kNr;
+    const MacroKernelFunction<T> macro_kernel = SelectMacroKernel<T>();
+    const int threads = static_cast<long>(m) * n * k < kParallelProduct
+                            ? 1
+                            : GetThreadCount();
+    int nc_max = std::min(kNc, (n + kNr - 1) / kNr * kNr);
+    T *b_pack =
+        BPackBuffer<T>().Reserve(static_cast<std::size_t>(nc_max) * kKc);
+    // Блоки C делятся между потоками по строкам (по kMc или мельче, если
+    // блоков меньше, чем потоков) и при нехватке строк ещё по столбцам.
+    // Порядок суммирования по k от разбиения не зависит, поэтому результат
+    // не меняется с числом потоков.
+    int mc_step = kMc;
+    if ((m + kMc - 1) / kMc < threads)
+      mc_step =
+          std::max(kMr, ((m + threads - 1) / threads + kMr - 1) / kMr * kMr);
+    const int m_blocks = (m + mc_step - 1) / mc_step;
+    for (int jc = 0; jc < n; jc += kNc) {
+      int nc = std::min(kNc, n - jc);
+      int strips = (nc + kNr - 1) / kNr;
+      int n_parts = std::clamp(threads / m_blocks, 1, strips);
+      int nr_step = (strips + n_parts - 1) / n_parts * kNr;
+      n_parts = (nc + nr_step - 1) / nr_step;
+      for (int pc = 0; pc < k; pc += kKc) {
+        int kc = std::min(kKc, k - pc);
+        const T *b_block = b + static_cast<std::size_t>(pc) * ldb + jc;
+        auto pack_strips = [&](int first, int last) {
+          PackB(kc, std::min(nc, last * kNr) - first * kNr,
+                b_block + first * kNr, ldb,
+                b_pack + static_cast<std::size_t>(first) * kNr * kc);
+        };
+        auto multiply_blocks = [&](int first, int last) {
+          T *a_pack = APackBuffer<T>().Reserve(
+              static_cast<std::size_t>(mc_step) * kKc);
+          for (int block = first; block < last; ++block) {
+            int ic = block / n_parts * mc_step;
+            int jr = block % n_parts * nr_step;
+            int mc = std::min(mc_step, m - ic);
+            int nr = std::min(nr_step, nc - jr);
+            PackA(mc, kc, a + static_cast<std::size_t>(ic) * lda + pc, lda,
+                  alpha, a_pack);
+            macro_kernel(mc, nr, kc, a_pack,
+                         b_pack + static_cast<std::size_t>(jr) * kc,
+                         c + static_cast<std::size_t>(ic) * ldc + jc + jr, ldc);
+          }
+        };
+        const int blocks = m_blocks * n_parts;
+        ParallelFor(0, strips, threads > 1 ? 4 : strips, pack_strips);
+        ParallelFor(0, blocks, threads > 1 ? 1 : blocks, multiply_blocks);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void Gemm(int m, int n, int k, float alpha, const float *a, int lda,
+          const float *b, int ldb, float beta, float *c, int ldc) {
+  PackedGemm(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+void Gemm(int m, int n, int k, double alpha, const double *a, int lda,
+          const double *b, int ldb, double beta, double *c, int ldc) {
+  PackedGemm(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+void Gemm(int m, int n, int k, long double alpha, const long double *a,
+          int lda, const long double *b, int ldb, long double beta,
+          long double *c, int ldc) {
+  PackedGemm(m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+}  // namespace s21
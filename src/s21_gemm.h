@@ -0,0 +1,20 @@
+#ifndef S21_GEMM
+#define S21_GEMM
+
+namespace s21 {
+
+// C = alpha * A * B + beta * C для матриц, хранящихся построчно:
+// A — m x k с шагом lda, B — k x n с шагом ldb, C — m x n с шагом ldc.
+// При beta == 0 содержимое C не читается. Для long double векторного ядра
+// нет, произведение считается простым циклом по строкам.
+void Gemm(int m, int n, int k, float alpha, const float *a, int lda,
+          const float *b, int ldb, float beta, float *c, int ldc);
+void Gemm(int m, int n, int k, double alpha, const double *a, int lda,
+          const double *b, int ldb, double beta, double *c, int ldc);
+void Gemm(int m, int n, int k, long double alpha, const long double *a,
+          int lda, const long double *b, int ldb, long double beta,
+          long double *c, int ldc);
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,298 @@
+#include "s21_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define S21_KERNELS_X86 1
+#endif
+
+namespace s21 {
+namespace {
+
+// Тела ядер пишутся один раз на векторных расширениях GCC, а ширина
+// регистра и набор инструкций задаются обёртками с атрибутом target ниже.
+// В регистре kBytes байт помещается kBytes / sizeof(T) элементов.
+template <typename T, int kBytes>
+struct Lanes {
+  static constexpr int kCount = kBytes / sizeof(T);
+  typedef T Vec __attribute__((vector_size(kBytes)));
+  typedef decltype(Vec() != Vec()) Mask;
+};
+
+#define S21_KERNEL_BODY inline __attribute__((always_inline))
+
+// Относительная граница не больше наибольшего конечного числа: иначе
+// при бесконечном операнде она сама бесконечна и inf проходит рядом с
+// -inf или с любым конечным числом.
+template <typename T>
+S21_KERNEL_BODY bool IsNear(T lhs, T rhs, T absolute, T relative) {
+  const T bound = std::min(relative * std::max(std::fabs(lhs), std::fabs(rhs)),
+                           std::numeric_limits<T>::max());
+  return lhs == rhs || std::fabs(lhs - rhs) <= std::max(absolute, bound);
+}
+
+// Тела всегда встраиваются в обёртки, так что векторы через границу вызова
+// не передаются и предупреждение об ABI к ним неприменимо.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+template <typename T, int kBytes>
+S21_KERNEL_BODY typename Lanes<T, kBytes>::Vec Load(const T *source) {
+  typename Lanes<T, kBytes>::Vec value;
+  std::memcpy(&value, source, sizeof(value));
+  return value;
+}
+
+template <typename T, int kBytes>
+S21_KERNEL_BODY void Store(T *target,
+                           const typename Lanes<T, kBytes>::Vec &value) {
+  std::memcpy(target, &value, sizeof(value));
+}
+
+template <typename T, int kBytes>
+S21_KERNEL_BODY void AddBody(T *dst, const T *src, std::size_t count) {
+  constexpr int kLanes = Lanes<T, kBytes>::kCount;
+  std::size_t i = 0;
+  for (; i + 2 * kLanes <= count; i += 2 * kLanes) {
+    Store<T, kBytes>(dst + i,
+                     Load<T, kBytes>(dst + i) + Load<T, kBytes>(src + i));
+    Store<T, kBytes>(dst + i + kLanes,
+                     Load<T, kBytes>(dst + i + kLanes) +
+                         Load<T, kBytes>(src + i + kLanes));
+  }
+  for (; i < count; ++i) dst[i] += src[i];
+}
+
+template <typename T, int kBytes>
+S21_KERNEL_BODY void SubBody(T *dst, const T *src, std::size_t count) {
+  constexpr int kLanes = Lanes<T, kBytes>::kCount;
+  std::size_t i = 0;
+  for (; i + 2 * kLanes <= count; i += 2 * kLanes) {
+    Store<T, kBytes>(dst + i,
+                     Load<T, kBytes>(dst + i) - Load<T, kBytes>(src + i));
+    Store<T, kBytes>(dst + i + kLanes,
+                     Load<T, kBytes>(dst + i + kLanes) -
+                         Load<T, kBytes>(src + i + kLanes));
+  }
+  for (; i < count; ++i) dst[i] -= src[i];
+}
+
+template <typename T, int kBytes>
+S21_KERNEL_BODY void ScaleBody(T *dst, T factor, std::size_t count) {
+  constexpr int kLanes = Lanes<T, kBytes>::kCount;
+  std::size_t i = 0;
+  for (; i + 2 * kLanes <= count; i += 2 * kLanes) {
+    Store<T, kBytes>(dst + i, Load<T, kBytes>(dst + i) * factor);
+    Store<T, kBytes>(dst + i + kLanes,
+                     Load<T, kBytes>(dst + i + kLanes) * factor);
+  }
+  for (; i < count; ++i) dst[i] *= factor;
+}
+
+template <typename T, int kBytes>
+S21_KERNEL_BODY void AddScaledBody(T *dst, const T *src, T factor,
+                                   std::size_t count) {
+  constexpr int kLanes = Lanes<T, kBytes>::kCount;
+  std::size_t i = 0;
+  for (; i + 2 * kLanes <= count; i += 2 * kLanes) {
+    Store<T, kBytes>(dst + i, Load<T, kBytes>(dst + i) +
+                                  Load<T, kBytes>(src + i) * factor);
+    Store<T, kBytes>(dst + i + kLanes,
+                     Load<T, kBytes>(dst + i + kLanes) +
+                         Load<T, kBytes>(src + i + kLanes) * factor);
+  }
+  for (; i < count; ++i) dst[i] += src[i] * factor;
+}
+
+// Несовпадения копятся по блоку из четырёх векторов, затем проверяются
+// разом: ранний выход стоит одну свёртку маски на блок.
+template <typename T, int kBytes>
+S21_KERNEL_BODY bool EqualBody(const T *lhs, const T *rhs,
+                               std::size_t count) {
+  constexpr int kLanes = Lanes<T, kBytes>::kCount;
+  typedef typename Lanes<T, kBytes>::Mask Mask;
+  std::size_t i = 0;
+  for (; i + 4 * kLanes <= count; i += 4 * kLanes) {
+    Mask mismatch = Load<T, kBytes>(lhs + i) != Load<T, kBytes>(rhs + i);
+    for (int block = 1; block < 4; ++block) {
+      std::size_t offset = i + block * kLanes;
+      mismatch |=
+          Load<T, kBytes>(lhs + offset) != Load<T, kBytes>(rhs + offset);
+    }
+    long long any = 0;
+    for (int lane = 0; lane < kLanes; ++lane) any |= mismatch[lane];
+    if (any != 0) return false;
+  }
+  for (; i < count; ++i)
+    if (lhs[i] != rhs[i]) return false;
+  return true;
+}
+
+// Отмечает в mismatch элементы вектора, у которых нет ни равенства, ни
+// разности в пределах допуска (NaN не проходит ни то, ни другое).
+template <typename T, int kBytes>
+S21_KERNEL_BODY void AddFarMask(typename Lanes<T, kBytes>::Mask &mismatch,
+                                const T *lhs, const T *rhs, T absolute,
+                                T relative) {
+  typedef typename Lanes<T, kBytes>::Vec Vec;
+  const Vec left = Load<T, kBytes>(lhs), right = Load<T, kBytes>(rhs);
+  const Vec difference = left - right;
+  const Vec distance = difference < 0 ? -difference : difference;
+  const Vec left_abs = left < 0 ? -left : left;
+  const Vec right_abs = right < 0 ? -right : right;
+  const T largest = std::numeric_limits<T>::max();
+  Vec bound = relative * (left_abs > right_abs ? left_abs : right_abs);
+  bound = bound < largest ? bound : largest;
+  bound = bound > absolute ? bound : absolute;
+  // Равенство обнуляет расстояние (inf - inf = NaN) выбором, а не
+  // через | двух масок: без AVX-512DQ GCC собирает такую маску
+  // поэлементно.
+  const Vec zero = {};
+  const Vec within = left == right ? zero : distance;
+  mismatch |= ~(within <= bound);
+}
+
+template <typename T, int kBytes>
+S21_KERNEL_BODY bool NearBody(const T *lhs, const T *rhs, T absolute,
+                              T relative, std::size_t count) {
+  constexpr int kLanes = Lanes<T, kBytes>::kCount;
+  typedef typename Lanes<T, kBytes>::Mask Mask;
+  std::size_t i = 0;
+  for (; i + 4 * kLanes <= count; i += 4 * kLanes) {
+    Mask mismatch = {};
+    for (int block = 0; block < 4; ++block) {
+      std::size_t offset = i + block * kLanes;
+      AddFarMask<T, kBytes>(mismatch, lhs + offset, rhs + offset, absolute,
+                            relative);
+    }
+    long long any = 0;
+    for (int lane = 0; lane < kLanes; ++lane) any |= mismatch[lane];
+    if (any != 0) return false;
+  }
+  for (; i < count; ++i)
+    if (!IsNear(lhs[i], rhs[i], absolute, relative)) return false;
+  return true;
+}
+
+#pragma GCC diagnostic pop
+
+template <typename T>
+void AddScalar(T *dst, const T *src, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] += src[i];
+}
+
+template <typename T>
+void SubScalar(T *dst, const T *src, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] -= src[i];
+}
+
+template <typename T>
+void ScaleScalar(T *dst, T factor, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] *= factor;
+}
+
+template <typename T>
+void AddScaledScalar(T *dst, const T *src, T factor, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) dst[i] += src[i] * factor;
+}
+
+template <typename T>
+bool EqualScalar(const T *lhs, const T *rhs, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i)
+    if (lhs[i] != rhs[i]) return false;
+  return true;
+}
+
+template <typename T>
+bool NearScalar(const T *lhs, const T *rhs, T absolute, T relative,
+                std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i)
+    if (!IsNear(lhs[i], rhs[i], absolute, relative)) return false;
+  return true;
+}
+
+#define S21_DEFINE_KERNELS(suffix, target, bytes)                            \
+  template <typename T>                                                      \
+  target void Add##suffix(T *dst, const T *src, std::size_t count) {         \
+    AddBody<T, bytes>(dst, src, count);                                      \
+  }                                                                          \
+  template <typename T>                                                      \
+  target void Sub##suffix(T *dst, const T *src, std::size_t count) {         \
+    SubBody<T, bytes>(dst, src, count);                                      \
+  }                                                                          \
+  template <typename T>                                                      \
+  target void Scale##suffix(T *dst, T factor, std::size_t count) {           \
+    ScaleBody<T, bytes>(dst, factor, count);                                 \
+  }                                                                          \
+  template <typename T>                                                      \
+  target void AddScaled##suffix(T *dst, const T *src, T factor,              \
+                                std::size_t count) {                         \
+    AddScaledBody<T, bytes>(dst, src, factor, count);                        \
+  }                                                                          \
+  template <typename T>                                                      \
+  target bool Equal##suffix(const T *lhs, const T *rhs, std::size_t count) { \
+    return EqualBody<T, bytes>(lhs, rhs, count);                             \
+  }                                                                          \
+  template <typename T>                                                      \
+  target bool Near##suffix(const T *lhs, const T *rhs, T absolute,           \
+                           T relative, std::size_t count) {                  \
+    return NearBody<T, bytes>(lhs, rhs, absolute, relative, count);          \
+  }                                                                          \
+  template <typename T>                                                      \
+  const BasicElementwiseKernels<T> k##suffix##Kernels = {                    \
+      Add##suffix<T>, Sub##suffix<T>, Scale##suffix<T>,                      \
+      AddScaled##suffix<T>, Equal##suffix<T>, Near##suffix<T>};
+
+#ifdef S21_KERNELS_X86
+S21_DEFINE_KERNELS(Sse2, __attribute__((target("sse2"))), 16)
+S21_DEFINE_KERNELS(Avx2, __attribute__((target("avx2,fma"))), 32)
+S21_DEFINE_KERNELS(Avx512, __attribute__((target("avx512f"))), 64)
+#endif
+
+template <typename T>
+const BasicElementwiseKernels<T> kScalarKernels = {
+    AddScalar<T>, SubScalar<T>, ScaleScalar<T>, AddScaledScalar<T>,
+    EqualScalar<T>, NearScalar<T>};
+
+}  // namespace
+
+// У long double нет векторных типов: для него все уровни скалярные.
+template <typename T>
+const BasicElementwiseKernels<T> &GetElementwiseKernels(SimdLevel level) {
+#ifdef S21_KERNELS_X86
+  if constexpr (!std::is_same<T, long double>::value) {
+    switch (level) {
+      case SimdLevel::kSse2:
+        return kSse2Kernels<T>;
+      case SimdLevel::kAvx2:
+        return kAvx2Kernels<T>;
+      case SimdLevel::kAvx512:
+        return kAvx512Kernels<T>;
+      default:
+        break;
+    }
+  }
+#endif
+  (void)level;
+  return kScalarKernels<T>;
+}
+
+template <typename T>
+const BasicElementwiseKernels<T> &GetElementwiseKernels() {
+  return GetElementwiseKernels<T>(GetSimdLevel());
+}
+
+#define S21_INSTANTIATE_KERNELS(T)                                   \
+  template const BasicElementwiseKernels<T> &GetElementwiseKernels<T>(); \
+  template const BasicElementwiseKernels<T> &GetElementwiseKernels<T>(   \
+      SimdLevel);
+
+S21_INSTANTIATE_KERNELS(float)
+S21_INSTANTIATE_KERNELS(double)
+S21_INSTANTIATE_KERNELS(long double)
+
+}  // namespace s21
@@ -0,0 +1,39 @@
+#ifndef S21_KERNELS
+#define S21_KERNELS
+
+#include <cstddef>
+
+#include "s21_cpu.h"
+
+namespace s21 {
+
+// Поэлементные ядра над непрерывными массивами из count элементов типа T.
+// Есть для float, double и long double; у float вдвое больше элементов в
+// векторном регистре, у long double векторных ядер нет.
+template <typename T>
+struct BasicElementwiseKernels {
+  void (*add)(T *dst, const T *src, std::size_t count);
+  void (*sub)(T *dst, const T *src, std::size_t count);
+  void (*scale)(T *dst, T factor, std::size_t count);
+  // dst += factor * src за один проход
+  void (*add_scaled)(T *dst, const T *src, T factor, std::size_t count);
+  // точное сравнение, выход на первом несовпавшем блоке
+  bool (*equal)(const T *lhs, const T *rhs, std::size_t count);
+  // |lhs - rhs| <= max(absolute, relative * max(|lhs|, |rhs|)) или
+  // lhs == rhs для каждого элемента, с тем же ранним выходом
+  bool (*near)(const T *lhs, const T *rhs, T absolute, T relative,
+               std::size_t count);
+};
+
+typedef BasicElementwiseKernels<double> ElementwiseKernels;
+
+// Ядра для уровня GetSimdLevel(); перегрузка с уровнем не проверяет,
+// поддерживает ли его процессор.
+template <typename T = double>
+const BasicElementwiseKernels<T> &GetElementwiseKernels();
+template <typename T = double>
+const BasicElementwiseKernels<T> &GetElementwiseKernels(SimdLevel level);
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,417 @@
+#include "s21_lu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+#include "s21_gemm.h"
+#include "s21_parallel.h"
+
+namespace {
+// Ширина панели: панель раскладывается построчно, остаток обновляется
+// одним вызовом Gemm.
+constexpr int kBlockSize = 64;
+// Столбцов правой части на поток: подстановки по разным столбцам
+// независимы.
+constexpr int kSolveGrain = 16;
+}  // namespace
+
+template <typename T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrix<T> &matrix)
+    : lu_(matrix),
+      permutation_(),
+      sign_(1),
+      max_abs_(0),
+      zero_pivot_(false) {
+  if (matrix.GetRows() != matrix.GetCols())
+    throw std::logic_error("The matrix isn't square");
+  int n = GetSize();
+  permutation_.resize(n);
+  std::iota(permutation_.begin(), permutation_.end(), 0);
+  T *data = lu_.GetData();
+  std::size_t ld = lu_.GetStride();
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      max_abs_ = std::max(max_abs_, std::fabs(data[i * ld + j]));
+
+  for (int first = 0; first < n; first += kBlockSize) {
+    int width = std::min(kBlockSize, n - first);
+    FactorPanel(first, width);
+    int rest = first + width;
+    if (rest >= n) continue;
+    // U12 = L11^-1 * A12, столбцы делятся между потоками
+    s21::ParallelFor(rest, n, kBlockSize, [&](int col_first, int col_last) {
+      for (int i = first + 1; i < rest; ++i) {
+        T *row = data + i * ld;
+        for (int p = first; p < i; ++p) {
+          const T factor = row[p];
+          if (factor == 0) continue;
+          const T *pivot_row = data + p * ld;
+          for (int j = col_first; j < col_last; ++j)
+            row[j] -= factor * pivot_row[j];
+        }
+      }
+    });
+    // A22 -= L21 * U12
+    s21::Gemm(n - rest, n - rest, width, -1.0, data + rest * ld + first, ld,
+              data + first * ld + rest, ld, 1.0, data + rest * ld + rest, ld);
+  }
+  // u_kk = a_kk - sum l_kp * u_pk считается с погрешностью не больше
+  // n * eps * (|a_kk| + sum |l_kp * u_pk|). Ведущий элемент не больше
+  // этой погрешности — остаток сокращения, а не значение, и считается
+  // нулевым. В отличие от IsSingular(), порог не зависит от масштаба
+  // строк и столбцов: diag(1e20, 1, 1, 1) невырождена.
+  const T eps = n * std::numeric_limits<T>::epsilon();
+  for (int k = 0; k < n && !zero_pivot_; ++k) {
+    const T *row = data + k * ld;
+    T magnitude = std::fabs(matrix[permutation_[k]][k]);
+    for (int p = 0; p < k; ++p)
+      magnitude += std::fabs(row[p] * data[p * ld + k]);
+    if (std::fabs(row[k]) <= eps * magnitude) zero_pivot_ = true;
+  }
+}
+
+template <typename T>
+void S21BasicLU<T>::FactorPanel(int first, int width) {
+  int n = GetSize();
+  T *data = lu_.GetData();
+  std::size_t ld = lu_.GetStride();
+  int last = first + width;
+  for (int j = first; j < last; ++j) {
+    int pivot = j;
+    T pivot_abs = std::fabs(data[j * ld + j]);
+    for (int i = j + 1; i < n; ++i) {
+      T candidate = std::fabs(data[i * ld + j]);
+      if (candidate > pivot_abs) {
+        pivot = i;
+        pivot_abs = candidate;
+      }
+    }
+    if (pivot != j) {
+      std::swap_ranges(data + j * ld, data + j * ld + n, data + pivot * ld);
+      std::swap(permutation_[j], permutation_[pivot]);
+      sign_ = -sign_;
+    }
+    const T *pivot_row = data + j * ld;
+    if (pivot_row[j] == 0) {
+      zero_pivot_ = true;
+      continue;
+    }
+    for (int i = j + 1; i < n; ++i) {
+      T *row = data + i * ld;
+      row[j] /= pivot_row[j];
+      const T factor = row[j];
+      if (factor == 0) continue;
+      for (int c = j + 1; c < last; ++c) row[c] -= factor * pivot_row[c];
+    }
+  }
+}
+
+template <typename T>
+int S21BasicLU<T>::GetSize() const { return lu_.GetRows(); }
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::GetL() const {
+  int n = GetSize();
+  S21BasicMatrix<T> lower(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < i; ++j) lower[i][j] = lu_[i][j];
+    lower[i][i] = 1;
+  }
+  return lower;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::GetU() const {
+  int n = GetSize();
+  S21BasicMatrix<T> upper(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = i; j < n; ++j) upper[i][j] = lu_[i][j];
+  return upper;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::GetP() const {
+  int n = GetSize();
+  S21BasicMatrix<T> permutation(n, n);
+  for (int i = 0; i < n; ++i) permutation[i][permutation_[i]] = 1;
+  return permutation;
+}
+
+template <typename T>
+const S21BasicMatrix<T> &S21BasicLU<T>::GetPacked() const { return lu_; }
+
+template <typename T>
+const std::vector<int> &S21BasicLU<T>::GetPermutation() const {
+  return permutation_;
+}
+
+template <typename T>
+int S21BasicLU<T>::GetSign() const { return sign_; }
+
+template <typename T>
+T S21BasicLU<T>::Determinant() const {
+  if (zero_pivot_) return 0;
+  // Мантисса и порядок копятся раздельно, поэтому промежуточное
+  // произведение не переполняется, а при отсутствии переполнения результат
+  // совпадает с прямым перемножением диагонали.
+  T mantissa = sign_;
+  long exponent = 0;
+  for (int i = 0; i < GetSize(); ++i) {
+    int factor_exponent = 0;
+    mantissa = std::frexp(mantissa * lu_[i][i], &factor_exponent);
+    exponent += factor_exponent;
+  }
+  const long limit = 4L * std::numeric_limits<T>::max_exponent;
+  exponent = std::clamp(exponent, -limit, limit);
+  return std::ldexp(mantissa, static_cast<int>(exponent));
+}
+
+template <typename T>
+T S21BasicLU<T>::LogAbsDeterminant() const {
+  if (zero_pivot_) return -std::numeric_limits<T>::infinity();
+  T result = 0;
+  for (int i = 0; i < GetSize(); ++i) result += std::log(std::fabs(lu_[i][i]));
+  return result;
+}
+
+template <typename T>
+T S21BasicLU<T>::MinPivotRatio() const {
+  if (zero_pivot_ || max_abs_ == 0) return 0;
+  T min_pivot = std::numeric_limits<T>::infinity();
+  for (int i = 0; i < GetSize(); ++i)
+    min_pivot = std::min(min_pivot, std::fabs(lu_[i][i]));
+  return min_pivot / max_abs_;
+}
+
+template <typename T>
+bool S21BasicLU<T>::HasZeroPivot() const { return zero_pivot_; }
+
+template <typename T>
+bool S21BasicLU<T>::IsSingular() const {
+  return MinPivotRatio() <=
+         GetSize() * std::numeric_limits<T>::epsilon();
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Solve(const S21BasicMatrix<T> &rhs) const {
+  int n = GetSize();
+  if (rhs.GetRows() != n)
+    throw std::logic_error(
+        "The rows number of the right-hand side is not equal to the matrix "
+        "order");
+  // Ведущий элемент на уровне погрешности дал бы решение из остатков
+  // округления порядка 1e15; плохой масштаб матрицы решению не мешает.
+  if (zero_pivot_) throw std::logic_error("The determinant is zero");
+  S21BasicMatrix<T> solution(n, rhs.GetCols());
+  std::size_t bytes = rhs.GetCols() * sizeof(T);
+  for (int i = 0; i < n; ++i)
+    std::memcpy(solution[i], rhs[permutation_[i]], bytes);
+  T *x = solution.GetData();
+  std::size_t x_ld = solution.GetStride();
+  s21::ParallelFor(0, rhs.GetCols(), kSolveGrain, [&](int first, int last) {
+    SolveLower(x + first, x_ld, last - first);
+    SolveUpper(x + first, x_ld, last - first);
+  });
+  return solution;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Inverse() const {
+  int n = GetSize();
+  S21BasicMatrix<T> identity(n, n);
+  for (int i = 0; i < n; ++i) identity[i][i] = 1;
+  return Solve(identity);
+}
+
+// Блочная прямая подстановка с единичной диагональю L по cols столбцам
+// правой части x: внедиагональные блоки вычитаются через Gemm, внутри
+// диагонального блока — построчно.
+template <typename T>
+void S21BasicLU<T>::SolveLower(T *x, std::size_t rhs_ld, int cols) const {
+  int n = GetSize();
+  const T *data = lu_.GetData();
+  std::size_t ld = lu_.GetStride();
+  for (int first = 0; first < n; first += kBlockSize) {
+    int last = std::min(first + kBlockSize, n);
+    s21::Gemm(last - first, cols, first, -1.0, data + first * ld, ld, x,
+              rhs_ld, 1.0, x + first * rhs_ld, rhs_ld);
+    for (int i = first + 1; i < last; ++i) {
+      T *row = x + i * rhs_ld;
+      for (int p = first; p < i; ++p) {
+        const T factor = data[i * ld + p];
+        if (factor == 0) continue;
+        const T *solved = x + p * rhs_ld;
+        for (int j = 0; j < cols; ++j) row[j] -= factor * solved[j];
+      }
+    }
+  }
+}
+
+// Блочная обратная подстановка по U, блоки идут снизу вверх.
+template <typename T>
+void S21BasicLU<T>::SolveUpper(T *x, std::size_t rhs_ld, int cols) const {
+  int n = GetSize();
+  const T *data = lu_.GetData();
+  std::size_t ld = lu_.GetStride();
+  for (int last = n; last > 0; last -= kBlockSize) {
+    int first = std::max(last - kBlockSize, 0);
+    s21::Gemm(last - first, cols, n - last, -1.0, data + first * ld + last,
+              ld, x + last * rhs_ld, rhs_ld, 1.0, x + first * rhs_ld, rhs_ld);
+    for (int i = last - 1; i >= first; --i) {
+      T *row = x + i * rhs_ld;
+      for (int p = i + 1; p < last; ++p) {
+        const T factor = data[i * ld + p];
+        if (factor == 0) continue;
+        const T *solved = x + p * rhs_ld;
+        for (int j = 0; j < cols; ++j) row[j] -= factor * solved[j];
+      }
+      const T pivot = data[i * ld + i];
+      for (int j = 0; j < cols; ++j) row[j] /= pivot;
+    }
+  }
+}
+
+template <typename T>
+S21BasicCompleteLU<T>::S21BasicCompleteLU(const S21BasicMatrix<T> &matrix)
+    : lu_(matrix),
+      row_permutation_(),
+      col_permutation_(),
+      sign_(1),
+      rank_(0) {
+  if (matrix.GetRows() != matrix.GetCols())
+    throw std::logic_error("The matrix isn't square");
+  int n = GetSize();
+  row_permutation_.resize(n);
+  col_permutation_.resize(n);
+  std::iota(row_permutation_.begin(), row_permutation_.end(), 0);
+  std::iota(col_permutation_.begin(), col_permutation_.end(), 0);
+  T *data = lu_.GetData();
+  std::size_t ld = lu_.GetStride();
+  for (int k = 0; k < n; ++k) {
+    int pivot_row = k, pivot_col = k;
+    T pivot_abs = 0;
+    for (int i = k; i < n; ++i) {
+      for (int j = k; j < n; ++j) {
+        T candidate = std::fabs(data[i * ld + j]);
+        if (candidate > pivot_abs) {
+          pivot_row = i;
+          pivot_col = j;
+          pivot_abs = candidate;
+        }
+      }
+    }
+    if (pivot_abs == 0) break;
+    if (pivot_row != k) {
+      std::swap_ranges(data + k * ld, data + k * ld + n,
+                       data + pivot_row * ld);
+      std::swap(row_permutation_[k], row_permutation_[pivot_row]);
+      sign_ = -sign_;
+    }
+    if (pivot_col != k) {
+      for (int i = 0; i < n; ++i)
+        std::swap(data[i * ld + k], data[i * ld + pivot_col]);
+      std::swap(col_permutation_[k], col_permutation_[pivot_col]);
+      sign_ = -sign_;
+    }
+    const T *pivot_data = data + k * ld;
+    for (int i = k + 1; i < n; ++i) {
+      T *row = data + i * ld;
+      row[k] /= pivot_data[k];
+      const T factor = row[k];
+      if (factor == 0) continue;
+      for (int j = k + 1; j < n; ++j) row[j] -= factor * pivot_data[j];
+    }
+  }
+  // Ранг — число ведущих элементов больше погрешности своего вычисления,
+  // как в S21BasicLU: порог у каждого свой, а не доля наибольшего, иначе
+  // diag(1e20, 1, 1, 1) получила бы ранг 1.
+  const T eps = n * std::numeric_limits<T>::epsilon();
+  while (rank_ < n) {
+    const int k = rank_;
+    const T *row = data + k * ld;
+    T magnitude =
+        std::fabs(matrix[row_permutation_[k]][col_permutation_[k]]);
+    for (int p = 0; p < k; ++p)
+      magnitude += std::fabs(row[p] * data[p * ld + k]);
+    if (std::fabs(row[k]) <= eps * magnitude) break;
+    ++rank_;
+  }
+}
+
+template <typename T>
+int S21BasicCompleteLU<T>::GetSize() const { return lu_.GetRows(); }
+
+template <typename T>
+int S21BasicCompleteLU<T>::GetRank() const { return rank_; }
+
+// A = P^T * L * U * Q^T, поэтому adj(A) = det(P) det(Q) * Q adj(U) L^-1 P.
+// Для U = [[U11, u], [0, mu]] с невырожденной U11
+// adj(U) = det(U11) * [[mu * U11^-1, -U11^-1 * u], [0, 1]] при любом mu,
+// так что матрицы ранга n - 1 обрабатываются без деления на mu.
+// При ранге ниже n - 1 все миноры порядка n - 1 нулевые.
+template <typename T>
+S21BasicMatrix<T> S21BasicCompleteLU<T>::Adjugate() const {
+  int n = GetSize();
+  if (n == 0) return S21BasicMatrix<T>();
+  S21BasicMatrix<T> adjugate(n, n);
+  if (n == 1) {
+    adjugate[0][0] = 1;
+    return adjugate;
+  }
+  if (GetRank() < n - 1) return adjugate;
+  int m = n - 1;
+
+  S21BasicMatrix<T> lower_inverse(n, n);
+  for (int i = 0; i < n; ++i) {
+    T *row = lower_inverse[i];
+    row[i] = 1;
+    for (int p = 0; p < i; ++p) {
+      const T factor = lu_[i][p];
+      if (factor == 0) continue;
+      const T *solved = lower_inverse[p];
+      for (int j = 0; j <= p; ++j) row[j] -= factor * solved[j];
+    }
+  }
+
+  S21BasicMatrix<T> upper_part(n, n);
+  for (int i = m - 1; i >= 0; --i) {
+    T *row = upper_part[i];
+    row[i] = 1;
+    row[m] = -lu_[i][m];
+    for (int p = i + 1; p < m; ++p) {
+      const T factor = lu_[i][p];
+      if (factor == 0) continue;
+      const T *solved = upper_part[p];
+      for (int j = p; j <= m; ++j) row[j] -= factor * solved[j];
+    }
+    const T pivot = lu_[i][i];
+    for (int j = i; j <= m; ++j) row[j] /= pivot;
+  }
+  const T mu = lu_[m][m];
+  T factor = sign_;
+  for (int i = 0; i < m; ++i) {
+    factor *= lu_[i][i];
+    for (int j = i; j < m; ++j) upper_part[i][j] *= mu;
+  }
+  upper_part[m][m] = 1;
+
+  S21BasicMatrix<T> product = upper_part * lower_inverse;
+  for (int i = 0; i < n; ++i) {
+    T *adjugate_row = adjugate[col_permutation_[i]];
+    const T *product_row = product[i];
+    for (int j = 0; j < n; ++j)
+      adjugate_row[row_permutation_[j]] = factor * product_row[j];
+  }
+  return adjugate;
+}
+
+template class S21BasicLU<float>;
+template class S21BasicLU<double>;
+template class S21BasicLU<long double>;
+template class S21BasicCompleteLU<float>;
+template class S21BasicCompleteLU<double>;
+template class S21BasicCompleteLU<long double>;
@@ -0,0 +1,85 @@
+#ifndef S21_LU
+#define S21_LU
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU-разложение с частичным выбором ведущего элемента: P * A = L * U.
+// L (единичная диагональ) и U хранятся вместе в одной матрице, разложение
+// считается один раз и может многократно использоваться. Инстанцировано
+// для float, double и long double; порог вырожденности берётся из
+// машинного эпсилон своего типа.
+template <typename T>
+class S21BasicLU {
+ private:
+  typedef S21BasicMatrix<T> Matrix;
+
+  Matrix lu_;                     //L под диагональю, U на ней и выше
+  std::vector<int> permutation_;  //строка i в P * A — строка permutation_[i]
+  int sign_;                      //чётность перестановки: +1 или -1
+  T max_abs_;                     //максимум модуля элементов A
+  bool zero_pivot_;               //ведущий элемент нулевой (HasZeroPivot)
+
+  void FactorPanel(int first, int width);
+  void SolveLower(T *x, std::size_t rhs_ld, int cols) const;
+  void SolveUpper(T *x, std::size_t rhs_ld, int cols) const;
+
+ public:
+  explicit S21BasicLU(const Matrix &matrix);  //разложение квадратной матрицы
+
+  int GetSize() const;                             //порядок матрицы
+  Matrix GetL() const;                             //нижняя треугольная L
+  Matrix GetU() const;                             //верхняя треугольная U
+  Matrix GetP() const;                             //матрица перестановки P
+  const Matrix &GetPacked() const;                 //L и U в одной матрице
+  const std::vector<int> &GetPermutation() const;  //перестановка строк
+  int GetSign() const;                             //знак перестановки
+
+  T Determinant() const;  //определитель без переполнения в промежутках
+  T LogAbsDeterminant() const;  //ln|det A|, -inf для вырожденной
+  T MinPivotRatio() const;  //min|u_ii| / max|a_ij|, 0 для вырожденной
+  bool IsSingular() const;  //min|u_ii| / max|a_ij| не больше n * eps
+  // Ведущий элемент нулевой или не больше погрешности своего вычисления;
+  // не зависит от масштаба строк и столбцов.
+  bool HasZeroPivot() const;
+
+  // При нулевом ведущем элементе (HasZeroPivot) — std::logic_error.
+  Matrix Solve(const Matrix &rhs) const;  //X из A * X = B, без A^-1
+  Matrix Inverse() const;                 //обратная матрица
+};
+
+// LU-разложение с полным выбором ведущего элемента: P * A * Q = L * U.
+// Медленнее частичного, зато выявляет ранг, поэтому используется там, где
+// матрица может оказаться вырожденной.
+template <typename T>
+class S21BasicCompleteLU {
+ private:
+  typedef S21BasicMatrix<T> Matrix;
+
+  Matrix lu_;                         //L под диагональю, U на ней и выше
+  std::vector<int> row_permutation_;  //строка i в P * A — строка [i] у A
+  std::vector<int> col_permutation_;  //столбец j в A * Q — столбец [j] у A
+  int sign_;                          //det(P) * det(Q)
+  int rank_;                          //ненулевых ведущих элементов
+
+ public:
+  explicit S21BasicCompleteLU(const Matrix &matrix);
+
+  int GetSize() const;        //порядок матрицы
+  int GetRank() const;        //численный ранг по ведущим элементам
+  Matrix Adjugate() const;    //присоединённая матрица adj(A) для любого ранга
+};
+
+typedef S21BasicLU<double> S21LU;
+typedef S21BasicCompleteLU<double> S21CompleteLU;
+
+extern template class S21BasicLU<float>;
+extern template class S21BasicLU<double>;
+extern template class S21BasicLU<long double>;
+extern template class S21BasicCompleteLU<float>;
+extern template class S21BasicCompleteLU<double>;
+extern template class S21BasicCompleteLU<long double>;
+
+#endif
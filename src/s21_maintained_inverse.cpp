@@ -0,0 +1,200 @@
+#include "s21_maintained_inverse.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_lu.h"
+
+template <typename T>
+S21BasicMaintainedInverse<T>::S21BasicMaintainedInverse(const Matrix &matrix)
+    : S21BasicMaintainedInverse(
+          matrix, std::sqrt(std::numeric_limits<T>::epsilon())) {}
+
+template <typename T>
+S21BasicMaintainedInverse<T>::S21BasicMaintainedInverse(const Matrix &matrix,
+                                                        T tolerance)
+    : matrix_(matrix),
+      determinant_(0),
+      singular_(true),
+      tolerance_(tolerance),
+      residual_(0),
+      refactor_count_(0) {
+  if (matrix.GetRows() != matrix.GetCols())
+    throw std::logic_error("The matrix isn't square");
+  if (!(tolerance >= 0))
+    throw std::invalid_argument("Tolerance can't be negative");
+  const int n = GetSize();
+  for (std::vector<T> *vector : {&u_, &v_, &w_, &z_, &probe_, &product_})
+    vector->resize(n);
+  // Пробный вектор без особой структуры, чтобы невязка не была
+  // случайно мала.
+  for (int i = 0; i < n; ++i) probe_[i] = T((i * 37 + 11) % 17) / 8 - 1;
+  Refactor();
+}
+
+template <typename T>
+void S21BasicMaintainedInverse<T>::Refactor() {
+  ++refactor_count_;
+  S21BasicLU<T> lu(matrix_);
+  determinant_ = lu.Determinant();
+  singular_ = lu.HasZeroPivot();
+  residual_ = 0;
+  if (singular_) return;
+  inverse_ = lu.Inverse();
+  residual_ = Residual();
+}
+
+template <typename T>
+T S21BasicMaintainedInverse<T>::Residual() {
+  const int n = GetSize();
+  for (int i = 0; i < n; ++i) {
+    const T *row = inverse_[i];
+    T sum = 0;
+    for (int j = 0; j < n; ++j) sum += row[j] * probe_[j];
+    product_[i] = sum;
+  }
+  T error = 0, scale = 0;
+  for (int i = 0; i < n; ++i) {
+    const T *row = matrix_[i];
+    T sum = -probe_[i], magnitude = 0;
+    for (int j = 0; j < n; ++j) {
+      sum += row[j] * product_[j];
+      magnitude += std::fabs(row[j] * product_[j]);
+    }
+    error = std::fmax(error, std::fabs(sum));
+    scale = std::fmax(scale, magnitude);
+  }
+  return scale > 0 ? error / scale : error;
+}
+
+// Обратная для A + u * v^T, когда matrix_ уже изменена. Если u (v) —
+// единичный вектор e_unit, A^-1 u (v^T A^-1) — готовый столбец (строка)
+// обратной, и вектор не нужен.
+template <typename T>
+void S21BasicMaintainedInverse<T>::Update(const T *u, const T *v,
+                                          int unit_u, int unit_v) {
+  if (singular_) {
+    Refactor();
+    return;
+  }
+  const int n = GetSize();
+  for (int i = 0; i < n; ++i) {
+    if (unit_u >= 0) {
+      w_[i] = inverse_[i][unit_u];
+    } else {
+      const T *row = inverse_[i];
+      T sum = 0;
+      for (int j = 0; j < n; ++j) sum += row[j] * u[j];
+      w_[i] = sum;
+    }
+  }
+  if (unit_v >= 0) {
+    for (int j = 0; j < n; ++j) z_[j] = inverse_[unit_v][j];
+  } else {
+    for (int j = 0; j < n; ++j) z_[j] = 0;
+    for (int i = 0; i < n; ++i) {
+      const T *row = inverse_[i];
+      for (int j = 0; j < n; ++j) z_[j] += v[i] * row[j];
+    }
+  }
+  // Знаменатель, неотличимый от нуля на фоне округления слагаемых,
+  // значит почти вырожденную матрицу: её решает разложение.
+  T denominator = 1, magnitude = 1;
+  if (unit_v >= 0) {
+    denominator += w_[unit_v];
+    magnitude += std::fabs(w_[unit_v]);
+  } else {
+    for (int i = 0; i < n; ++i) {
+      denominator += v[i] * w_[i];
+      magnitude += std::fabs(v[i] * w_[i]);
+    }
+  }
+  if (!(std::fabs(denominator) >
+        n * std::numeric_limits<T>::epsilon() * magnitude)) {
+    Refactor();
+    return;
+  }
+  for (int i = 0; i < n; ++i) {
+    T *row = inverse_[i];
+    const T factor = w_[i] / denominator;
+    for (int j = 0; j < n; ++j) row[j] -= factor * z_[j];
+  }
+  determinant_ *= denominator;
+  residual_ = Residual();
+  if (!(residual_ <= tolerance_)) Refactor();  //и при NaN
+}
+
+template <typename T>
+void S21BasicMaintainedInverse<T>::CheckIndex(int index) const {
+  if (index < 0 || index >= GetSize())
+    throw std::out_of_range("Index is out of range");
+}
+
+template <typename T>
+int S21BasicMaintainedInverse<T>::GetSize() const {
+  return matrix_.GetRows();
+}
+
+template <typename T>
+const S21BasicMatrix<T> &S21BasicMaintainedInverse<T>::GetMatrix() const {
+  return matrix_;
+}
+
+template <typename T>
+const S21BasicMatrix<T> &S21BasicMaintainedInverse<T>::GetInverse() const {
+  if (singular_) throw std::logic_error("The determinant is zero");
+  return inverse_;
+}
+
+template <typename T>
+T S21BasicMaintainedInverse<T>::Determinant() const {
+  return determinant_;
+}
+
+template <typename T>
+T S21BasicMaintainedInverse<T>::GetResidual() const {
+  return residual_;
+}
+
+template <typename T>
+int S21BasicMaintainedInverse<T>::GetRefactorCount() const {
+  return refactor_count_;
+}
+
+// Замена строки row — это u = e_row, v = values - старая строка.
+template <typename T>
+void S21BasicMaintainedInverse<T>::UpdateRow(int row, const T *values) {
+  CheckIndex(row);
+  T *old = matrix_[row];
+  for (int j = 0; j < GetSize(); ++j) {
+    v_[j] = values[j] - old[j];
+    old[j] = values[j];
+  }
+  Update(nullptr, v_.data(), row, -1);
+}
+
+// Замена столбца col — это u = values - старый столбец, v = e_col.
+template <typename T>
+void S21BasicMaintainedInverse<T>::UpdateColumn(int col, const T *values) {
+  CheckIndex(col);
+  for (int i = 0; i < GetSize(); ++i) {
+    u_[i] = values[i] - matrix_[i][col];
+    matrix_[i][col] = values[i];
+  }
+  Update(u_.data(), nullptr, -1, col);
+}
+
+template <typename T>
+void S21BasicMaintainedInverse<T>::RankOneUpdate(const T *u, const T *v) {
+  const int n = GetSize();
+  for (int i = 0; i < n; ++i) {
+    T *row = matrix_[i];
+    for (int j = 0; j < n; ++j) row[j] += u[i] * v[j];
+  }
+  Update(u, v, -1, -1);
+}
+
+template class S21BasicMaintainedInverse<float>;
+template class S21BasicMaintainedInverse<double>;
+template class S21BasicMaintainedInverse<long double>;
@@ -0,0 +1,77 @@
+#ifndef S21_MAINTAINED_INVERSE
+#define S21_MAINTAINED_INVERSE
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Обратная матрица и определитель квадратной матрицы, которая меняется
+// по строке, по столбцу или на матрицу ранга 1. Вместо нового
+// LU-разложения за O(n^3) каждое изменение A + u * v^T пересчитывает
+// обратную по формуле Шермана–Моррисона
+//   (A + u v^T)^-1 = A^-1 - (A^-1 u)(v^T A^-1) / (1 + v^T A^-1 u),
+// а определитель — по лемме о матричном определителе
+//   det(A + u v^T) = det(A) * (1 + v^T A^-1 u),
+// обе за O(n^2).
+//
+// Погрешность обновлений накапливается, особенно когда знаменатель
+// 1 + v^T A^-1 u мал; знаменатель, неотличимый от нуля, сразу ведёт к
+// новому разложению. После каждого обновления невязка
+// max|A * (A^-1 x) - x| / max(|A| * |A^-1 x|) оценивается по одному
+// пробному вектору x, тоже за O(n^2); если она больше порога, обратная и
+// определитель считаются заново через LU-разложение.
+//
+// Матрица может стать вырожденной с точностью до округления
+// (S21BasicLU::HasZeroPivot): тогда Determinant() возвращает 0, а
+// GetInverse() бросает std::logic_error, пока изменения не вернут
+// невырожденность (до тех пор каждое изменение — новое разложение).
+template <typename T>
+class S21BasicMaintainedInverse {
+ public:
+  typedef S21BasicMatrix<T> Matrix;
+
+ private:
+  Matrix matrix_;
+  Matrix inverse_;  //не определена, если singular_
+  T determinant_;
+  bool singular_;
+  T tolerance_;     //порог невязки
+  T residual_;      //невязка после последнего изменения
+  int refactor_count_;
+  std::vector<T> u_, v_, w_, z_, probe_, product_;
+
+  void Refactor();
+  T Residual();
+  void Update(const T *u, const T *v, int unit_u, int unit_v);
+  void CheckIndex(int index) const;
+
+ public:
+  // Порог по умолчанию — корень из машинного эпсилон: обновления теряют
+  // не больше половины значащих цифр. Неквадратная матрица —
+  // std::logic_error, отрицательный порог — std::invalid_argument.
+  explicit S21BasicMaintainedInverse(const Matrix &matrix);
+  S21BasicMaintainedInverse(const Matrix &matrix, T tolerance);
+
+  int GetSize() const;
+  const Matrix &GetMatrix() const;   //текущая A
+  const Matrix &GetInverse() const;  //A^-1
+  T Determinant() const;
+  T GetResidual() const;       //оценка невязки A^-1
+  int GetRefactorCount() const;  //разложений, считая начальное
+
+  // Строка row (столбец col) заменяется n значениями values; индекс вне
+  // матрицы — std::out_of_range.
+  void UpdateRow(int row, const T *values);
+  void UpdateColumn(int col, const T *values);
+  void RankOneUpdate(const T *u, const T *v);  //A += u * v^T
+};
+
+typedef S21BasicMaintainedInverse<double> S21MaintainedInverse;
+typedef S21BasicMaintainedInverse<float> S21MaintainedInverseF;
+typedef S21BasicMaintainedInverse<long double> S21MaintainedInverseLD;
+
+extern template class S21BasicMaintainedInverse<float>;
+extern template class S21BasicMaintainedInverse<double>;
+extern template class S21BasicMaintainedInverse<long double>;
+
+#endif
@@ -0,0 +1,498 @@
+#include "s21_matrix_batch.h"
+
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "s21_allocator.h"
+#include "s21_cpu.h"
+#include "s21_parallel.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define S21_BATCH_X86_DISPATCH 1
+#endif
+
+#define S21_BATCH_INLINE inline __attribute__((always_inline))
+
+namespace {
+
+constexpr std::size_t kGroupAlignment = 64;
+
+// Значения одного элемента у всех kPack матриц группы — 64 байта, один
+// векторный тип: 8 double или 16 float. Группы в буфере пакета и в буферах
+// ядер выровнены на 64 байта.
+template <typename T>
+struct Lanes {
+  typedef T Vec __attribute__((vector_size(64)));
+};
+
+// У long double векторных типов нет: массив с теми же операциями. Число
+// значений следует из размера long double (4 при 16 байтах, 8 при 8).
+template <>
+struct Lanes<long double> {
+  struct Vec {
+    static constexpr int kCount = 64 / sizeof(long double);
+    long double value[kCount];
+
+    long double &operator[](int l) { return value[l]; }
+    long double operator[](int l) const { return value[l]; }
+    Vec &operator+=(const Vec &other) {
+      for (int l = 0; l < kCount; ++l) value[l] += other.value[l];
+      return *this;
+    }
+    Vec &operator-=(const Vec &other) {
+      for (int l = 0; l < kCount; ++l) value[l] -= other.value[l];
+      return *this;
+    }
+    Vec &operator*=(const Vec &other) {
+      for (int l = 0; l < kCount; ++l) value[l] *= other.value[l];
+      return *this;
+    }
+    friend Vec operator+(Vec lhs, const Vec &rhs) { return lhs += rhs; }
+    friend Vec operator-(Vec lhs, const Vec &rhs) { return lhs -= rhs; }
+    friend Vec operator*(Vec lhs, const Vec &rhs) { return lhs *= rhs; }
+  };
+  static_assert(sizeof(Vec) == 64, "A group element must be 64 bytes");
+};
+
+// Группа — массив элементов матрицы по строкам, элемент — Vec из kPack
+// значений разных матриц, так что каждое действие над элементом сразу
+// выполняется для всей группы.
+template <typename T>
+using Vec = typename Lanes<T>::Vec;
+
+template <typename T>
+S21_BATCH_INLINE Vec<T> *Elements(T *group) {
+  return reinterpret_cast<Vec<T> *>(group);
+}
+
+template <typename T>
+S21_BATCH_INLINE const Vec<T> *Elements(const T *group) {
+  return reinterpret_cast<const Vec<T> *>(group);
+}
+
+// c = a * b для группы: a — m x k, b — k x n, c — m x n.
+template <typename T>
+S21_BATCH_INLINE void MultiplyGroup(int m, int n, int k, const T *a_data,
+                                    const T *b_data, T *c_data) {
+  const Vec<T> *a = Elements(a_data), *b = Elements(b_data);
+  Vec<T> *c = Elements(c_data);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      Vec<T> sum = a[i * k] * b[j];
+      for (int p = 1; p < k; ++p) sum += a[i * k + p] * b[p * n + j];
+      c[i * n + j] = sum;
+    }
+  }
+}
+
+// Ставит в строку k каждой матрицы группы строку с наибольшим по модулю
+// элементом столбца k среди строк k..n-1. Та же перестановка применяется
+// к строкам b, если он задан; sign, если задан, меняет знак у
+// переставленных матриц.
+template <typename T>
+S21_BATCH_INLINE void PivotGroup(int n, int k, Vec<T> *a, Vec<T> *b,
+                                 Vec<T> *sign) {
+  constexpr int kPack = S21BasicMatrixBatch<T>::kPack;
+  for (int l = 0; l < kPack; ++l) {
+    int pivot_row = k;
+    T best = std::fabs(a[k * n + k][l]);
+    for (int r = k + 1; r < n; ++r) {
+      T value = std::fabs(a[r * n + k][l]);
+      if (value > best) {
+        best = value;
+        pivot_row = r;
+      }
+    }
+    if (pivot_row == k) continue;
+    if (sign != nullptr) (*sign)[l] = -(*sign)[l];
+    auto swap = [l](Vec<T> &lhs, Vec<T> &rhs) {
+      T value = lhs[l];
+      lhs[l] = rhs[l];
+      rhs[l] = value;
+    };
+    for (int j = k; j < n; ++j) swap(a[k * n + j], a[pivot_row * n + j]);
+    if (b != nullptr)
+      for (int j = 0; j < n; ++j) swap(b[k * n + j], b[pivot_row * n + j]);
+  }
+}
+
+// 1 / pivot для каждой матрицы; нулевой ведущий элемент заменяется
+// единицей, вырожденность проверяет вызывающий.
+template <typename T>
+S21_BATCH_INLINE void InvertPivot(const Vec<T> &pivot, Vec<T> &inverse) {
+  constexpr int kPack = S21BasicMatrixBatch<T>::kPack;
+  for (int l = 0; l < kPack; ++l)
+    inverse[l] = 1 / (pivot[l] == 0 ? T(1) : pivot[l]);
+}
+
+// Определители группы n x n. До 3x3 — явные формулы, больше — исключение
+// Гаусса с выбором ведущего элемента в a, которая при этом портится.
+template <typename T>
+S21_BATCH_INLINE void DeterminantGroup(int n, Vec<T> *a, T *determinant) {
+  constexpr int kPack = S21BasicMatrixBatch<T>::kPack;
+  auto e = [a, n](int i, int j) -> Vec<T> & { return a[i * n + j]; };
+  Vec<T> result;
+  if (n == 1) {
+    result = e(0, 0);
+  } else if (n == 2) {
+    result = e(0, 0) * e(1, 1) - e(0, 1) * e(1, 0);
+  } else if (n == 3) {
+    result = e(0, 0) * (e(1, 1) * e(2, 2) - e(1, 2) * e(2, 1)) -
+             e(0, 1) * (e(1, 0) * e(2, 2) - e(1, 2) * e(2, 0)) +
+             e(0, 2) * (e(1, 0) * e(2, 1) - e(1, 1) * e(2, 0));
+  } else {
+    for (int l = 0; l < kPack; ++l) result[l] = 1;
+    for (int k = 0; k < n; ++k) {
+      PivotGroup<T>(n, k, a, nullptr, &result);
+      result *= e(k, k);
+      Vec<T> inverse;
+      InvertPivot<T>(e(k, k), inverse);
+      for (int r = k + 1; r < n; ++r) {
+        const Vec<T> factor = e(r, k) * inverse;
+        for (int j = k + 1; j < n; ++j) e(r, j) -= factor * e(k, j);
+      }
+    }
+  }
+  for (int l = 0; l < kPack; ++l) determinant[l] = result[l];
+}
+
+// Обратные группы n x n методом Гаусса — Жордана: a приводится к
+// единичной, те же действия над единичной b дают обратную. Вырожденность
+// проверяется только у первых lanes матриц, остальные — заполнители.
+template <typename T>
+S21_BATCH_INLINE void InverseGroup(int n, int lanes, Vec<T> *a, Vec<T> *b) {
+  constexpr int kPack = S21BasicMatrixBatch<T>::kPack;
+  std::memset(static_cast<void *>(b), 0, sizeof(Vec<T>) * n * n);
+  for (int i = 0; i < n; ++i)
+    for (int l = 0; l < kPack; ++l) b[i * n + i][l] = 1;
+  for (int k = 0; k < n; ++k) {
+    PivotGroup<T>(n, k, a, b, nullptr);  //знак перестановки не нужен
+    for (int l = 0; l < lanes && l < kPack; ++l)
+      if (a[k * n + k][l] == 0)
+        throw std::logic_error("The determinant is zero");
+    Vec<T> inverse;
+    InvertPivot<T>(a[k * n + k], inverse);
+    for (int j = k + 1; j < n; ++j) a[k * n + j] *= inverse;
+    for (int j = 0; j < n; ++j) b[k * n + j] *= inverse;
+    for (int r = 0; r < n; ++r) {
+      if (r == k) continue;
+      const Vec<T> factor = a[r * n + k];
+      for (int j = k + 1; j < n; ++j) a[r * n + j] -= factor * a[k * n + j];
+      for (int j = 0; j < n; ++j) b[r * n + j] -= factor * b[k * n + j];
+    }
+  }
+}
+
+// Операции над одной группой для ForEachGroup.
+template <typename T>
+struct MultiplyGroups {
+  typedef T Scalar;
+  int m, n, k;
+  const T *a, *b;
+  T *c;
+
+  std::size_t Scratch() const { return 0; }
+  S21_BATCH_INLINE void operator()(int group, Vec<T> *) const {
+    constexpr std::size_t kPack = S21BasicMatrixBatch<T>::kPack;
+    MultiplyGroup(m, n, k, a + group * kPack * m * k,
+                  b + group * kPack * k * n, c + group * kPack * m * n);
+  }
+};
+
+template <typename T>
+struct DeterminantGroups {
+  typedef T Scalar;
+  int n, count;
+  const T *a;
+  T *result;
+
+  std::size_t Scratch() const { return static_cast<std::size_t>(n) * n; }
+  S21_BATCH_INLINE void operator()(int group, Vec<T> *scratch) const {
+    constexpr int kPack = S21BasicMatrixBatch<T>::kPack;
+    std::memcpy(scratch, Elements(a) + Scratch() * group,
+                Scratch() * sizeof(Vec<T>));
+    T determinant[kPack];
+    DeterminantGroup<T>(n, scratch, determinant);
+    for (int l = 0; l < kPack && group * kPack + l < count; ++l)
+      result[group * kPack + l] = determinant[l];
+  }
+};
+
+template <typename T>
+struct InverseGroups {
+  typedef T Scalar;
+  int n, count;
+  const T *a;
+  T *result;
+
+  std::size_t Scratch() const { return static_cast<std::size_t>(n) * n; }
+  S21_BATCH_INLINE void operator()(int group, Vec<T> *scratch) const {
+    constexpr int kPack = S21BasicMatrixBatch<T>::kPack;
+    std::memcpy(scratch, Elements(a) + Scratch() * group,
+                Scratch() * sizeof(Vec<T>));
+    InverseGroup<T>(n, count - group * kPack, scratch,
+                 Elements(result) + Scratch() * group);
+  }
+};
+
+// Буфер куска на Scratch() элементов группы, выровненный как группы
+// пакета: std::vector не выравнивает векторные типы больше 16 байт.
+template <typename Operation>
+class ScratchBuffer {
+ public:
+  typedef Vec<typename Operation::Scalar> Element;
+
+  explicit ScratchBuffer(std::size_t count)
+      : data_(count == 0 ? nullptr
+                         : static_cast<Element *>(::operator new(
+                               count * sizeof(Element),
+                               std::align_val_t(kGroupAlignment)))) {}
+  ~ScratchBuffer() {
+    if (data_ != nullptr)
+      ::operator delete(data_, std::align_val_t(kGroupAlignment));
+  }
+  ScratchBuffer(const ScratchBuffer &) = delete;
+  ScratchBuffer &operator=(const ScratchBuffer &) = delete;
+
+  Element *data() const { return data_; }
+
+ private:
+  Element *data_;
+};
+
+template <typename Operation>
+void RunGroups(const Operation &operation, int first, int last) {
+  ScratchBuffer<Operation> scratch(operation.Scratch());
+  for (int group = first; group < last; ++group)
+    operation(group, scratch.data());
+}
+
+#ifdef S21_BATCH_X86_DISPATCH
+template <typename Operation>
+__attribute__((target("avx2,fma"))) void RunGroupsAvx2(
+    const Operation &operation, int first, int last) {
+  ScratchBuffer<Operation> scratch(operation.Scratch());
+  for (int group = first; group < last; ++group)
+    operation(group, scratch.data());
+}
+
+template <typename Operation>
+__attribute__((target("avx512f"))) void RunGroupsAvx512(
+    const Operation &operation, int first, int last) {
+  ScratchBuffer<Operation> scratch(operation.Scratch());
+  for (int group = first; group < last; ++group)
+    operation(group, scratch.data());
+}
+#endif
+
+// Выполняет операцию над группами в потоках ядром под возможности
+// процессора; group_work — число операций на одну группу.
+template <typename Operation>
+void ForEachGroup(int groups, long group_work, const Operation &operation) {
+  [[maybe_unused]] const s21::SimdLevel level = s21::GetSimdLevel();
+  const int grain =
+      static_cast<int>(s21::kParallelGrain / (group_work + 1) + 1);
+  s21::ParallelFor(0, groups, grain, [&](int first, int last) {
+#ifdef S21_BATCH_X86_DISPATCH
+    if (level >= s21::SimdLevel::kAvx512)
+      return RunGroupsAvx512(operation, first, last);
+    if (level >= s21::SimdLevel::kAvx2)
+      return RunGroupsAvx2(operation, first, last);
+#endif
+    RunGroups(operation, first, last);
+  });
+}
+
+}  // namespace
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch()
+    : count_(0), rows_(0), cols_(0), data_(nullptr) {}
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int count, int rows, int cols)
+    : S21BasicMatrixBatch(count, rows, cols, true) {}
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int count, int rows, int cols,
+                                            bool zero)
+    : count_(count), rows_(rows), cols_(cols), data_(nullptr) {
+  if (count_ <= 0 || rows_ <= 0 || cols_ <= 0)
+    throw std::invalid_argument(
+        "Count, rows and columns can't be non-positive");
+  const std::size_t bytes = GroupSize() * Groups() * sizeof(T);
+  data_ = static_cast<T *>(s21::AllocateMatrixBuffer(bytes));
+  if (!zero) return;
+  std::memset(data_, 0, bytes);
+  ResetPadding();
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(const S21BasicMatrixBatch &other)
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(nullptr) {
+  if (other.data_ == nullptr) return;
+  const std::size_t bytes = GroupSize() * Groups() * sizeof(T);
+  data_ = static_cast<T *>(s21::AllocateMatrixBuffer(bytes));
+  std::memcpy(data_, other.data_, bytes);
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(
+    S21BasicMatrixBatch &&other) noexcept
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(other.data_) {
+  other.count_ = 0;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.data_ = nullptr;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T>::~S21BasicMatrixBatch() noexcept {
+  if (data_ != nullptr) s21::FreeMatrixBuffer(data_);
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::ResetPadding() {
+  const int used = count_ % kPack;
+  if (used == 0) return;
+  T *last = Group(Groups() - 1);
+  for (int e = 0; e < rows_ * cols_; ++e) {
+    const T value = rows_ == cols_ && e / cols_ == e % cols_ ? 1 : 0;
+    for (int l = used; l < kPack; ++l) last[e * kPack + l] = value;
+  }
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::CheckSquare() const {
+  if (rows_ != cols_) throw std::logic_error("The matrix isn't square");
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixBatch<T>::Get(int index) const {
+  if (index < 0 || index >= count_)
+    throw std::out_of_range("Index is out of range");
+  S21BasicMatrix<T> matrix(rows_, cols_);
+  for (int i = 0; i < rows_; ++i)
+    for (int j = 0; j < cols_; ++j) matrix[i][j] = At(index, i, j);
+  return matrix;
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::Set(int index, const S21BasicMatrix<T> &matrix) {
+  if (index < 0 || index >= count_)
+    throw std::out_of_range("Index is out of range");
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_)
+    throw std::logic_error("Matrix sizes are different");
+  for (int i = 0; i < rows_; ++i)
+    for (int j = 0; j < cols_; ++j) At(index, i, j) = matrix[i][j];
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::MulMatrix(const S21BasicMatrixBatch &other) {
+  *this = *this * other;
+}
+
+// Транспонирование переставляет элементы целиком: kPack значений подряд.
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::Transpose() const {
+  S21BasicMatrixBatch result(count_, cols_, rows_, false);
+  const long group_work = static_cast<long>(rows_) * cols_ * kPack;
+  s21::ParallelFor(0, Groups(), s21::kParallelGrain / group_work + 1,
+                   [&](int first, int last) {
+                     for (int group = first; group < last; ++group) {
+                       const T *src = Group(group);
+                       T *dst = result.Group(group);
+                       for (int i = 0; i < rows_; ++i)
+                         for (int j = 0; j < cols_; ++j)
+                           std::memcpy(dst + (j * rows_ + i) * kPack,
+                                       src + (i * cols_ + j) * kPack,
+                                       kPack * sizeof(T));
+                     }
+                   });
+  return result;
+}
+
+template <typename T>
+std::vector<T> S21BasicMatrixBatch<T>::Determinant() const {
+  CheckSquare();
+  std::vector<T> result(count_);
+  const long n = rows_;
+  ForEachGroup(Groups(), n * n * n * kPack,
+               DeterminantGroups<T>{rows_, count_, data_, result.data()});
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::InverseMatrix() const {
+  CheckSquare();
+  S21BasicMatrixBatch result(count_, rows_, cols_, false);
+  const long n = rows_;
+  ForEachGroup(Groups(), 2 * n * n * n * kPack,
+               InverseGroups<T>{rows_, count_, data_, result.data_});
+  return result;
+}
+
+template <typename T>
+T &S21BasicMatrixBatch<T>::operator()(int index, int row_index,
+                                      int col_index) const {
+  if (index < 0 || row_index < 0 || col_index < 0 || index >= count_ ||
+      row_index >= rows_ || col_index >= cols_)
+    throw std::out_of_range("Index is out of range");
+  return At(index, row_index, col_index);
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> &S21BasicMatrixBatch<T>::operator=(
+    const S21BasicMatrixBatch &other) {
+  if (this != &other) *this = S21BasicMatrixBatch(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> &S21BasicMatrixBatch<T>::operator=(
+    S21BasicMatrixBatch &&other) noexcept {
+  std::swap(count_, other.count_);
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(data_, other.data_);
+  return *this;
+}
+
+// Заполнители произведения пересчитываются: у 3x2 * 2x3 они нулевые.
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::operator*(
+    const S21BasicMatrixBatch &other) const {
+  if (count_ != other.count_)
+    throw std::logic_error("Batch sizes are different");
+  if (cols_ != other.rows_)
+    throw std::logic_error(
+        "The columns number of the first matrix is ​​not equal to the "
+        "rows number of the second matrix");
+  S21BasicMatrixBatch result(count_, rows_, other.cols_, false);
+  const long work = static_cast<long>(rows_) * cols_ * other.cols_ * kPack;
+  ForEachGroup(Groups(), work,
+               MultiplyGroups<T>{rows_, other.cols_, cols_, data_,
+                                 other.data_, result.data_});
+  result.ResetPadding();
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> &S21BasicMatrixBatch<T>::operator*=(
+    const S21BasicMatrixBatch &other) {
+  MulMatrix(other);
+  return *this;
+}
+
+template class S21BasicMatrixBatch<float>;
+template class S21BasicMatrixBatch<double>;
+template class S21BasicMatrixBatch<long double>;
@@ -0,0 +1,79 @@
+#ifndef S21_MATRIX_BATCH
+#define S21_MATRIX_BATCH
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Пакет из count независимых матриц одного размера rows x cols, например
+// миллиона матриц 4x4. Матрицы хранятся группами по kPack: внутри группы
+// элемент (i, j) всех kPack матриц лежит подряд (SoA), так что одна
+// операция над элементом сразу выполняется векторным регистром для
+// нескольких матриц, и регистры заполнены целиком при любом размере матриц.
+// Группы делятся между потоками.
+//
+// Последняя группа дополняется матрицами-заполнителями: у квадратных это
+// единичные матрицы, чтобы обращение и определитель по ним были
+// безопасны. Get и Set копируют одну матрицу из пакета и в пакет.
+template <typename T>
+class S21BasicMatrixBatch {
+ public:
+  typedef T Scalar;
+  // Матриц в группе: один элемент всей группы занимает 64 байта.
+  static constexpr int kPack = 64 / sizeof(T);
+
+ private:
+  int count_, rows_, cols_;
+  T *data_;  //группы подряд, в группе элементы по строкам, в них матрицы
+
+  int Groups() const { return (count_ + kPack - 1) / kPack; }
+  std::size_t GroupSize() const {
+    return static_cast<std::size_t>(rows_) * cols_ * kPack;
+  }
+  T *Group(int group) const { return data_ + GroupSize() * group; }
+  T &At(int index, int row, int col) const {
+    return Group(index / kPack)[(row * cols_ + col) * kPack + index % kPack];
+  }
+  S21BasicMatrixBatch(int count, int rows, int cols,
+                      bool zero);  //без обнуления для результатов
+  void ResetPadding();  //заполнители — единичные матрицы
+  void CheckSquare() const;
+
+ public:
+  S21BasicMatrixBatch();  //пустой пакет
+  S21BasicMatrixBatch(int count, int rows, int cols);  //нулевые матрицы
+  S21BasicMatrixBatch(const S21BasicMatrixBatch &other);
+  S21BasicMatrixBatch(S21BasicMatrixBatch &&other) noexcept;
+  ~S21BasicMatrixBatch() noexcept;
+
+  int GetCount() const { return count_; }
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  T *GetData() const { return data_; }
+
+  S21BasicMatrix<T> Get(int index) const;  //копия матрицы index
+  void Set(int index, const S21BasicMatrix<T> &matrix);
+
+  void MulMatrix(const S21BasicMatrixBatch &other);  //попарно
+  S21BasicMatrixBatch Transpose() const;
+  std::vector<T> Determinant() const;      //по одному на матрицу
+  S21BasicMatrixBatch InverseMatrix() const;  //ошибка, если есть вырожденная
+
+  T &operator()(int index, int row_index, int col_index) const;
+  S21BasicMatrixBatch &operator=(const S21BasicMatrixBatch &other);
+  S21BasicMatrixBatch &operator=(S21BasicMatrixBatch &&other) noexcept;
+  S21BasicMatrixBatch operator*(const S21BasicMatrixBatch &other) const;
+  S21BasicMatrixBatch &operator*=(const S21BasicMatrixBatch &other);
+};
+
+typedef S21BasicMatrixBatch<double> S21MatrixBatch;
+typedef S21BasicMatrixBatch<float> S21MatrixBatchF;
+typedef S21BasicMatrixBatch<long double> S21MatrixBatchLD;
+
+extern template class S21BasicMatrixBatch<float>;
+extern template class S21BasicMatrixBatch<double>;
+extern template class S21BasicMatrixBatch<long double>;
+
+#endif
@@ -0,0 +1,126 @@
+#include "s21_matrix_chain.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include "s21_profile.h"
+
+template <typename T>
+S21BasicMatrixChain<T>::S21BasicMatrixChain() : left_to_right_flops_(0) {}
+
+template <typename T>
+S21BasicMatrixChain<T> &S21BasicMatrixChain<T>::Add(const Matrix &matrix) {
+  if (matrix.GetData() == nullptr)
+    throw std::logic_error("Chain factor can't be empty");
+  if (!operands_.empty() && operands_.back()->GetCols() != matrix.GetRows())
+    throw std::logic_error(
+        "The columns number of the first matrix is not equal to the rows "
+        "number of the second matrix");
+  operands_.push_back(&matrix);
+  // Новый столбец таблицы: Ai..Aj для всех i, от коротких цепочек к
+  // длинным, так что Ai..Ak и Ak+1..Aj уже посчитаны.
+  const int j = static_cast<int>(operands_.size()) - 1;
+  const double rows = operands_[0]->GetRows(), cols = matrix.GetCols();
+  cost_.emplace_back(j + 1, 0.0);
+  split_.emplace_back(j + 1, j);
+  for (int i = j - 1; i >= 0; --i) {
+    double best = std::numeric_limits<double>::infinity();
+    const double outer = 2.0 * operands_[i]->GetRows() * cols;
+    for (int k = i; k < j; ++k) {
+      double cost =
+          cost_[k][i] + cost_[j][k + 1] + outer * operands_[k]->GetCols();
+      if (cost <= best) {  //при равенстве — порядок operator*
+        best = cost;
+        split_[j][i] = k;
+      }
+    }
+    cost_[j][i] = best;
+  }
+  if (j > 0) left_to_right_flops_ += 2.0 * rows * matrix.GetRows() * cols;
+  return *this;
+}
+
+template <typename T>
+void S21BasicMatrixChain<T>::Clear() {
+  operands_.clear();
+  cost_.clear();
+  split_.clear();
+  left_to_right_flops_ = 0;
+}
+
+template <typename T>
+int S21BasicMatrixChain<T>::GetSize() const {
+  return static_cast<int>(operands_.size());
+}
+
+template <typename T>
+double S21BasicMatrixChain<T>::GetFlops() const {
+  return operands_.empty() ? 0 : cost_.back()[0];
+}
+
+template <typename T>
+double S21BasicMatrixChain<T>::GetLeftToRightFlops() const {
+  return left_to_right_flops_;
+}
+
+template <typename T>
+std::string S21BasicMatrixChain<T>::GetOrder() const {
+  return operands_.empty() ? std::string() : Order(0, GetSize() - 1);
+}
+
+template <typename T>
+std::string S21BasicMatrixChain<T>::Order(int first, int last) const {
+  if (first == last) return "A" + std::to_string(first);
+  const int k = split_[last][first];
+  return "(" + Order(first, k) + " " + Order(k + 1, last) + ")";
+}
+
+// out = Afirst * ... * Alast. Множители-операнды не копируются.
+// Промежуточные живут стеком: левое держится, пока считается правое, и
+// level — число живых к началу вызова, оно же номер буфера для левого.
+template <typename T>
+void S21BasicMatrixChain<T>::Evaluate(int first, int last, Matrix &out,
+                                      std::size_t level) {
+  const int k = split_[last][first];
+  const Matrix *factors[2] = {operands_[first], operands_[k + 1]};
+  const int bounds[2][2] = {{first, k}, {k + 1, last}};
+  for (int side = 0; side < 2; ++side) {
+    const int from = bounds[side][0], to = bounds[side][1];
+    if (from == to) continue;
+    const int rows = operands_[from]->GetRows();
+    const int cols = operands_[to]->GetCols();
+    Matrix &buffer = buffers_[level];
+    if (buffer.GetData() == nullptr)
+      buffer = Matrix(rows, cols);
+    else
+      buffer.Reserve(rows, cols);
+    Evaluate(from, to, buffer, level + 1);
+    factors[side] = &buffer;
+    ++level;
+  }
+  s21::Multiply(*factors[0], *factors[1], out);
+}
+
+template <typename T>
+void S21BasicMatrixChain<T>::Multiply(Matrix &out) {
+  if (operands_.empty()) throw std::logic_error("Chain has no matrices");
+  if (operands_.size() == 1) {
+    out = *operands_[0];
+    return;
+  }
+  S21_PROFILE_OPERATION(s21::Operation::kMulMatrix, GetFlops());
+  //ссылки на буферы не должны сдвигаться во время умножения
+  if (buffers_.size() < operands_.size()) buffers_.resize(operands_.size());
+  Evaluate(0, GetSize() - 1, out, 0);
+}
+
+template <typename T>
+typename S21BasicMatrixChain<T>::Matrix S21BasicMatrixChain<T>::Multiply() {
+  Matrix result;
+  Multiply(result);
+  return result;
+}
+
+template class S21BasicMatrixChain<float>;
+template class S21BasicMatrixChain<double>;
+template class S21BasicMatrixChain<long double>;
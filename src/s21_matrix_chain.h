@@ -0,0 +1,84 @@
+#ifndef S21_MATRIX_CHAIN
+#define S21_MATRIX_CHAIN
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Произведение цепочки матриц A0 * A1 * ... * An-1 в самом дешёвом
+// порядке. operator* считает слева направо, и при разных формах
+// операндов это может стоить на порядки больше операций: у 1000x5,
+// 5x1000 и 1000x1 порядок (A0 A1) A2 требует 12 Мфлоп, а A0 (A1 A2) —
+// 0.02 Мфлоп. Порядок выбирается динамическим программированием по
+// оценке 2 * m * k * n операций на произведение; таблица дополняется при
+// каждом Add за O(n^2). При равной оценке остаётся порядок operator*, и
+// результат совпадает с ним до бита.
+//
+// Цепочка хранит ссылки на операнды, а не копии: матрицы должны жить,
+// пока цепочка умножается. Промежуточные произведения записываются в
+// буферы, которые цепочка оставляет себе: по одному на каждое
+// одновременно живущее промежуточное, каждый растёт до наибольших строк
+// и столбцов того, что в нём считалось. Повторное умножение цепочки тех
+// же форм не выделяет памяти.
+template <typename T>
+class S21BasicMatrixChain {
+ public:
+  typedef S21BasicMatrix<T> Matrix;
+
+ private:
+  std::vector<const Matrix *> operands_;
+  std::vector<std::vector<double>> cost_;  //cost_[j][i] — Ai..Aj
+  std::vector<std::vector<int>> split_;    //split_[j][i] — последний в левой
+  double left_to_right_flops_;
+  std::vector<Matrix> buffers_;  //промежуточные по глубине стека
+
+  void Evaluate(int first, int last, Matrix &out, std::size_t level);
+  std::string Order(int first, int last) const;
+
+ public:
+  S21BasicMatrixChain();
+
+  // Добавляет множитель справа; число его строк должно совпадать с
+  // числом столбцов предыдущего, иначе std::logic_error.
+  S21BasicMatrixChain &Add(const Matrix &matrix);
+  void Clear();  //убирает операнды, буферы остаются
+
+  int GetSize() const;                //число множителей
+  double GetFlops() const;            //оценка для выбранного порядка
+  double GetLeftToRightFlops() const;  //оценка для порядка operator*
+  std::string GetOrder() const;       //"(A0 (A1 A2))"
+
+  // Пустая цепочка — std::logic_error. Если out — один из операндов,
+  // последнее произведение считается во временную матрицу.
+  void Multiply(Matrix &out);
+  Matrix Multiply();
+};
+
+typedef S21BasicMatrixChain<double> S21MatrixChain;
+typedef S21BasicMatrixChain<float> S21MatrixChainF;
+typedef S21BasicMatrixChain<long double> S21MatrixChainLD;
+
+extern template class S21BasicMatrixChain<float>;
+extern template class S21BasicMatrixChain<double>;
+extern template class S21BasicMatrixChain<long double>;
+
+namespace s21 {
+
+// MultiplyChain(a, b, c, d) — a * b * c * d в самом дешёвом порядке.
+template <typename T, typename... Matrices>
+S21BasicMatrix<T> MultiplyChain(const S21BasicMatrix<T> &first,
+                                const Matrices &...rest) {
+  static_assert((std::is_same<Matrices, S21BasicMatrix<T>>::value && ...),
+                "All factors must be matrices of the same type");
+  S21BasicMatrixChain<T> chain;
+  chain.Add(first);
+  (chain.Add(rest), ...);
+  return chain.Multiply();
+}
+
+}  // namespace s21
+
+#endif
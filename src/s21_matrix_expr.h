@@ -0,0 +1,358 @@
+#ifndef S21_MATRIX_EXPR
+#define S21_MATRIX_EXPR
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_kernels.h"
+#include "s21_matrix_oop.h"
+#include "s21_parallel.h"
+
+// Ленивые выражения для операторов +, - и умножения на число.
+// Узлы хранят только указатели на исходные матрицы, поэтому A + B - C * 2.0
+// не создаёт промежуточных матриц: результат считается построчно при
+// присваивании или конструировании S21Matrix, каждая исходная строка
+// читается из памяти один раз. Выражение нельзя сохранять дольше полного
+// выражения, в котором живут его операнды (как и в auto e = f() + a).
+//
+// Каждый узел знает тип элементов Scalar и умеет:
+//   AssignRow(i, dst, kernels)         dst = строка i выражения
+//   AddRow(i, dst, factor, kernels)    dst += factor * строка i выражения
+//   Aliases(target)                    читает ли выражение память target
+//
+// Методы S21Matrix, которые вызывали на результате a + b до ленивых
+// операторов, есть и у выражения: (a + b).Transpose(), (a * 2.0)(0, 0).
+// Каждый такой вызов сначала вычисляет выражение во временную матрицу;
+// operator() поэтому возвращает значение, а не ссылку на элемент.
+template <typename Derived>
+class S21MatrixExpression {
+ public:
+  const Derived &Self() const { return static_cast<const Derived &>(*this); }
+
+  auto Evaluate() const {
+    return S21BasicMatrix<typename Derived::Scalar>(*this);
+  }
+  template <typename... Args>
+  bool EqMatrix(const Args &...args) const {
+    return Evaluate().EqMatrix(args...);
+  }
+  auto Transpose() const { return Evaluate().Transpose(); }
+  auto CalcComplements() const { return Evaluate().CalcComplements(); }
+  auto Determinant() const { return Evaluate().Determinant(); }
+  auto InverseMatrix() const { return Evaluate().InverseMatrix(); }
+  auto Minor(int skip_row, int skip_colm) const {
+    return Evaluate().Minor(skip_row, skip_colm);
+  }
+  auto operator()(int row_index, int col_index) const {
+    return Evaluate()(row_index, col_index);
+  }
+};
+
+namespace s21 {
+namespace expression {
+
+// Как выражение читает память, в которую пишется результат: не читает,
+// читает ровно те строки, что пишутся, или перекрывается с ней иначе.
+enum class Alias { kNone, kSameRows, kOverlap };
+
+}  // namespace expression
+}  // namespace s21
+
+// Лист выражения — S21BasicMatrixView, матрица в выражении заменяется
+// видом на неё целиком.
+#include "s21_matrix_view.h"
+
+// Сумма (kSign = 1) или разность (kSign = -1) двух выражений.
+template <typename Lhs, typename Rhs, int kSign>
+class S21MatrixSum
+    : public S21MatrixExpression<S21MatrixSum<Lhs, Rhs, kSign>> {
+ public:
+  typedef typename Lhs::Scalar Scalar;
+  typedef s21::BasicElementwiseKernels<Scalar> Kernels;
+
+ private:
+  static_assert(std::is_same<Scalar, typename Rhs::Scalar>::value,
+                "Matrices of different precision need an explicit conversion");
+  Lhs lhs_;
+  Rhs rhs_;
+
+ public:
+  S21MatrixSum(const Lhs &lhs, const Rhs &rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.GetRows() != rhs.GetRows() || lhs.GetCols() != rhs.GetCols())
+      throw std::logic_error("Matrix sizes are different");
+  }
+
+  int GetRows() const { return lhs_.GetRows(); }
+  int GetCols() const { return lhs_.GetCols(); }
+  s21::expression::Alias Aliases(
+      const S21BasicMatrixView<Scalar> &target) const {
+    return std::max(lhs_.Aliases(target), rhs_.Aliases(target));
+  }
+
+  void AssignRow(int i, Scalar *dst, const Kernels &kernels) const {
+    lhs_.AssignRow(i, dst, kernels);
+    rhs_.AddRow(i, dst, kSign, kernels);
+  }
+
+  void AddRow(int i, Scalar *dst, Scalar factor,
+              const Kernels &kernels) const {
+    lhs_.AddRow(i, dst, factor, kernels);
+    rhs_.AddRow(i, dst, kSign * factor, kernels);
+  }
+};
+
+// Выражение, умноженное на число.
+template <typename Operand>
+class S21MatrixScaled : public S21MatrixExpression<S21MatrixScaled<Operand>> {
+ public:
+  typedef typename Operand::Scalar Scalar;
+  typedef s21::BasicElementwiseKernels<Scalar> Kernels;
+
+ private:
+  Operand operand_;
+  Scalar factor_;
+
+ public:
+  S21MatrixScaled(const Operand &operand, Scalar factor)
+      : operand_(operand), factor_(factor) {}
+
+  int GetRows() const { return operand_.GetRows(); }
+  int GetCols() const { return operand_.GetCols(); }
+  s21::expression::Alias Aliases(
+      const S21BasicMatrixView<Scalar> &target) const {
+    return operand_.Aliases(target);
+  }
+
+  void AssignRow(int i, Scalar *dst, const Kernels &kernels) const {
+    operand_.AssignRow(i, dst, kernels);
+    kernels.scale(dst, factor_, GetCols());
+  }
+
+  void AddRow(int i, Scalar *dst, Scalar factor,
+              const Kernels &kernels) const {
+    operand_.AddRow(i, dst, factor * factor_, kernels);
+  }
+};
+
+namespace s21 {
+namespace expression {
+
+// Операнд выражения: S21Matrix превращается в вид, узлы берутся как есть.
+template <typename T>
+struct Operand {
+  static constexpr bool kIsOperand =
+      std::is_base_of<S21MatrixExpression<T>, T>::value;
+  typedef T Type;
+  static const T &Wrap(const T &value) { return value; }
+};
+
+template <typename T>
+struct Operand<S21BasicMatrix<T>> {
+  static constexpr bool kIsOperand = true;
+  typedef S21BasicMatrixView<T> Type;
+  static S21BasicMatrixView<T> Wrap(const S21BasicMatrix<T> &value) {
+    return S21BasicMatrixView<T>(value);
+  }
+};
+
+template <typename T>
+using ScalarOf = typename Operand<T>::Type::Scalar;
+
+// Операнды разной точности не складываются: перегрузка просто не
+// подходит, и нужно явное преобразование одной из матриц.
+template <typename Lhs, typename Rhs>
+using EnableIfOperands =
+    std::enable_if_t<Operand<Lhs>::kIsOperand && Operand<Rhs>::kIsOperand &&
+                     std::is_same<ScalarOf<Lhs>, ScalarOf<Rhs>>::value>;
+
+template <typename T>
+using EnableIfOperand = std::enable_if_t<Operand<T>::kIsOperand>;
+
+// Матрица для сравнения: сама матрица или вычисленное выражение.
+template <typename T>
+const S21BasicMatrix<T> &Evaluate(const S21BasicMatrix<T> &matrix) {
+  return matrix;
+}
+
+template <typename Expression>
+auto Evaluate(const S21MatrixExpression<Expression> &expression) {
+  return expression.Evaluate();
+}
+}  // namespace expression
+}  // namespace s21
+
+template <typename Lhs, typename Rhs,
+          typename = s21::expression::EnableIfOperands<Lhs, Rhs>>
+S21MatrixSum<typename s21::expression::Operand<Lhs>::Type,
+             typename s21::expression::Operand<Rhs>::Type, 1>
+operator+(const Lhs &lhs, const Rhs &rhs) {
+  return {s21::expression::Operand<Lhs>::Wrap(lhs),
+          s21::expression::Operand<Rhs>::Wrap(rhs)};
+}
+
+template <typename Lhs, typename Rhs,
+          typename = s21::expression::EnableIfOperands<Lhs, Rhs>>
+S21MatrixSum<typename s21::expression::Operand<Lhs>::Type,
+             typename s21::expression::Operand<Rhs>::Type, -1>
+operator-(const Lhs &lhs, const Rhs &rhs) {
+  return {s21::expression::Operand<Lhs>::Wrap(lhs),
+          s21::expression::Operand<Rhs>::Wrap(rhs)};
+}
+
+// Число приводится к типу элементов выражения.
+template <typename T, typename = s21::expression::EnableIfOperand<T>>
+S21MatrixScaled<typename s21::expression::Operand<T>::Type> operator*(
+    const T &operand, const s21::expression::ScalarOf<T> num) {
+  return {s21::expression::Operand<T>::Wrap(operand), num};
+}
+
+template <typename T, typename = s21::expression::EnableIfOperand<T>>
+S21MatrixScaled<typename s21::expression::Operand<T>::Type> operator*(
+    const s21::expression::ScalarOf<T> num, const T &operand) {
+  return {s21::expression::Operand<T>::Wrap(operand), num};
+}
+
+// Временная матрица в операнде отдаёт свой буфер результату:
+// std::move(a) + b, f() - b и std::move(a) * 2.0 считаются в памяти a и
+// f() без выделения и возвращают матрицу, а не ленивое выражение.
+template <typename T, typename Rhs,
+          typename = s21::expression::EnableIfOperands<S21BasicMatrix<T>, Rhs>>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&lhs, const Rhs &rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <typename Lhs, typename T,
+          typename = s21::expression::EnableIfOperands<Lhs, S21BasicMatrix<T>>>
+S21BasicMatrix<T> operator+(const Lhs &lhs, S21BasicMatrix<T> &&rhs) {
+  rhs += lhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T> &&lhs,
+                            S21BasicMatrix<T> &&rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename Rhs,
+          typename = s21::expression::EnableIfOperands<S21BasicMatrix<T>, Rhs>>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&lhs, const Rhs &rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+// lhs - rhs = -rhs + lhs; если lhs читает rhs, знак нельзя менять заранее.
+template <typename Lhs, typename T,
+          typename = s21::expression::EnableIfOperands<Lhs, S21BasicMatrix<T>>>
+S21BasicMatrix<T> operator-(const Lhs &lhs, S21BasicMatrix<T> &&rhs) {
+  if (s21::expression::Operand<Lhs>::Wrap(lhs).Aliases(rhs) !=
+      s21::expression::Alias::kNone) {
+    rhs = lhs - rhs;
+  } else {
+    rhs.MulNumber(T(-1));
+    rhs += lhs;
+  }
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T> &&lhs,
+                            S21BasicMatrix<T> &&rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(S21BasicMatrix<T> &&matrix,
+                            const typename S21BasicMatrix<T>::Scalar num) {
+  matrix.MulNumber(num);
+  return std::move(matrix);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const typename S21BasicMatrix<T>::Scalar num,
+                            S21BasicMatrix<T> &&matrix) {
+  matrix.MulNumber(num);
+  return std::move(matrix);
+}
+
+// Матричное произведение не поэлементное: выражения-множители
+// вычисляются.
+template <typename Expression, typename T>
+S21BasicMatrix<T> operator*(const S21MatrixExpression<Expression> &lhs,
+                            const S21BasicMatrix<T> &rhs) {
+  return S21BasicMatrix<T>(lhs) * rhs;
+}
+
+template <typename Lhs, typename Rhs>
+auto operator*(const S21MatrixExpression<Lhs> &lhs,
+               const S21MatrixExpression<Rhs> &rhs) {
+  return lhs.Evaluate() * rhs.Evaluate();
+}
+
+// Сравнение с выражением с любой стороны: (a + b) == c, как и
+// c == (a + b). Матрица с матрицей и виды сравниваются своими
+// перегрузками, они точнее этого шаблона.
+template <typename Lhs, typename Rhs,
+          typename = s21::expression::EnableIfOperands<Lhs, Rhs>>
+bool operator==(const Lhs &lhs, const Rhs &rhs) {
+  return s21::expression::Evaluate(lhs).EqMatrix(
+      s21::expression::Evaluate(rhs));
+}
+
+template <typename Lhs, typename Rhs,
+          typename = s21::expression::EnableIfOperands<Lhs, Rhs>>
+bool operator!=(const Lhs &lhs, const Rhs &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T>
+template <typename Expression, typename>
+S21BasicMatrix<T>::S21BasicMatrix(
+    const S21MatrixExpression<Expression> &expression)
+    : rows_(0), cols_(0), stride_(0), data_(nullptr), rows_table_(nullptr) {
+  const Expression &self = expression.Self();
+  if (self.GetRows() == 0 || self.GetCols() == 0) return;
+  rows_ = self.GetRows();
+  cols_ = self.GetCols();
+  stride_ = StrideFor(cols_);
+  data_ = AllocateBuffer(static_cast<std::size_t>(rows_) * stride_,
+                         stride_ != cols_);
+  S21BasicMatrixView<T>(*this).AssignRows(self);
+}
+
+template <typename T>
+template <typename Expression>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(
+    const S21MatrixExpression<Expression> &expression) {
+  const Expression &self = expression.Self();
+  if (self.GetRows() != rows_ || self.GetCols() != cols_ || IsMapped()) {
+    S21BasicMatrix result(expression);
+    Swap(result);
+  } else {
+    S21BasicMatrixView<T>(*this).AssignRows(self);
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename Expression>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(
+    const S21MatrixExpression<Expression> &expression) {
+  S21BasicMatrixView<T>(*this).AddRows(expression.Self(), T(1));
+  return *this;
+}
+
+template <typename T>
+template <typename Expression>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(
+    const S21MatrixExpression<Expression> &expression) {
+  S21BasicMatrixView<T>(*this).AddRows(expression.Self(), T(-1));
+  return *this;
+}
+
+#endif
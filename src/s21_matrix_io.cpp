@@ -0,0 +1,325 @@
+#include "s21_matrix_io.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "s21_allocator.h"
+
+namespace s21 {
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+// Строки и данные выровнены как буфер матрицы; данные начинаются с новой
+// страницы, так что при отображении только для чтения страница заголовка
+// — единственная, куда можно писать. Страница — не меньше 4 КиБ.
+constexpr std::uint32_t kRowAlignment = 64;
+constexpr std::uint64_t kMinPayloadOffset = 4096;
+
+std::uint64_t PayloadOffset() {
+  return std::max<std::uint64_t>(kMinPayloadOffset, sysconf(_SC_PAGESIZE));
+}
+
+template <typename T>
+ElementType ElementTypeOf();
+template <>
+ElementType ElementTypeOf<float>() {
+  return ElementType::kFloat;
+}
+template <>
+ElementType ElementTypeOf<double>() {
+  return ElementType::kDouble;
+}
+template <>
+ElementType ElementTypeOf<long double>() {
+  return ElementType::kLongDouble;
+}
+
+struct FileCloser {
+  void operator()(std::FILE *file) const { std::fclose(file); }
+};
+typedef std::unique_ptr<std::FILE, FileCloser> File;
+
+File Open(const std::string &path, const char *mode) {
+  File file(std::fopen(path.c_str(), mode));
+  if (!file) throw std::runtime_error("Can't open " + path);
+  return file;
+}
+
+// Дескриптор файла для отображения, закрывается при выходе из области.
+class Descriptor {
+ public:
+  explicit Descriptor(const std::string &path)
+      : fd_(open(path.c_str(), O_RDONLY)) {
+    if (fd_ < 0) throw std::runtime_error("Can't open " + path);
+  }
+  ~Descriptor() { close(fd_); }
+  Descriptor(const Descriptor &) = delete;
+  Descriptor &operator=(const Descriptor &) = delete;
+
+  int Get() const { return fd_; }
+
+ private:
+  int fd_;
+};
+
+template <typename U>
+void SwapBytes(U &value) {
+  unsigned char *bytes = reinterpret_cast<unsigned char *>(&value);
+  std::reverse(bytes, bytes + sizeof(U));
+}
+
+// Проверяет заголовок и переводит его поля в порядок байтов этой машины.
+// Возвращает true, если данные файла записаны в чужом порядке.
+bool CheckHeader(FileHeader &header, const std::string &path) {
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0)
+    throw std::runtime_error(path + " is not a matrix file");
+  const bool swapped = header.byte_order != kByteOrderMark;
+  if (swapped) {
+    SwapBytes(header.byte_order);
+    SwapBytes(header.version);
+    SwapBytes(header.element_type);
+    SwapBytes(header.element_size);
+    SwapBytes(header.alignment);
+    SwapBytes(header.rows);
+    SwapBytes(header.cols);
+    SwapBytes(header.stride);
+    SwapBytes(header.payload_offset);
+    if (header.byte_order != kByteOrderMark)
+      throw std::runtime_error(path + " has an unknown byte order");
+  }
+  if (header.version != kFileVersion)
+    throw std::runtime_error(path + " has an unsupported version");
+  if (header.element_type < ElementType::kFloat ||
+      header.element_type > ElementType::kLongDouble ||
+      header.element_size == 0 || header.element_size > 16)
+    throw std::runtime_error(path + " has an unknown element type");
+  //0 x 0 — пустая матрица, 0 x cols — матрица после Reserve без строк
+  const bool empty = header.rows == 0 && header.cols == 0;
+  if (!empty && (header.cols == 0 || header.rows > INT_MAX ||
+                 header.stride > INT_MAX || header.stride < header.cols))
+    throw std::runtime_error(path + " has invalid dimensions");
+  if (header.payload_offset < sizeof(FileHeader))
+    throw std::runtime_error(path + " has an invalid payload offset");
+  return swapped;
+}
+
+std::size_t PayloadBytes(const FileHeader &header) {
+  return static_cast<std::size_t>(header.rows) * header.stride *
+         header.element_size;
+}
+
+// Отображённый файл освобождается как буфер матрицы: Deallocate получает
+// начало заголовка буфера и размер от него до конца данных.
+class MappedFileAllocator : public MatrixAllocator {
+ public:
+  void *Allocate(std::size_t) override { throw std::bad_alloc(); }
+  void Deallocate(void *buffer, std::size_t bytes) noexcept override {
+    const std::uintptr_t page = sysconf(_SC_PAGESIZE);
+    char *block = static_cast<char *>(buffer);
+    char *base = reinterpret_cast<char *>(
+        reinterpret_cast<std::uintptr_t>(block) / page * page);
+    munmap(base, block + bytes - base);
+  }
+};
+
+MappedFileAllocator &GetMappedFileAllocator() {
+  static MappedFileAllocator allocator;
+  return allocator;
+}
+
+template <typename T>
+FileHeader MakeHeader(int rows, int cols, int stride) {
+  FileHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.byte_order = kByteOrderMark;
+  header.version = kFileVersion;
+  header.element_type = ElementTypeOf<T>();
+  header.element_size = sizeof(T);
+  header.alignment = kRowAlignment;
+  header.rows = rows;
+  header.cols = cols;
+  header.stride = stride;
+  header.payload_offset = PayloadOffset();
+  return header;
+}
+
+}  // namespace
+
+FileHeader ReadFileHeader(const std::string &path) {
+  File file = Open(path, "rb");
+  FileHeader header;
+  if (std::fread(&header, sizeof(header), 1, file.get()) != 1)
+    throw std::runtime_error(path + " is truncated");
+  CheckHeader(header, path);
+  return header;
+}
+
+template <typename T>
+void WriteMatrix(const std::string &path, const S21BasicMatrix<T> &matrix) {
+  const FileHeader header =
+      MakeHeader<T>(matrix.GetRows(), matrix.GetCols(), matrix.GetStride());
+  File file = Open(path, "wb");
+  static const char padding[kMinPayloadOffset] = {};
+  bool written = std::fwrite(&header, sizeof(header), 1, file.get()) == 1;
+  for (std::size_t rest = header.payload_offset - sizeof(header);
+       written && rest != 0;) {
+    const std::size_t part = std::min(rest, sizeof(padding));
+    written = std::fwrite(padding, part, 1, file.get()) == 1;
+    rest -= part;
+  }
+  const std::size_t count =
+      static_cast<std::size_t>(header.rows) * header.stride;
+  if (written && count != 0)
+    written = std::fwrite(matrix.GetData(), sizeof(T), count, file.get()) ==
+              count;
+  if (!written || std::fflush(file.get()) != 0)
+    throw std::runtime_error("Can't write " + path);
+}
+
+// Строки выровнены на kRowAlignment, как в буфере матрицы; данные
+// дописываются ftruncate, так что ещё не записанные страницы не занимают
+// места на диске.
+template <typename T>
+FileHeader CreateMatrixFile(const std::string &path, int rows, int cols) {
+  if (rows < 0 || cols <= 0)
+    throw std::invalid_argument("Rows and columns can't be non-positive");
+  constexpr int kStep = kRowAlignment / sizeof(T);
+  const FileHeader header =
+      MakeHeader<T>(rows, cols, (cols + kStep - 1) / kStep * kStep);
+  File file = Open(path, "wb");
+  if (std::fwrite(&header, sizeof(header), 1, file.get()) != 1 ||
+      std::fflush(file.get()) != 0 ||
+      ftruncate(fileno(file.get()),
+                header.payload_offset + PayloadBytes(header)) != 0)
+    throw std::runtime_error("Can't write " + path);
+  return header;
+}
+
+// Данные своего типа читаются прямо в буфер матрицы: одним вызовом, если
+// шаг строк совпадает, иначе по строкам. Другой тип читается как есть и
+// приводится конструктором преобразования.
+template <typename T>
+S21BasicMatrix<T> ReadMatrix(const std::string &path) {
+  File file = Open(path, "rb");
+  FileHeader header;
+  if (std::fread(&header, sizeof(header), 1, file.get()) != 1)
+    throw std::runtime_error(path + " is truncated");
+  const bool swapped = CheckHeader(header, path);
+  if (header.element_type != ElementTypeOf<T>()) {
+    file.reset();
+    switch (header.element_type) {
+      case ElementType::kFloat:
+        return S21BasicMatrix<T>(ReadMatrix<float>(path));
+      case ElementType::kDouble:
+        return S21BasicMatrix<T>(ReadMatrix<double>(path));
+      default:
+        return S21BasicMatrix<T>(ReadMatrix<long double>(path));
+    }
+  }
+  if (header.element_size != sizeof(T))
+    throw std::runtime_error(path + " has another element size");
+  if (header.rows == 0) {
+    S21BasicMatrix<T> empty;
+    if (header.cols != 0) empty.Reserve(0, header.cols);
+    return empty;
+  }
+  S21BasicMatrix<T> matrix(header.rows, header.cols);
+  if (std::fseek(file.get(), header.payload_offset, SEEK_SET) != 0)
+    throw std::runtime_error(path + " is truncated");
+  bool complete = true;
+  if (static_cast<std::uint64_t>(matrix.GetStride()) == header.stride) {
+    const std::size_t count = PayloadBytes(header) / sizeof(T);
+    complete = std::fread(matrix.GetData(), sizeof(T), count, file.get()) ==
+               count;
+  } else {
+    const long skip = (header.stride - header.cols) * sizeof(T);
+    for (int i = 0; complete && i < matrix.GetRows(); ++i)
+      complete = std::fread(matrix[i], sizeof(T), header.cols, file.get()) ==
+                     header.cols &&
+                 std::fseek(file.get(), skip, SEEK_CUR) == 0;
+  }
+  if (!complete) throw std::runtime_error(path + " is truncated");
+  if (swapped)
+    for (int i = 0; i < matrix.GetRows(); ++i)
+      for (int j = 0; j < matrix.GetCols(); ++j) SwapBytes(matrix[i][j]);
+  return matrix;
+}
+
+}  // namespace s21
+
+// Файл отображается целиком с начала, чтобы страница заголовка стала
+// заголовком буфера матрицы: его 64 байта перед данными переписываются,
+// для этого страница открывается на запись с копированием. Данные
+// остаются в кэше страниц ядра и читаются по мере обращения. Если файл
+// записан на машине с меньшей страницей, первые строки делят страницу с
+// заголовком и при kReadOnly тоже доступны для записи (в копию).
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const std::string &path, s21::MapMode mode)
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      data_(nullptr),
+      rows_table_(nullptr) {
+  s21::Descriptor descriptor(path);
+  s21::FileHeader header;
+  if (pread(descriptor.Get(), &header, sizeof(header), 0) != sizeof(header))
+    throw std::runtime_error(path + " is truncated");
+  if (s21::CheckHeader(header, path))
+    throw std::runtime_error(path + " has a foreign byte order");
+  if (header.element_type != s21::ElementTypeOf<T>() ||
+      header.element_size != sizeof(T))
+    throw std::runtime_error(path + " has another element type");
+  if (header.rows == 0) {  //отображать нечего
+    if (header.cols != 0) Reserve(0, header.cols);
+    return;
+  }
+  const std::size_t page = sysconf(_SC_PAGESIZE);
+  const std::size_t offset = header.payload_offset;
+  if (offset < s21::kBufferHeader || offset - s21::kBufferHeader >= page ||
+      offset % s21::kRowAlignment != 0)
+    throw std::runtime_error(path + " can't be mapped at this offset");
+  const std::size_t bytes = offset + s21::PayloadBytes(header);
+  struct stat status;
+  if (fstat(descriptor.Get(), &status) != 0 ||
+      static_cast<std::size_t>(status.st_size) < bytes)
+    throw std::runtime_error(path + " is truncated");
+  int protection = PROT_READ;
+  if (mode == s21::MapMode::kCopyOnWrite) protection |= PROT_WRITE;
+  void *base =
+      mmap(nullptr, bytes, protection, MAP_PRIVATE, descriptor.Get(), 0);
+  if (base == MAP_FAILED) throw std::runtime_error("Can't map " + path);
+  char *block = static_cast<char *>(base) + offset - s21::kBufferHeader;
+  if (mprotect(base, page, PROT_READ | PROT_WRITE) != 0) {
+    munmap(base, bytes);
+    throw std::runtime_error("Can't map " + path);
+  }
+  data_ = static_cast<T *>(s21::AdoptMatrixBuffer(
+      block, s21::kBufferHeader + s21::PayloadBytes(header),
+      s21::GetMappedFileAllocator()));
+  rows_ = header.rows;
+  cols_ = header.cols;
+  stride_ = header.stride;
+}
+
+#define S21_INSTANTIATE_IO(T)                                             \
+  template void s21::WriteMatrix(const std::string &,                     \
+                                 const S21BasicMatrix<T> &);              \
+  template S21BasicMatrix<T> s21::ReadMatrix(const std::string &);        \
+  template s21::FileHeader s21::CreateMatrixFile<T>(const std::string &,  \
+                                                   int, int);             \
+  template S21BasicMatrix<T>::S21BasicMatrix(const std::string &,         \
+                                             s21::MapMode);
+
+S21_INSTANTIATE_IO(float)
+S21_INSTANTIATE_IO(double)
+S21_INSTANTIATE_IO(long double)
@@ -0,0 +1,66 @@
+#ifndef S21_MATRIX_IO
+#define S21_MATRIX_IO
+
+#include <cstdint>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+// Двоичный формат файла матрицы. Заголовок — 64 байта (FileHeader), затем
+// нули до payload_offset — начала страницы записавшей машины (не меньше
+// 4096), и с него строки матрицы подряд по stride элементов, как в буфере
+// S21BasicMatrix: файл читается одним вызовом или отображается в память
+// без копирования. Порядок байтов записывающей машины хранится в
+// заголовке; ReadMatrix переставляет байты чужого порядка и приводит тип
+// элементов, отображение требует совпадения того и другого.
+//
+// Ошибки ввода-вывода и неверный формат файла — std::runtime_error.
+namespace s21 {
+
+// Как отображается файл: только чтение (любая запись в элементы —
+// SIGSEGV) или копирование при записи (изменения не попадают в файл,
+// копируются только изменённые страницы).
+enum class MapMode { kReadOnly, kCopyOnWrite };
+
+// Тип элементов в файле.
+enum class ElementType : std::uint16_t {
+  kFloat = 1,
+  kDouble = 2,
+  kLongDouble = 3
+};
+
+struct FileHeader {
+  char magic[8];             //"S21MATRX"
+  std::uint32_t byte_order;  //kByteOrderMark в порядке записавшей машины
+  std::uint16_t version;
+  ElementType element_type;
+  std::uint32_t element_size;  //sizeof элемента у записавшей машины
+  std::uint32_t alignment;     //выравнивание данных и строк в байтах
+  std::uint64_t rows, cols;
+  std::uint64_t stride;          //элементов между началами строк
+  std::uint64_t payload_offset;  //начало данных от начала файла
+  char reserved[8];
+};
+static_assert(sizeof(FileHeader) == 64, "The header must be 64 bytes");
+
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+constexpr std::uint16_t kFileVersion = 1;
+
+template <typename T>
+void WriteMatrix(const std::string &path, const S21BasicMatrix<T> &matrix);
+
+// Читает матрицу в обычный буфер; тип элементов файла приводится к T.
+template <typename T>
+S21BasicMatrix<T> ReadMatrix(const std::string &path);
+
+FileHeader ReadFileHeader(const std::string &path);
+
+// Создаёт файл матрицы rows x cols из нулей и возвращает его заголовок,
+// чтобы заполнять данные по частям со смещения payload_offset. rows может
+// быть 0: матрица 0 x cols, как после Reserve.
+template <typename T>
+FileHeader CreateMatrixFile(const std::string &path, int rows, int cols);
+
+}  // namespace s21
+
+#endif
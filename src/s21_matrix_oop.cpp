@@ -1,292 +1,750 @@
 #include "s21_matrix_oop.h"
 
-S21Matrix::S21Matrix() : rows_(0), cols_(0), matrix_(nullptr) {}
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "s21_allocator.h"
+#include "s21_gemm.h"
+#include "s21_kernels.h"
+#include "s21_lu.h"
+#include "s21_parallel.h"
+#include "s21_profile.h"
+#include "s21_transpose.h"
+
+namespace {
+// Строки от 64 столбцов дополняются до кратного числу элементов в линии
+// буфера (8 double, 16 float, 4 long double), чтобы каждая строка
+// начиналась с её границы.
+constexpr int kPaddedStrideMinCols = 64;
+
+// Применяет построчное ядро к паре матриц одного размера. Если обе лежат
+// без отступов между строками, ядро вызывается на куски общего буфера.
+// Большие матрицы обрабатываются в несколько потоков.
+template <typename T, typename Kernel>
+void ZipRows(T *dst, int dst_stride, const T *src, int src_stride, int rows,
+             int cols, Kernel kernel) {
+  if (rows == 0) return;
+  if (dst_stride == cols && src_stride == cols &&
+      static_cast<long>(rows) * cols <= INT_MAX) {
+    s21::ParallelFor(0, rows * cols, s21::kParallelGrain,
+                     [&](int first, int last) {
+                       kernel(dst + first, src + first, last - first);
+                     });
+    return;
+  }
+  s21::ParallelFor(0, rows, s21::kParallelGrain / cols + 1,
+                   [&](int first, int last) {
+                     for (int i = first; i < last; ++i)
+                       kernel(dst + static_cast<std::size_t>(i) * dst_stride,
+                              src + static_cast<std::size_t>(i) * src_stride,
+                              cols);
+                   });
+}
+
+// Финализатор MurmurHash3: каждый бит входа влияет на все биты выхода.
+std::uint64_t Mix(std::uint64_t value) {
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ULL;
+  return value ^ (value >> 33);
+}
+
+// Битовый образ значения через double: у равных значений он один, -0
+// приводится к +0. Разные long double могут совпасть — для хеша это
+// только коллизия.
+template <typename T>
+std::uint64_t HashBits(T value) {
+  const double normalized = static_cast<double>(value) + 0.0;
+  std::uint64_t bits;
+  std::memcpy(&bits, &normalized, sizeof(bits));
+  return bits;
+}
+
+template <typename T>
+void HashElement(std::uint64_t &lane, T value) {
+  lane = (lane ^ HashBits(value)) * 0x9e3779b97f4a7c15ULL;
+  lane ^= lane >> 32;
+}
+
+// Геометрический рост запаса: needed, но не меньше удвоенного current.
+int Grow(int current, int needed) {
+  return std::max<long>(needed, std::min<long>(2L * current, INT_MAX));
+}
+}  // namespace
+
+template <typename T>
+int S21BasicMatrix<T>::StrideFor(int cols) {
+  constexpr int kStrideStep = s21::kBufferAlignment / sizeof(T);
+  if (cols < kPaddedStrideMinCols) return cols;
+  return (cols + kStrideStep - 1) / kStrideStep * kStrideStep;
+}
+
+// Память берётся у распределителя текущего потока (s21_allocator.h),
+// буфер сам помнит, куда его вернуть.
+template <typename T>
+T *S21BasicMatrix<T>::AllocateBuffer(std::size_t count, bool zero) {
+  void *buffer = s21::AllocateMatrixBuffer(count * sizeof(T));
+  if (zero) std::memset(buffer, 0, count * sizeof(T));
+  return static_cast<T *>(buffer);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::FreeBuffer(T *buffer) noexcept {
+  s21::FreeMatrixBuffer(buffer);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Swap(S21BasicMatrix &other) noexcept {
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(stride_, other.stride_);
+  std::swap(data_, other.data_);
+  rows_table_ = other.rows_table_.exchange(rows_table_.load());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::ReleaseRowsTable() const noexcept {
+  delete[] rows_table_.exchange(nullptr);
+}
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix()
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      data_(nullptr),
+      rows_table_(nullptr) {}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows),
+      cols_(cols),
+      stride_(0),
+      data_(nullptr),
+      rows_table_(nullptr) {
   if (rows_ <= 0 || cols_ <= 0)
     throw std::invalid_argument("Rows and columns can't be non-positive");
-  this->matrix_ = new double *[rows_];
-  for (int i = 0; i < rows_; ++i) {
-    matrix_[i] = new double[cols_];
-  }
+  stride_ = StrideFor(cols_);
+  data_ = AllocateBuffer(static_cast<std::size_t>(rows_) * stride_);
 }
 
-S21Matrix::S21Matrix(const S21Matrix &other)
-    : rows_(other.rows_), cols_(other.cols_) {
-  matrix_ = new double *[rows_];
-  for (int i = 0; i < rows_; ++i) {
-    matrix_[i] = new double[cols_];
-    for (int j = 0; j < cols_; ++j) matrix_[i][j] = other.matrix_[i][j];
-  }
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix &other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      data_(nullptr),
+      rows_table_(nullptr) {
+  if (other.data_ == nullptr) return;
+  std::size_t count = static_cast<std::size_t>(rows_) * stride_;
+  data_ = AllocateBuffer(count, false);
+  std::memcpy(data_, other.data_, count * sizeof(T));
 }
 
-S21Matrix::S21Matrix(S21Matrix &&other) noexcept
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix &&other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      data_(other.data_),
+      rows_table_(other.rows_table_.exchange(nullptr)) {
   other.rows_ = 0;
   other.cols_ = 0;
-  other.matrix_ = nullptr;
+  other.stride_ = 0;
+  other.data_ = nullptr;
 }
 
-S21Matrix::~S21Matrix() noexcept {
-  for (int i = 0; i < rows_; ++i) {
-    delete[] matrix_[i];
-  }
-  delete[] matrix_;
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() noexcept {
+  ReleaseRowsTable();
+  FreeBuffer(data_);
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const { return this->rows_; }
+
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const { return this->cols_; }
+
+template <typename T>
+int S21BasicMatrix<T>::GetStride() const { return this->stride_; }
+
+template <typename T>
+T *S21BasicMatrix<T>::GetData() const { return this->data_; }
+
+// Потоки, одновременно не нашедшие таблицы, строят каждый свою; остаётся
+// первая записанная, остальные удаляются.
+template <typename T>
+T **S21BasicMatrix<T>::GetMatrix() const {
+  T **table = rows_table_.load(std::memory_order_acquire);
+  if (table != nullptr || data_ == nullptr) return table;
+  T **built = new T *[rows_];
+  for (int i = 0; i < rows_; ++i) built[i] = Row(i);
+  if (rows_table_.compare_exchange_strong(table, built,
+                                          std::memory_order_acq_rel))
+    return built;
+  delete[] built;
+  return table;
 }
 
-int S21Matrix::GetRows() const { return this->rows_; }
+// Запас считается по размеру буфера; в отображённом файле его нет, там
+// растёт только размер, и то с перевыделением.
+template <typename T>
+int S21BasicMatrix<T>::RowCapacity() const {
+  if (data_ == nullptr) return 0;
+  std::size_t capacity = s21::GetMatrixBufferCapacity(data_) / sizeof(T);
+  return std::max<std::size_t>(
+      rows_, std::min<std::size_t>(capacity / stride_, INT_MAX));
+}
 
-int S21Matrix::GetCols() const { return this->cols_; }
+template <typename T>
+int S21BasicMatrix<T>::ColCapacity() const {
+  if (data_ == nullptr) return 0;
+  return s21::GetMatrixBufferCapacity(data_) != 0 ? stride_ : cols_;
+}
 
-double **S21Matrix::GetMatrix() const { return this->matrix_; }
+template <typename T>
+bool S21BasicMatrix<T>::IsMapped() const {
+  return data_ != nullptr && s21::GetMatrixBufferCapacity(data_) == 0;
+}
 
-void S21Matrix::SetRows(int new_rows) {
+// Новый буфер на row_capacity строк с шагом stride; переносятся только
+// элементы матрицы, новые строки и столбцы обнуляет тот, кто их открывает.
+template <typename T>
+void S21BasicMatrix<T>::Reallocate(int row_capacity, int stride) {
+  T *new_data =
+      AllocateBuffer(static_cast<std::size_t>(row_capacity) * stride, false);
+  if (stride == stride_) {
+    std::memcpy(new_data, data_,
+                static_cast<std::size_t>(rows_) * stride_ * sizeof(T));
+  } else {
+    for (int i = 0; i < this->rows_; ++i)
+      std::memcpy(new_data + static_cast<std::size_t>(i) * stride, Row(i),
+                  cols_ * sizeof(T));
+  }
+  ReleaseRowsTable();
+  FreeBuffer(data_);
+  this->data_ = new_data;
+  this->stride_ = stride;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int new_rows) {
   if (new_rows <= 0) throw std::invalid_argument("Rows can't be non-positive");
   if (new_rows == this->rows_) return;
-  S21Matrix new_matrix(new_rows, this->cols_);
-  int min_rows = std::min(new_rows, this->rows_);
-  for (int i = 0; i < min_rows; ++i) {
-    for (int j = 0; j < this->cols_; ++j) {
-      new_matrix[i][j] = matrix_[i][j];
-    }
-  }
-  for (int i = 0; i < this->rows_; ++i) {
-    delete[] this->matrix_[i];
-  }
-  delete[] this->matrix_;
+  if (this->data_ == nullptr)
+    throw std::invalid_argument("Rows and columns can't be non-positive");
+  if (new_rows > RowCapacity())
+    Reallocate(Grow(RowCapacity(), new_rows), stride_);
+  if (new_rows > this->rows_)
+    std::memset(Row(rows_), 0,
+                static_cast<std::size_t>(new_rows - rows_) * stride_ *
+                    sizeof(T));
+  ReleaseRowsTable();
   this->rows_ = new_rows;
-  this->matrix_ = new double *[rows_];
-  for (int i = 0; i < rows_; ++i) {
-    this->matrix_[i] = new double[cols_];
-    for (int j = 0; j < cols_; ++j) this->matrix_[i][j] = new_matrix[i][j];
-  }
 }
 
-void S21Matrix::SetCols(int new_cols) {
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int new_cols) {
   if (new_cols <= 0)
     throw std::invalid_argument("Columns can't be non-positive");
   if (new_cols == this->cols_) return;
-  S21Matrix new_matrix(this->rows_, new_cols);
-  int min_cols = std::min(new_cols, this->cols_);
-  for (int i = 0; i < this->rows_; ++i) {
-    for (int j = 0; j < min_cols; ++j) {
-      new_matrix[i][j] = matrix_[i][j];
-    }
-  }
-  for (int i = 0; i < this->rows_; ++i) {
-    delete[] this->matrix_[i];
-  }
-  // delete[] this->matrix_;
+  if (this->data_ == nullptr)
+    throw std::invalid_argument("Rows and columns can't be non-positive");
+  if (new_cols > ColCapacity())
+    Reallocate(RowCapacity(), StrideFor(Grow(ColCapacity(), new_cols)));
+  for (int i = 0; i < this->rows_ && new_cols > cols_; ++i)
+    std::memset(Row(i) + cols_, 0, (new_cols - cols_) * sizeof(T));
   this->cols_ = new_cols;
-  // this->matrix_ = new double *[rows_];
-  for (int i = 0; i < rows_; ++i) {
-    this->matrix_[i] = new double[cols_];
-    for (int j = 0; j < cols_; ++j) {
-      this->matrix_[i][j] = new_matrix[i][j];
-    }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Reserve(int rows, int cols) {
+  if (rows < 0 || cols < 0)
+    throw std::invalid_argument("Rows and columns can't be negative");
+  if (this->data_ == nullptr) {
+    //пустая матрица становится матрицей 0 x cols с запасом на rows строк
+    if (cols == 0)
+      throw std::invalid_argument("Rows and columns can't be non-positive");
+    cols_ = cols;
+    stride_ = StrideFor(cols);
+    data_ = AllocateBuffer(static_cast<std::size_t>(rows) * stride_, false);
+    return;
   }
+  const int stride = cols > ColCapacity() ? StrideFor(cols) : stride_;
+  if (rows > RowCapacity() || stride != stride_)
+    Reallocate(std::max(rows, RowCapacity()), stride);
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetRowCapacity() const {
+  return RowCapacity();
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetColCapacity() const {
+  return ColCapacity();
+}
+
+template <typename T>
+void S21BasicMatrix<T>::AppendRow(const T *row) {
+  if (this->data_ == nullptr)
+    throw std::invalid_argument("Rows and columns can't be non-positive");
+  if (this->rows_ == RowCapacity())
+    Reallocate(Grow(RowCapacity(), rows_ + 1), stride_);
+  std::memcpy(Row(rows_), row, cols_ * sizeof(T));
+  ReleaseRowsTable();
+  ++this->rows_;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::ShrinkToFit() {
+  if (this->data_ == nullptr) return;
+  if (RowCapacity() != rows_ || StrideFor(cols_) != stride_)
+    Reallocate(rows_, StrideFor(cols_));
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix &other) const {
+  if (this->rows_ != other.rows_ || this->cols_ != other.cols_) return false;
+  S21_PROFILE_OPERATION(s21::Operation::kEqMatrix, 0);
+  std::atomic<bool> equal{true};
+  const s21::BasicElementwiseKernels<T> &kernels =
+      s21::GetElementwiseKernels<T>();
+  ZipRows(this->data_, this->stride_, other.data_, other.stride_, rows_, cols_,
+          [&](T *row, const T *other_row, std::size_t count) {
+            if (equal.load(std::memory_order_relaxed) &&
+                !kernels.equal(row, other_row, count))
+              equal.store(false, std::memory_order_relaxed);
+          });
+  return equal.load();
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) const {
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix &other, T absolute,
+                                 T relative) const {
+  if (!(absolute >= 0 && relative >= 0))
+    throw std::invalid_argument("Tolerance can't be negative");
   if (this->rows_ != other.rows_ || this->cols_ != other.cols_) return false;
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      if ((*this)[i][j] != other[i][j]) return false;
+  S21_PROFILE_OPERATION(s21::Operation::kEqMatrix, 0);
+  std::atomic<bool> equal{true};
+  const s21::BasicElementwiseKernels<T> &kernels =
+      s21::GetElementwiseKernels<T>();
+  ZipRows(this->data_, this->stride_, other.data_, other.stride_, rows_, cols_,
+          [&](T *row, const T *other_row, std::size_t count) {
+            if (equal.load(std::memory_order_relaxed) &&
+                !kernels.near(row, other_row, absolute, relative, count))
+              equal.store(false, std::memory_order_relaxed);
+          });
+  return equal.load();
+}
+
+// Элементы идут в четыре независимые цепочки по номеру столбца, так что
+// умножения соседних элементов не ждут друг друга.
+template <typename T>
+std::size_t S21BasicMatrix<T>::Hash(T quantum) const {
+  if (!(quantum >= 0))
+    throw std::invalid_argument("Quantum can't be negative");
+  const T scale = quantum > 0 ? 1 / quantum : 0;
+  std::uint64_t lanes[4] = {Mix(rows_), Mix(cols_), 1, 2};
+  for (int i = 0; i < this->rows_; ++i) {
+    const T *row = Row(i);
+    int j = 0;
+    if (quantum > 0) {
+      for (; j + 4 <= cols_; j += 4)
+        for (int lane = 0; lane < 4; ++lane)
+          HashElement(lanes[lane], std::nearbyint(row[j + lane] * scale));
+      for (; j < cols_; ++j)
+        HashElement(lanes[j % 4], std::nearbyint(row[j] * scale));
+    } else {
+      for (; j + 4 <= cols_; j += 4)
+        for (int lane = 0; lane < 4; ++lane)
+          HashElement(lanes[lane], row[j + lane]);
+      for (; j < cols_; ++j) HashElement(lanes[j % 4], row[j]);
     }
   }
-  return true;
+  return static_cast<std::size_t>(
+      Mix(lanes[0] ^ Mix(lanes[1] ^ Mix(lanes[2] ^ Mix(lanes[3])))));
 }
 
-void S21Matrix::SumMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix &other) {
   if (this->rows_ != other.rows_ || this->cols_ != other.cols_)
     throw std::logic_error("Matrix sizes are different");
-  for (int i = 0; i < this->rows_; ++i) {
-    for (int j = 0; j < this->cols_; ++j) {
-      this->matrix_[i][j] += other.matrix_[i][j];
-    }
-  }
+  S21_PROFILE_OPERATION(s21::Operation::kSumMatrix, double(rows_) * cols_);
+  ZipRows(data_, stride_, other.data_, other.stride_, rows_, cols_,
+          s21::GetElementwiseKernels<T>().add);
 }
 
-void S21Matrix::SubMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix &other) {
   if (this->rows_ != other.rows_ || this->cols_ != other.cols_)
     throw std::logic_error("Matrix sizes are different");
-  for (int i = 0; i < this->rows_; ++i) {
-    for (int j = 0; j < this->cols_; ++j) {
-      this->matrix_[i][j] -= other.matrix_[i][j];
-    }
-  }
+  S21_PROFILE_OPERATION(s21::Operation::kSubMatrix, double(rows_) * cols_);
+  ZipRows(data_, stride_, other.data_, other.stride_, rows_, cols_,
+          s21::GetElementwiseKernels<T>().sub);
 }
 
-void S21Matrix::MulNumber(const double num) {
-  for (int i = 0; i < this->rows_; ++i) {
-    for (int j = 0; j < this->cols_; ++j) {
-      this->matrix_[i][j] *= num;
-    }
-  }
+template <typename T>
+void S21BasicMatrix<T>::SumScaledMatrix(const S21BasicMatrix &other,
+                                        const T num) {
+  if (this->rows_ != other.rows_ || this->cols_ != other.cols_)
+    throw std::logic_error("Matrix sizes are different");
+  const s21::BasicElementwiseKernels<T> &kernels =
+      s21::GetElementwiseKernels<T>();
+  ZipRows(data_, stride_, other.data_, other.stride_, rows_, cols_,
+          [&](T *row, const T *other_row, std::size_t count) {
+            kernels.add_scaled(row, other_row, num, count);
+          });
 }
 
-void S21Matrix::MulMatrix(const S21Matrix &other) {
-  if (this->cols_ != other.rows_)
-    throw std::logic_error(
-        "The columns number of the first matrix is ​​not equal to the rows "
-        "number of the second matrix");
-  S21Matrix new_matrix(this->rows_, other.cols_);
-  for (int i = 0; i < this->rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      double sum = 0;
-      for (int k = 0; k < this->cols_; ++k) {
-        sum += this->matrix_[i][k] * other.matrix_[k][j];
-      }
-      new_matrix[i][j] = sum;
-    }
-  }
-  *this = new_matrix;
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
+  S21_PROFILE_OPERATION(s21::Operation::kMulNumber, double(rows_) * cols_);
+  const s21::BasicElementwiseKernels<T> &kernels =
+      s21::GetElementwiseKernels<T>();
+  ZipRows(data_, stride_, data_, stride_, rows_, cols_,
+          [&](T *row, const T *, std::size_t count) {
+            kernels.scale(row, num, count);
+          });
 }
 
-S21Matrix S21Matrix::Transpose() const {
-  S21Matrix transpose_matrix(this->cols_, this->rows_);
-  for (int i = 0; i < this->rows_; ++i) {
-    for (int j = 0; j < this->cols_; ++j) {
-      transpose_matrix[j][i] = this->matrix_[i][j];
-    }
-  }
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix &other) {
+  S21BasicMatrix new_matrix = *this * other;
+  Swap(new_matrix);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const {
+  S21_PROFILE_OPERATION(s21::Operation::kTranspose, 0);
+  S21BasicMatrix transpose_matrix;
+  if (this->rows_ == 0) return transpose_matrix;  //матриц n x 0 нет
+  //все элементы перезаписываются, обнуляется только выравнивание строк
+  transpose_matrix.rows_ = this->cols_;
+  transpose_matrix.cols_ = this->rows_;
+  transpose_matrix.stride_ = StrideFor(this->rows_);
+  transpose_matrix.data_ = AllocateBuffer(
+      static_cast<std::size_t>(this->cols_) * transpose_matrix.stride_,
+      transpose_matrix.stride_ != this->rows_);
+  s21::Transpose(rows_, cols_, data_, stride_, transpose_matrix.data_,
+                 transpose_matrix.stride_);
   return transpose_matrix;
 }
 
-S21Matrix S21Matrix::CalcComplements() const {
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  if (this->rows_ == 0) {  //0 x n с запасом становится пустой
+    *this = S21BasicMatrix();
+    return;
+  }
+  if (this->rows_ == this->cols_) {
+    s21::TransposeSquareInPlace(rows_, data_, stride_);
+    return;
+  }
+  // Строки сдвигаются вплотную, плотная матрица транспонируется обходом
+  // циклов, затем строки результата расставляются с обычным шагом, если он
+  // помещается в тот же буфер; иначе остаются вплотную.
+  std::size_t capacity = static_cast<std::size_t>(rows_) * stride_;
+  for (int i = 1; i < this->rows_ && stride_ != cols_; ++i)
+    std::memmove(data_ + static_cast<std::size_t>(i) * cols_, Row(i),
+                 cols_ * sizeof(T));
+  s21::TransposeDenseInPlace(rows_, cols_, data_);
+  ReleaseRowsTable();
+  std::swap(rows_, cols_);
+  stride_ = cols_;
+  int padded_stride = StrideFor(cols_);
+  if (static_cast<std::size_t>(rows_) * padded_stride > capacity) return;
+  stride_ = padded_stride;
+  for (int i = this->rows_ - 1; i > 0 && stride_ != cols_; --i)
+    std::memmove(Row(i), data_ + static_cast<std::size_t>(i) * cols_,
+                 cols_ * sizeof(T));
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() const {
   if (this->rows_ != this->cols_)
     throw std::logic_error("The matrix isn't square");
-  S21Matrix complements_matrix(this->rows_, this->cols_);
+  S21_PROFILE_OPERATION(s21::Operation::kCalcComplements,
+                        2.0 * rows_ * rows_ * rows_);
+  if (this->rows_ > 3) {
+    // C = det(A) * (A^-1)^T по одному разложению; матрицы с нулевым
+    // ведущим элементом идут через разложение с полным выбором
+    S21BasicLU<T> lu(*this);
+    const bool singular = lu.HasZeroPivot();
+    S21BasicMatrix complements_matrix =
+        singular ? S21BasicCompleteLU<T>(*this).Adjugate() : lu.Inverse();
+    complements_matrix.TransposeInPlace();
+    if (singular) return complements_matrix;
+    complements_matrix.MulNumber(lu.Determinant());
+    return complements_matrix;
+  }
+  S21BasicMatrix complements_matrix(this->rows_, this->cols_);
+  if (this->rows_ == 1) {
+    complements_matrix[0][0] = 1;
+    return complements_matrix;
+  }
   for (int i = 0; i < this->rows_; ++i) {
     for (int j = 0; j < this->cols_; ++j) {
-      S21Matrix minor_matrix = Minor(i, j);
-      double minor_determinant = minor_matrix.Determinant();
+      //минор порядка 1 или 2 считается на месте, без копии через Minor
+      int r0 = i == 0, c0 = j == 0;
+      T minor_determinant = Row(r0)[c0];
+      if (this->rows_ == 3) {
+        int r1 = i == 2 ? 1 : 2, c1 = j == 2 ? 1 : 2;
+        minor_determinant =
+            Row(r0)[c0] * Row(r1)[c1] - Row(r0)[c1] * Row(r1)[c0];
+      }
       complements_matrix[i][j] =
-          std::pow(-1, (i + 1 + j + 1)) * minor_determinant;
+          (i + j) % 2 == 0 ? minor_determinant : -minor_determinant;
     }
   }
   return complements_matrix;
 }
 
-S21Matrix S21Matrix::Minor(int skip_row, int skip_colm) const {
-  if (skip_row >= this->rows_ || skip_colm >= this->cols_)
-    throw std::out_of_range("Index is out of range");
-  S21Matrix minor_matrix(this->rows_ - 1, this->cols_ - 1);
-  int minor_matrix_row = 0;
-  for (int i = 0; i < this->rows_; ++i) {
-    if (i == skip_row) continue;
-    int minor_matrix_colm = 0;
-    for (int j = 0; j < this->cols_; ++j) {
-      if (j == skip_colm) continue;
-      minor_matrix[minor_matrix_row][minor_matrix_colm] = matrix_[i][j];
-      ++minor_matrix_colm;
-    }
-    ++minor_matrix_row;
-  }
-  return minor_matrix;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Minor(int skip_row,
+                                          int skip_colm) const {
+  S21BasicMatrixView<T> minor = MinorView(skip_row, skip_colm);
+  //пустой минор не матрица, как у конструктора S21Matrix(0, n)
+  if (minor.GetRows() == 0 || minor.GetCols() == 0)
+    throw std::invalid_argument("Rows and columns can't be non-positive");
+  return S21BasicMatrix(minor);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::View() const {
+  return S21BasicMatrixView<T>(*this);
 }
 
-double S21Matrix::Determinant() const {
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Block(int row, int col, int rows,
+                                              int cols) const {
+  return View().Block(row, col, rows, cols);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::MinorView(int skip_row,
+                                                  int skip_colm) const {
+  return View().MinorView(skip_row, skip_colm);
+}
+
+template <typename T>
+T S21BasicMatrix<T>::Determinant() const {
   if (this->rows_ != this->cols_)
     throw std::logic_error("The matrix isn't square");
-  if (this->rows_ == 1) return matrix_[0][0];
-  if (this->rows_ == 2)
-    return matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
-  else {
-    double determinant = 0;
-    for (int j = 0; j < this->cols_; ++j) {
-      S21Matrix minor_matrix = Minor(0, j);
-      double minor_determinant = minor_matrix.Determinant();
-      determinant += matrix_[0][j] * std::pow(-1, j) * minor_determinant;
-    }
-    return determinant;
+  S21_PROFILE_OPERATION(s21::Operation::kDeterminant,
+                        2.0 / 3.0 * rows_ * rows_ * rows_);
+  if (this->rows_ == 0) return 0;  //как разложение по строке: пустая сумма
+  if (this->rows_ == 1) return Row(0)[0];
+  if (this->rows_ == 2) {
+    const T *row0 = Row(0), *row1 = Row(1);
+    return row0[0] * row1[1] - row0[1] * row1[0];
+  }
+  if (this->rows_ == 3) {
+    //разложение по первой строке: для 3x3 дешевле и точнее разложения LU
+    const T *row0 = Row(0), *row1 = Row(1), *row2 = Row(2);
+    return row0[0] * (row1[1] * row2[2] - row1[2] * row2[1]) -
+           row0[1] * (row1[0] * row2[2] - row1[2] * row2[0]) +
+           row0[2] * (row1[0] * row2[1] - row1[1] * row2[0]);
   }
+  // Ведущий элемент на уровне погрешности сокращения даёт ровно 0, а не
+  // остаток округления вроде 1e-30: det == 0 проверяют как раньше.
+  return S21BasicLU<T>(*this).Determinant();
 }
 
-S21Matrix S21Matrix::InverseMatrix() const {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() const {
   if (this->rows_ != this->cols_)
     throw std::logic_error("The matrix isn't square");
-  double determinant = Determinant();
+  S21_PROFILE_OPERATION(s21::Operation::kInverseMatrix,
+                        2.0 * rows_ * rows_ * rows_);
+  if (this->rows_ > 3) return S21BasicLU<T>(*this).Inverse();
+  T determinant = Determinant();
   if (determinant == 0) throw std::logic_error("The determinant is zero");
-  S21Matrix inverse_matrix = CalcComplements().Transpose();
+  S21BasicMatrix inverse_matrix = CalcComplements();
+  inverse_matrix.TransposeInPlace();
   return inverse_matrix * (1 / determinant);
 }
 
-double *S21Matrix::operator[](int index) const {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(
+    const S21BasicMatrix &other) const {
+  return S21BasicLU<T>(*this).Solve(other);
+}
+
+template <typename T>
+T *S21BasicMatrix<T>::operator[](int index) const {
   if (index >= rows_) {
     throw std::out_of_range("Index is out of range");
   }
-  return matrix_[index];
+  return Row(index);
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix &other) const {
-  S21Matrix new_matrix(*this);
-  return new_matrix += other;
-}
-
-S21Matrix S21Matrix::operator-(const S21Matrix &other) const {
-  S21Matrix new_matrix(*this);
-  return new_matrix -= other;
-}
-
-S21Matrix S21Matrix::operator*(const S21Matrix &other) const {
-  S21Matrix new_matrix(*this);
-  return new_matrix *= other;
-}
-
-S21Matrix S21Matrix::operator*(const double num) const {
-  S21Matrix new_matrix(*this);
-  return new_matrix *= num;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix &other) const {
+  if (this->cols_ != other.rows_)
+    throw std::logic_error(
+        "The columns number of the first matrix is ​​not equal to the rows "
+        "number of the second matrix");
+  S21_PROFILE_OPERATION(s21::Operation::kMulMatrix,
+                        2.0 * rows_ * other.cols_ * cols_);
+  S21BasicMatrix new_matrix(this->rows_, other.cols_);
+  s21::Gemm(this->rows_, other.cols_, this->cols_, 1.0, data_, stride_,
+            other.data_, other.stride_, 0.0, new_matrix.data_,
+            new_matrix.stride_);
+  return new_matrix;
 }
 
-bool S21Matrix::operator==(const S21Matrix &other) const {
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix &other) const {
   return this->EqMatrix(other);
 }
 
-S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const S21BasicMatrix &other) {
   if (this == &other)  //проверка на самоприсваивание
     return *this;
+  std::size_t count = static_cast<std::size_t>(other.rows_) * other.stride_;
+  //в отображение только для чтения писать нельзя, оно заменяется буфером,
+  //как при перемещении
+  if (this->rows_ != other.rows_ || this->stride_ != other.stride_ ||
+      IsMapped()) {
+    T *new_data = count != 0 ? AllocateBuffer(count, false) : nullptr;
+    ReleaseRowsTable();
+    FreeBuffer(data_);
+    data_ = new_data;
+  }
   this->rows_ = other.rows_;
   this->cols_ = other.cols_;
-  if (this->matrix_ != nullptr) {
-    for (int i = 0; i < rows_; ++i) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
-  }
-  matrix_ = new double *[rows_];
-  for (int i = 0; i < rows_; ++i) {
-    matrix_[i] = new double[cols_];
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
-  }
+  this->stride_ = other.stride_;
+  if (count != 0) std::memcpy(data_, other.data_, count * sizeof(T));
   return *this;
 }
 
-S21Matrix &S21Matrix::operator+=(const S21Matrix &other) {
+// Свой буфер освобождается сразу, а не уходит в other.
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(
+    S21BasicMatrix &&other) noexcept {
+  if (this == &other) return *this;
+  ReleaseRowsTable();
+  FreeBuffer(data_);
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  data_ = other.data_;
+  rows_table_ = other.rows_table_.exchange(nullptr);
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+  other.data_ = nullptr;
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(const S21BasicMatrix &other) {
   this->SumMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator-=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(const S21BasicMatrix &other) {
   this->SubMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator*=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const S21BasicMatrix &other) {
   this->MulMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator*=(const double num) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const T num) {
   this->MulNumber(num);
   return *this;
 }
 
-double &S21Matrix::operator()(int row_index, int col_index) const {
+template <typename T>
+T &S21BasicMatrix<T>::operator()(int row_index, int col_index) const {
   if (row_index >= rows_ || col_index >= cols_) {
     throw std::out_of_range("Index is out of range");
   }
-  return matrix_[row_index][col_index];
-}
\ No newline at end of file
+  return Row(row_index)[col_index];
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
+
+namespace s21 {
+namespace {
+
+// Приводит out к размеру rows x cols без выделения, если хватает запаса;
+// содержимое out после этого не определено.
+template <typename T>
+void Reshape(S21BasicMatrix<T> &out, int rows, int cols) {
+  if (out.GetRows() == rows && out.GetCols() == cols) return;
+  if (rows == 0 || cols == 0) {
+    out = S21BasicMatrix<T>();
+  } else if (out.GetData() != nullptr && rows <= out.GetRowCapacity() &&
+             cols <= out.GetColCapacity()) {
+    out.SetCols(cols);
+    out.SetRows(rows);
+  } else {
+    out = S21BasicMatrix<T>(rows, cols);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void Multiply(const S21BasicMatrix<T> &a, const S21BasicMatrix<T> &b,
+              S21BasicMatrix<T> &out) {
+  if (&out == &a || &out == &b) {
+    out = a * b;
+    return;
+  }
+  if (a.GetCols() != b.GetRows())
+    throw std::logic_error(
+        "The columns number of the first matrix is not equal to the rows "
+        "number of the second matrix");
+  S21_PROFILE_OPERATION(s21::Operation::kMulMatrix,
+                        2.0 * a.GetRows() * b.GetCols() * a.GetCols());
+  Reshape(out, a.GetRows(), b.GetCols());
+  Gemm(a.GetRows(), b.GetCols(), a.GetCols(), T(1), a.GetData(),
+       a.GetStride(), b.GetData(), b.GetStride(), T(0), out.GetData(),
+       out.GetStride());
+}
+
+template <typename T>
+void Transpose(const S21BasicMatrix<T> &a, S21BasicMatrix<T> &out) {
+  if (&out == &a) {
+    out.TransposeInPlace();
+    return;
+  }
+  if (a.GetData() == nullptr) {
+    out = S21BasicMatrix<T>();
+    return;
+  }
+  S21_PROFILE_OPERATION(s21::Operation::kTranspose, 0);
+  Reshape(out, a.GetCols(), a.GetRows());
+  Transpose(a.GetRows(), a.GetCols(), a.GetData(), a.GetStride(),
+            out.GetData(), out.GetStride());
+}
+
+#define S21_INSTANTIATE_OUT_PARAMETERS(T)                                 \
+  template void Multiply(const S21BasicMatrix<T> &,                       \
+                         const S21BasicMatrix<T> &, S21BasicMatrix<T> &); \
+  template void Transpose(const S21BasicMatrix<T> &, S21BasicMatrix<T> &);
+
+S21_INSTANTIATE_OUT_PARAMETERS(float)
+S21_INSTANTIATE_OUT_PARAMETERS(double)
+S21_INSTANTIATE_OUT_PARAMETERS(long double)
+
+}  // namespace s21
@@ -1,52 +1,197 @@
 #ifndef S21_MATRIX_OOP
 #define S21_MATRIX_OOP
 
+#include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <utility>
 
-class S21Matrix {
+template <typename Derived>
+class S21MatrixExpression;
+template <typename T>
+class S21BasicMatrixView;
+namespace s21 {
+enum class MapMode;  //s21_matrix_io.h
+}
+
+// Матрица над типом элементов T: float, double или long double (члены
+// явно инстанцированы в s21_matrix_oop.cpp только для них). Матрицы разных
+// типов в одном выражении не смешиваются: переход к другой точности —
+// явный конструктор преобразования.
+template <typename T>
+class S21BasicMatrix {
  private:
   int rows_, cols_;
-  double **matrix_;
+  int stride_;  //шаг между строками в буфере (leading dimension)
+  T *data_;     //единый выровненный буфер, строки подряд
+  // Таблица строк для GetMatrix(), строится при первом вызове. Атомарна,
+  // чтобы GetMatrix() у константной матрицы можно было звать из потоков.
+  mutable std::atomic<T **> rows_table_;
+
+  T *Row(int index) const {
+    return data_ + static_cast<std::size_t>(index) * stride_;
+  }
+  void Swap(S21BasicMatrix &other) noexcept;
+  void ReleaseRowsTable() const noexcept;
+  static int StrideFor(int cols);
+  int RowCapacity() const;
+  int ColCapacity() const;
+  bool IsMapped() const;  //буфер — отображённый файл, возможно для чтения
+  void Reallocate(int row_capacity, int stride);
+  static T *AllocateBuffer(std::size_t count, bool zero = true);
+  static void FreeBuffer(T *buffer) noexcept;
+
+  template <typename Expression>
+  using EnableIfSameScalar =
+      std::enable_if_t<std::is_same<typename Expression::Scalar, T>::value>;
 
  public:
-  S21Matrix();                      //базовый конструктор
-  S21Matrix(int rows_, int cols_);  //параметризированный конструктор
-  S21Matrix(const S21Matrix &other);  //конструктор копирования
-  S21Matrix(S21Matrix &&other) noexcept;  //конструктор перемещения
-  ~S21Matrix() noexcept;                  //деструктор
+  typedef T Scalar;
+
+  S21BasicMatrix();                      //базовый конструктор
+  S21BasicMatrix(int rows_, int cols_);  //параметризированный конструктор
+  S21BasicMatrix(const S21BasicMatrix &other);  //конструктор копирования
+  S21BasicMatrix(S21BasicMatrix &&other) noexcept;  //конструктор перемещения
+  template <typename U>
+  explicit S21BasicMatrix(
+      const S21BasicMatrix<U> &other);  //преобразование точности
+  template <typename Expression,
+            typename = EnableIfSameScalar<Expression>>
+  S21BasicMatrix(const S21MatrixExpression<Expression>
+                     &expression);  //вычисление выражения за один проход
+  S21BasicMatrix(const std::string &path,
+                 s21::MapMode mode);  //отображение файла без копирования
+  ~S21BasicMatrix() noexcept;       //деструктор
 
   int GetRows() const;  //геттер строк
   int GetCols() const;  //геттер столбцов
-  double **GetMatrix() const;
+  T **GetMatrix() const;  //указатели на строки, живут до изменения размера
+  int GetStride() const;  //шаг между строками в элементах
+  T *GetData() const;     //начало непрерывного буфера
   void SetRows(int new_rows);  //сеттер строк
   void SetCols(int new_cols);  //сеттер столбцов
+  // Запас памяти, как у std::vector: пока размер не выходит за него,
+  // SetRows, SetCols и AppendRow не перевыделяют буфер, уменьшение всегда
+  // на месте. При выходе за запас он растёт вдвое. Пустая матрица после
+  // Reserve — матрица 0 x cols, которую можно наполнять AppendRow.
+  void Reserve(int rows, int cols);
+  int GetRowCapacity() const;  //строк в буфере
+  int GetColCapacity() const;  //столбцов без перевыделения
+  void AppendRow(const T *row);  //новая строка из cols элементов row
+  void ShrinkToFit();            //отдать запас
+
+  bool EqMatrix(const S21BasicMatrix &other) const;  //проверка на равенство
+  // Равенство с допуском: |a - b| <= max(absolute, relative * max(|a|, |b|))
+  // для каждой пары элементов; при relative = 0 допуск абсолютный, при
+  // absolute = 0 — относительный. Бесконечность равна только себе, NaN —
+  // ничему. Отрицательный допуск — std::invalid_argument.
+  bool EqMatrix(const S21BasicMatrix &other, T absolute, T relative = 0) const;
+  // Хеш размеров и элементов, округлённых до кратных quantum (при 0 —
+  // точных значений, тогда он согласован с ==). Матрицы, чьи элементы
+  // округляются к одним кратным, дают равные хеши, но близкие элементы по
+  // разные стороны границы округления могут разойтись: совпадение хеша
+  // сужает поиск, решает EqMatrix с допуском.
+  std::size_t Hash(T quantum = 0) const;
+  void SumMatrix(const S21BasicMatrix &other);  //сложение двух матриц
+  void SubMatrix(const S21BasicMatrix &other);  //вычитание двух матриц
+  void SumScaledMatrix(const S21BasicMatrix &other,
+                       const T num);  //this += other * num за проход
+  void MulNumber(const T num);  //умножение матрицы на число
+  void MulMatrix(const S21BasicMatrix &other);  //умножение двух матриц
+  S21BasicMatrix Transpose() const;  //транспонирование матрицы
+  void TransposeInPlace();  //транспонирование без второго буфера
+  S21BasicMatrix CalcComplements() const;  //матрица алгебраических дополнений
+  T Determinant() const;                //определитель матрицы
+  S21BasicMatrix InverseMatrix() const;  //обратная матрица
+  S21BasicMatrix Solve(const S21BasicMatrix &other) const;  //A * X = other
+  S21BasicMatrix Minor(int skip_row,
+                       int skip_colm) const;  //высчитывания минора
+  S21BasicMatrixView<T> View() const;  //вид на всю матрицу без копирования
+  S21BasicMatrixView<T> Block(int row, int col, int rows,
+                              int cols) const;  //вид на подблок
+  S21BasicMatrixView<T> MinorView(int skip_row,
+                                  int skip_colm) const;  //минор без копии
+
+  T *operator[](int index) const;
+  S21BasicMatrix operator*(const S21BasicMatrix &other) const;
+  bool operator==(const S21BasicMatrix &other) const;
+  S21BasicMatrix &operator=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator=(S21BasicMatrix &&other) noexcept;
+  template <typename Expression>
+  S21BasicMatrix &operator=(const S21MatrixExpression<Expression> &expression);
+  S21BasicMatrix &operator+=(const S21BasicMatrix &other);
+  template <typename Expression>
+  S21BasicMatrix &operator+=(
+      const S21MatrixExpression<Expression> &expression);
+  S21BasicMatrix &operator-=(const S21BasicMatrix &other);
+  template <typename Expression>
+  S21BasicMatrix &operator-=(
+      const S21MatrixExpression<Expression> &expression);
+  S21BasicMatrix &operator*=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator*=(const T num);
+  T &operator()(int row_index, int col_index) const;
+};
 
-  bool EqMatrix(const S21Matrix &other) const;  //проверка на равенство матриц
-  void SumMatrix(const S21Matrix &other);  //сложение двух матриц
-  void SubMatrix(const S21Matrix &other);  //вычитание двух матриц
-  void MulNumber(const double num);  //умножение матрицы на число
-  void MulMatrix(const S21Matrix &other);  //умножение двух матриц
-  S21Matrix Transpose() const;  //транспонирование матрицы
-  S21Matrix CalcComplements() const;  //матрица алгебраических дополнений
-  double Determinant() const;       //определитель матрицы
-  S21Matrix InverseMatrix() const;  //обратная матрица
-  S21Matrix Minor(int skip_row,
-                  int skip_colm) const;  //высчитывания минора
-
-  double *operator[](int index) const;
-  S21Matrix operator+(const S21Matrix &other) const;
-  S21Matrix operator-(const S21Matrix &other) const;
-  S21Matrix operator*(const S21Matrix &other) const;
-  S21Matrix operator*(const double num) const;
-  bool operator==(const S21Matrix &other) const;
-  S21Matrix &operator=(const S21Matrix &other);
-  S21Matrix &operator+=(const S21Matrix &other);
-  S21Matrix &operator-=(const S21Matrix &other);
-  S21Matrix &operator*=(const S21Matrix &other);
-  S21Matrix &operator*=(const double num);
-  double &operator()(int row_index, int col_index) const;
+typedef S21BasicMatrix<double> S21Matrix;
+typedef S21BasicMatrix<float> S21MatrixF;
+typedef S21BasicMatrix<long double> S21MatrixLD;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+
+// Для std::unordered_set и std::unordered_map с точным ==.
+namespace std {
+template <typename T>
+struct hash<S21BasicMatrix<T>> {
+  size_t operator()(const S21BasicMatrix<T> &matrix) const {
+    return matrix.Hash();
+  }
 };
+}  // namespace std
+
+// Варианты с результатом в out для циклов без выделения памяти: если out
+// уже нужного размера или размер помещается в его запас (Reserve), буфер
+// out используется повторно. out = a + b и out = a * 2.0 и так считаются
+// на месте, если размеры совпадают.
+namespace s21 {
+
+// out = a * b. Если out — один из операндов, произведение считается во
+// временную матрицу.
+template <typename T>
+void Multiply(const S21BasicMatrix<T> &a, const S21BasicMatrix<T> &b,
+              S21BasicMatrix<T> &out);
+// out = a^T; при out == a — транспонирование на месте.
+template <typename T>
+void Transpose(const S21BasicMatrix<T> &a, S21BasicMatrix<T> &out);
+
+}  // namespace s21
+
+// Каждый элемент приводится static_cast: при сужении точность теряется
+// так же, как при присваивании double во float.
+template <typename T>
+template <typename U>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix<U> &other)
+    : S21BasicMatrix() {
+  if (other.GetData() == nullptr) return;
+  if (other.GetRows() == 0) {
+    Reserve(0, other.GetCols());
+    return;
+  }
+  S21BasicMatrix result(other.GetRows(), other.GetCols());
+  for (int i = 0; i < result.rows_; ++i) {
+    const U *source = other[i];
+    T *row = result.Row(i);
+    for (int j = 0; j < result.cols_; ++j) row[j] = static_cast<T>(source[j]);
+  }
+  Swap(result);
+}
+
+#include "s21_matrix_expr.h"
 
 #endif
\ No newline at end of file
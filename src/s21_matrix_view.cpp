@@ -0,0 +1,236 @@
+#include "s21_matrix_view.h"
+
+#include <atomic>
+
+#include "s21_gemm.h"
+#include "s21_transpose.h"
+
+namespace {
+
+// Сдвиг вдоль одной оси для подблока [first, first + count) вида с
+// пропущенным индексом skip: смещение в исходной матрице и пропуск внутри
+// подблока.
+void ShiftAxis(int first, int count, int skip, int *offset, int *new_skip) {
+  *offset = first;
+  *new_skip = -1;
+  if (skip < 0 || first + count <= skip) return;
+  if (first >= skip)
+    *offset = first + 1;
+  else
+    *new_skip = skip - first;
+}
+
+}  // namespace
+
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(T *data, int rows, int cols,
+                                          int stride, int skip_row,
+                                          int skip_col)
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      stride_(stride),
+      skip_row_(skip_row),
+      skip_col_(skip_col) {
+  if (rows < 0 || cols < 0 || skip_row > rows || skip_col > cols)
+    throw std::invalid_argument("Invalid view size");
+  //пропуск за последней строкой или столбцом ничего не меняет
+  if (skip_row_ == rows_) skip_row_ = -1;
+  if (skip_col_ == cols_) skip_col_ = -1;
+}
+
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(const S21BasicMatrix<T> &matrix)
+    : S21BasicMatrixView(matrix.GetData(), matrix.GetRows(),
+                         matrix.GetCols(), matrix.GetStride()) {}
+
+template <typename T>
+void S21BasicMatrixView<T>::StoreRow(int index, const T *row) const {
+  ForEachSegment(index, [row](int col, T *segment, int count) {
+    std::memcpy(segment, row + col, count * sizeof(T));
+  });
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Block(int row, int col,
+                                                  int rows, int cols) const {
+  if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+      col + cols > cols_)
+    throw std::out_of_range("Index is out of range");
+  int row_offset, col_offset, block_skip_row, block_skip_col;
+  ShiftAxis(row, rows, skip_row_, &row_offset, &block_skip_row);
+  ShiftAxis(col, cols, skip_col_, &col_offset, &block_skip_col);
+  return S21BasicMatrixView(
+      data_ + static_cast<std::size_t>(row_offset) * stride_ + col_offset,
+      rows, cols, stride_, block_skip_row, block_skip_col);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::MinorView(int skip_row,
+                                                      int skip_col) const {
+  if (skip_row < 0 || skip_col < 0 || skip_row >= rows_ || skip_col >= cols_)
+    throw std::out_of_range("Index is out of range");
+  if (HasSkips())
+    throw std::logic_error("A minor of a minor view isn't supported");
+  return S21BasicMatrixView(data_, rows_ - 1, cols_ - 1, stride_, skip_row,
+                            skip_col);
+}
+
+// Строки другого вида с пропущенным столбцом сначала собираются подряд.
+template <typename T>
+bool S21BasicMatrixView<T>::EqMatrix(const S21BasicMatrixView &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  if (rows_ == 0 || cols_ == 0) return true;
+  std::atomic<bool> equal{true};
+  const Kernels &kernels = s21::GetElementwiseKernels<T>();
+  const int grain = s21::kParallelGrain / cols_ + 1;
+  s21::ParallelFor(0, rows_, grain, [&](int first, int last) {
+    std::vector<T> gathered(other.skip_col_ >= 0 ? cols_ : 0);
+    for (int i = first; i < last && equal.load(std::memory_order_relaxed);
+         ++i) {
+      const T *other_row = other.Row(i);
+      if (other.skip_col_ >= 0) {
+        other.AssignRow(i, gathered.data(), kernels);
+        other_row = gathered.data();
+      }
+      ForEachSegment(i, [&](int col, const T *segment, int count) {
+        if (!kernels.equal(segment, other_row + col, count))
+          equal.store(false, std::memory_order_relaxed);
+      });
+    }
+  });
+  return equal.load();
+}
+
+template <typename T>
+void S21BasicMatrixView<T>::SumMatrix(const S21BasicMatrixView &other) {
+  *this += other;
+}
+
+template <typename T>
+void S21BasicMatrixView<T>::SubMatrix(const S21BasicMatrixView &other) {
+  *this -= other;
+}
+
+template <typename T>
+void S21BasicMatrixView<T>::MulNumber(const T num) {
+  if (rows_ == 0 || cols_ == 0) return;
+  const Kernels &kernels = s21::GetElementwiseKernels<T>();
+  const int grain = s21::kParallelGrain / cols_ + 1;
+  s21::ParallelFor(0, rows_, grain, [&](int first, int last) {
+    for (int i = first; i < last; ++i)
+      ForEachSegment(i, [&](int, T *segment, int count) {
+        kernels.scale(segment, num, count);
+      });
+  });
+}
+
+// Вид делится пропусками не больше чем на четыре плотных блока, каждый
+// транспонируется плиточным ядром на своё место в результате.
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixView<T>::Transpose() const {
+  S21BasicMatrix<T> transpose_matrix(cols_, rows_);
+  const int head_rows = skip_row_ >= 0 ? skip_row_ : rows_;
+  const int row_parts[][2] = {{0, head_rows}, {head_rows, rows_}};
+  const int col_parts[][2] = {{0, HeadCols()}, {HeadCols(), cols_}};
+  T *dst = transpose_matrix.GetData();
+  const int ldd = transpose_matrix.GetStride();
+  for (const auto &rows : row_parts) {
+    for (const auto &cols : col_parts) {
+      if (rows[0] == rows[1] || cols[0] == cols[1]) continue;
+      S21BasicMatrixView block = Block(rows[0], cols[0], rows[1] - rows[0],
+                                       cols[1] - cols[0]);
+      s21::Transpose(block.rows_, block.cols_, block.data_, stride_,
+                     dst + static_cast<std::size_t>(cols[0]) * ldd + rows[0],
+                     ldd);
+    }
+  }
+  return transpose_matrix;
+}
+
+// Миноры до 3 x 3 считаются прямо по виду, большие — разложением LU копии.
+template <typename T>
+T S21BasicMatrixView<T>::Determinant() const {
+  if (rows_ != cols_) throw std::logic_error("The matrix isn't square");
+  if (rows_ == 0 || rows_ > 3) return S21BasicMatrix<T>(*this).Determinant();
+  int c[3];  //столбцы исходной матрицы с учётом пропуска
+  for (int j = 0; j < rows_; ++j) c[j] = j + (j >= HeadCols());
+  const T *row0 = Row(0);
+  if (rows_ == 1) return row0[c[0]];
+  const T *row1 = Row(1);
+  if (rows_ == 2) return row0[c[0]] * row1[c[1]] - row0[c[1]] * row1[c[0]];
+  const T *row2 = Row(2);
+  return row0[c[0]] * (row1[c[1]] * row2[c[2]] - row1[c[2]] * row2[c[1]]) -
+         row0[c[1]] * (row1[c[0]] * row2[c[2]] - row1[c[2]] * row2[c[0]]) +
+         row0[c[2]] * (row1[c[0]] * row2[c[1]] - row1[c[1]] * row2[c[0]]);
+}
+
+template <typename T>
+T &S21BasicMatrixView<T>::operator()(int row_index, int col_index) const {
+  if (row_index < 0 || col_index < 0 || row_index >= rows_ ||
+      col_index >= cols_)
+    throw std::out_of_range("Index is out of range");
+  return Row(row_index)[col_index + (col_index >= HeadCols())];
+}
+
+template <typename T>
+S21BasicMatrixView<T> &S21BasicMatrixView<T>::operator=(
+    const S21BasicMatrixView &other) {
+  if (other.rows_ != rows_ || other.cols_ != cols_)
+    throw std::logic_error("Matrix sizes are different");
+  AssignRows(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrixView<T> &S21BasicMatrixView<T>::operator*=(const T num) {
+  MulNumber(num);
+  return *this;
+}
+
+// Перекрытие тех же строк (одинаковые начало, шаг и пропущенная строка)
+// можно обойти буфером на строку, любое другое — нет.
+template <typename T>
+s21::expression::Alias S21BasicMatrixView<T>::Aliases(
+    const S21BasicMatrixView &target) const {
+  if (rows_ == 0 || cols_ == 0 || target.rows_ == 0 || target.cols_ == 0)
+    return s21::expression::Alias::kNone;
+  auto end = [](const S21BasicMatrixView &view) {
+    int rows = view.rows_ + (view.skip_row_ >= 0);
+    int cols = view.cols_ + (view.skip_col_ >= 0);
+    return view.data_ + static_cast<std::size_t>(rows - 1) * view.stride_ +
+           cols;
+  };
+  if (data_ >= end(target) || target.data_ >= end(*this))
+    return s21::expression::Alias::kNone;
+  if (data_ == target.data_ && stride_ == target.stride_ &&
+      skip_row_ == target.skip_row_)
+    return s21::expression::Alias::kSameRows;
+  return s21::expression::Alias::kOverlap;
+}
+
+// Блоки без пропусков умножаются на месте по их шагу, миноры копируются.
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &lhs,
+                            const S21BasicMatrixView<T> &rhs) {
+  if (lhs.GetCols() != rhs.GetRows())
+    throw std::logic_error(
+        "The columns number of the first matrix is ​​not equal to the rows "
+        "number of the second matrix");
+  if (lhs.HasSkips()) return S21BasicMatrix<T>(lhs) * rhs;
+  if (rhs.HasSkips()) return lhs * S21BasicMatrix<T>(rhs);
+  S21BasicMatrix<T> new_matrix(lhs.GetRows(), rhs.GetCols());
+  s21::Gemm(lhs.GetRows(), rhs.GetCols(), lhs.GetCols(), 1.0, lhs.GetData(),
+            lhs.GetStride(), rhs.GetData(), rhs.GetStride(), 0.0,
+            new_matrix.GetData(), new_matrix.GetStride());
+  return new_matrix;
+}
+
+#define S21_INSTANTIATE_VIEW(T)                                         \
+  template class S21BasicMatrixView<T>;                                 \
+  template S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &,   \
+                                       const S21BasicMatrixView<T> &);
+
+S21_INSTANTIATE_VIEW(float)
+S21_INSTANTIATE_VIEW(double)
+S21_INSTANTIATE_VIEW(long double)
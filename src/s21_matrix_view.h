@@ -0,0 +1,249 @@
+// Подключается из s21_matrix_expr.h: виду нужен базовый класс выражений,
+// а узлам выражений — полный тип вида.
+#include "s21_matrix_oop.h"
+
+#ifndef S21_MATRIX_VIEW
+#define S21_MATRIX_VIEW
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_kernels.h"
+#include "s21_parallel.h"
+
+// Вид на часть существующей матрицы без копирования: блок rows x cols с
+// шагом строк исходной матрицы или минор, у которого пропущены одна строка
+// и один столбец. Вид не владеет памятью: он действителен, пока жива
+// матрица и не меняется её размер. Присваивание и составные операторы
+// пишут прямо в элементы матрицы; копирование вида копирует только ссылку.
+//
+// Вид — лист ленивых выражений, поэтому view + matrix * 2.0 и
+// matrix = view - other считаются за один проход без промежуточных матриц.
+template <typename T>
+class S21BasicMatrixView
+    : public S21MatrixExpression<S21BasicMatrixView<T>> {
+ private:
+  T *data_;  //первый элемент вида
+  int rows_, cols_;
+  int stride_;               //шаг строк исходной матрицы
+  int skip_row_, skip_col_;  //пропущенные строка и столбец, -1 — нет
+
+  // Столбцы вида до пропущенного, после него строка сдвинута на один.
+  int HeadCols() const { return skip_col_ >= 0 ? skip_col_ : cols_; }
+  void StoreRow(int index, const T *row) const;
+  template <typename Expression>
+  void AssignRows(const Expression &expression) const;
+  template <typename Expression>
+  void AddRows(const Expression &expression, T factor) const;
+
+  friend class S21BasicMatrix<T>;
+
+ public:
+  typedef T Scalar;
+  typedef s21::BasicElementwiseKernels<T> Kernels;
+
+  S21BasicMatrixView(T *data, int rows, int cols, int stride,
+                     int skip_row = -1, int skip_col = -1);
+  S21BasicMatrixView(const S21BasicMatrix<T> &matrix);  //вид на всю матрицу
+  S21BasicMatrixView(const S21BasicMatrixView &other) = default;
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  int GetStride() const { return stride_; }
+  T *GetData() const { return data_; }
+  bool HasSkips() const { return skip_row_ >= 0 || skip_col_ >= 0; }
+  // Строка index вида; при пропущенном столбце её элементы не подряд.
+  T *Row(int index) const {
+    if (skip_row_ >= 0 && index >= skip_row_) ++index;
+    return data_ + static_cast<std::size_t>(index) * stride_;
+  }
+
+  S21BasicMatrixView Block(int row, int col, int rows,
+                           int cols) const;  //подблок этого вида
+  S21BasicMatrixView MinorView(int skip_row,
+                               int skip_col) const;  //минор без копирования
+
+  bool EqMatrix(const S21BasicMatrixView &other) const;
+  void SumMatrix(const S21BasicMatrixView &other);
+  void SubMatrix(const S21BasicMatrixView &other);
+  void MulNumber(const T num);
+  S21BasicMatrix<T> Transpose() const;
+  T Determinant() const;
+
+  T &operator()(int row_index, int col_index) const;
+  S21BasicMatrixView &operator=(const S21BasicMatrixView &other);
+  template <typename Expression>
+  S21BasicMatrixView &operator=(
+      const S21MatrixExpression<Expression> &expression);
+  template <typename Expression>
+  S21BasicMatrixView &operator+=(
+      const S21MatrixExpression<Expression> &expression);
+  template <typename Expression>
+  S21BasicMatrixView &operator-=(
+      const S21MatrixExpression<Expression> &expression);
+  S21BasicMatrixView &operator*=(const T num);
+
+  // Вызывает function(col, segment, count) для непрерывных кусков строки
+  // index: col — номер первого столбца куска в виде.
+  template <typename Function>
+  void ForEachSegment(int index, Function function) const {
+    T *row = Row(index);
+    int head = HeadCols();
+    if (head > 0) function(0, row, head);
+    if (head < cols_) function(head, row + head + 1, cols_ - head);
+  }
+
+  // Интерфейс листа выражения.
+  s21::expression::Alias Aliases(const S21BasicMatrixView &target) const;
+
+  void AssignRow(int i, T *dst, const Kernels &) const {
+    ForEachSegment(i, [dst](int col, const T *segment, int count) {
+      std::memcpy(dst + col, segment, count * sizeof(T));
+    });
+  }
+
+  void AddRow(int i, T *dst, T factor, const Kernels &kernels) const {
+    ForEachSegment(i, [&](int col, const T *segment, int count) {
+      if (factor == 1)
+        kernels.add(dst + col, segment, count);
+      else if (factor == -1)
+        kernels.sub(dst + col, segment, count);
+      else
+        kernels.add_scaled(dst + col, segment, factor, count);
+    });
+  }
+};
+
+typedef S21BasicMatrixView<double> S21MatrixView;
+
+extern template class S21BasicMatrixView<float>;
+extern template class S21BasicMatrixView<double>;
+extern template class S21BasicMatrixView<long double>;
+
+template <typename T>
+bool operator==(const S21BasicMatrixView<T> &lhs,
+                const S21BasicMatrixView<T> &rhs) {
+  return lhs.EqMatrix(rhs);
+}
+
+template <typename T>
+bool operator==(const S21BasicMatrix<T> &lhs,
+                const S21BasicMatrixView<T> &rhs) {
+  return S21BasicMatrixView<T>(lhs).EqMatrix(rhs);
+}
+
+template <typename T>
+bool operator==(const S21BasicMatrixView<T> &lhs,
+                const S21BasicMatrix<T> &rhs) {
+  return lhs.EqMatrix(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &lhs,
+                            const S21BasicMatrixView<T> &rhs);
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &lhs,
+                            const S21BasicMatrixView<T> &rhs) {
+  return S21BasicMatrixView<T>(lhs) * rhs;
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T> &lhs,
+                            const S21BasicMatrix<T> &rhs) {
+  return lhs * S21BasicMatrixView<T>(rhs);
+}
+
+template <typename T>
+template <typename Expression>
+S21BasicMatrixView<T> &S21BasicMatrixView<T>::operator=(
+    const S21MatrixExpression<Expression> &expression) {
+  const Expression &self = expression.Self();
+  if (self.GetRows() != rows_ || self.GetCols() != cols_)
+    throw std::logic_error("Matrix sizes are different");
+  AssignRows(self);
+  return *this;
+}
+
+template <typename T>
+template <typename Expression>
+S21BasicMatrixView<T> &S21BasicMatrixView<T>::operator+=(
+    const S21MatrixExpression<Expression> &expression) {
+  AddRows(expression.Self(), T(1));
+  return *this;
+}
+
+template <typename T>
+template <typename Expression>
+S21BasicMatrixView<T> &S21BasicMatrixView<T>::operator-=(
+    const S21MatrixExpression<Expression> &expression) {
+  AddRows(expression.Self(), T(-1));
+  return *this;
+}
+
+// Если выражение читает те же строки, что и пишутся, строка сначала
+// вычисляется во временный буфер: запись в строку не должна опережать её
+// чтение. При любом другом перекрытии выражение целиком вычисляется в
+// отдельную матрицу.
+template <typename T>
+template <typename Expression>
+void S21BasicMatrixView<T>::AssignRows(const Expression &expression) const {
+  if (rows_ == 0 || cols_ == 0) return;
+  const s21::expression::Alias alias = expression.Aliases(*this);
+  if (alias == s21::expression::Alias::kOverlap) {
+    S21BasicMatrix<T> result(expression);
+    AssignRows(S21BasicMatrixView(result));
+    return;
+  }
+  const bool direct = alias == s21::expression::Alias::kNone && skip_col_ < 0;
+  const Kernels &kernels = s21::GetElementwiseKernels<T>();
+  const int grain = s21::kParallelGrain / cols_ + 1;
+  s21::ParallelFor(0, rows_, grain, [&](int first, int last) {
+    if (direct) {
+      for (int i = first; i < last; ++i)
+        expression.AssignRow(i, Row(i), kernels);
+      return;
+    }
+    std::vector<T> row(cols_);
+    for (int i = first; i < last; ++i) {
+      expression.AssignRow(i, row.data(), kernels);
+      StoreRow(i, row.data());
+    }
+  });
+}
+
+template <typename T>
+template <typename Expression>
+void S21BasicMatrixView<T>::AddRows(const Expression &expression,
+                                    T factor) const {
+  if (expression.GetRows() != rows_ || expression.GetCols() != cols_)
+    throw std::logic_error("Matrix sizes are different");
+  if (rows_ == 0 || cols_ == 0) return;
+  const s21::expression::Alias alias = expression.Aliases(*this);
+  if (alias == s21::expression::Alias::kOverlap) {
+    S21BasicMatrix<T> result(expression);
+    AddRows(S21BasicMatrixView(result), factor);
+    return;
+  }
+  const bool direct = alias == s21::expression::Alias::kNone && skip_col_ < 0;
+  const Kernels &kernels = s21::GetElementwiseKernels<T>();
+  const int grain = s21::kParallelGrain / cols_ + 1;
+  s21::ParallelFor(0, rows_, grain, [&](int first, int last) {
+    if (direct) {
+      for (int i = first; i < last; ++i)
+        expression.AddRow(i, Row(i), factor, kernels);
+      return;
+    }
+    std::vector<T> row(cols_);
+    for (int i = first; i < last; ++i) {
+      expression.AssignRow(i, row.data(), kernels);
+      ForEachSegment(i, [&](int col, T *segment, int count) {
+        kernels.add_scaled(segment, row.data() + col, factor, count);
+      });
+    }
+  });
+}
+
+#endif
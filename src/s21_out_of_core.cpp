@@ -0,0 +1,322 @@
+#include "s21_out_of_core.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "s21_allocator.h"
+#include "s21_gemm.h"
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+namespace {
+
+struct Tile {
+  int row, col, rows, cols;
+};
+
+// Открытый файл матрицы типа T; плитки читаются и пишутся pread и pwrite,
+// так что один файл можно читать из потока загрузки, не мешая другим.
+template <typename T>
+class MatrixFile {
+ public:
+  // Существующий файл операнда.
+  explicit MatrixFile(const std::string &path)
+      : path_(path), header_(ReadFileHeader(path)), fd_(-1) {
+    Open(O_RDONLY);
+    FileHeader raw;
+    struct stat status;
+    if (pread(fd_, &raw, sizeof(raw), 0) != sizeof(raw) ||
+        fstat(fd_, &status) != 0 ||
+        static_cast<std::uint64_t>(status.st_size) <
+            header_.payload_offset +
+                header_.rows * header_.stride * sizeof(T))
+      throw std::runtime_error(path + " is truncated");
+    if (raw.byte_order != kByteOrderMark)
+      throw std::runtime_error(path + " has a foreign byte order");
+    if (header_.element_size != sizeof(T) ||
+        header_.element_type != ElementTypeOfT())
+      throw std::runtime_error(path + " has another element type");
+    if (header_.cols == 0)
+      throw std::runtime_error(path + " holds an empty matrix");
+  }
+  // Новый файл результата rows x cols.
+  MatrixFile(const std::string &path, int rows, int cols)
+      : path_(path), header_(CreateMatrixFile<T>(path, rows, cols)), fd_(-1) {
+    Open(O_WRONLY);
+  }
+  ~MatrixFile() {
+    if (fd_ >= 0) close(fd_);
+  }
+  MatrixFile(const MatrixFile &) = delete;
+  MatrixFile &operator=(const MatrixFile &) = delete;
+
+  int GetRows() const { return header_.rows; }
+  int GetCols() const { return header_.cols; }
+
+  // Плитка tile ложится в левый верхний угол buffer.
+  std::size_t Read(const Tile &tile, const S21BasicMatrix<T> &buffer) const {
+    const std::size_t bytes = tile.cols * sizeof(T);
+    for (int i = 0; i < tile.rows; ++i)
+      if (!Transfer(true, buffer[i], bytes, Offset(tile.row + i, tile.col)))
+        throw std::runtime_error("Can't read " + path_);
+    return bytes * tile.rows;
+  }
+  std::size_t Write(const Tile &tile, const S21BasicMatrix<T> &buffer) const {
+    const std::size_t bytes = tile.cols * sizeof(T);
+    for (int i = 0; i < tile.rows; ++i)
+      if (!Transfer(false, buffer[i], bytes, Offset(tile.row + i, tile.col)))
+        throw std::runtime_error("Can't write " + path_);
+    return bytes * tile.rows;
+  }
+
+ private:
+  std::string path_;
+  FileHeader header_;
+  int fd_;
+
+  static ElementType ElementTypeOfT() {
+    return std::is_same<T, float>::value    ? ElementType::kFloat
+           : std::is_same<T, double>::value ? ElementType::kDouble
+                                            : ElementType::kLongDouble;
+  }
+  void Open(int flags) {
+    fd_ = open(path_.c_str(), flags);
+    if (fd_ < 0) throw std::runtime_error("Can't open " + path_);
+  }
+  off_t Offset(int row, int col) const {
+    return header_.payload_offset +
+           (static_cast<std::uint64_t>(row) * header_.stride + col) *
+               sizeof(T);
+  }
+  // pread и pwrite могут передать меньше запрошенного.
+  bool Transfer(bool read, T *data, std::size_t bytes, off_t offset) const {
+    char *cursor = reinterpret_cast<char *>(data);
+    while (bytes != 0) {
+      ssize_t done = read ? pread(fd_, cursor, bytes, offset)
+                          : pwrite(fd_, cursor, bytes, offset);
+      if (done < 0 && errno == EINTR) continue;
+      if (done <= 0) return false;
+      cursor += done;
+      bytes -= done;
+      offset += done;
+    }
+    return true;
+  }
+};
+
+// Верхняя оценка шага строк буфера с cols столбцами (см. StrideFor).
+template <typename T>
+std::size_t PaddedCols(int cols) {
+  constexpr int kStep = kBufferAlignment / sizeof(T);
+  return (static_cast<std::size_t>(cols) + kStep - 1) / kStep * kStep;
+}
+
+template <typename T>
+std::size_t BufferBytes(const S21BasicMatrix<T> &buffer) {
+  return static_cast<std::size_t>(buffer.GetRows()) * buffer.GetStride() *
+             sizeof(T) +
+         kBufferHeader;
+}
+
+void CheckPaths(const std::string &a, const std::string &b,
+                const std::string &result) {
+  if (result == a || result == b)
+    throw std::invalid_argument("The result can't overwrite an operand");
+}
+
+void CheckBudget(bool enough) {
+  if (!enough) throw std::invalid_argument("The memory budget is too small");
+}
+
+// Проходит шаги steps по порядку: load(step, slot) загружает данные шага
+// в буферы slot (0 или 1) в отдельном потоке, пока compute(step, slot)
+// считает предыдущий шаг по другим буферам.
+template <typename Load, typename Compute>
+void Pipeline(int steps, const Load &load, const Compute &compute,
+              OutOfCoreStats &stats) {
+  using Clock = std::chrono::steady_clock;
+  std::future<std::size_t> next =
+      std::async(std::launch::async, load, 0, 0);
+  for (int step = 0; step < steps; ++step) {
+    Clock::time_point start = Clock::now();
+    stats.bytes_read += next.get();
+    stats.wait_seconds +=
+        std::chrono::duration<double>(Clock::now() - start).count();
+    if (step + 1 < steps)
+      next = std::async(std::launch::async, load, step + 1, (step + 1) % 2);
+    compute(step, step % 2);
+  }
+}
+
+// Общая часть сложения и вычитания: четыре буфера, по два на операнд.
+template <typename T>
+OutOfCoreStats ElementwiseFiles(const std::string &a_path,
+                                const std::string &b_path,
+                                const std::string &result_path,
+                                std::size_t memory_budget, bool subtract) {
+  CheckPaths(a_path, b_path, result_path);
+  MatrixFile<T> a(a_path), b(b_path);
+  if (a.GetRows() != b.GetRows() || a.GetCols() != b.GetCols())
+    throw std::logic_error("Matrix sizes are different");
+  if (a.GetRows() == 0) {  //0 x cols: плиток нет, результат без строк
+    MatrixFile<T> result(result_path, 0, a.GetCols());
+    return OutOfCoreStats();
+  }
+  constexpr int kStep = kBufferAlignment / sizeof(T);
+  const std::size_t limit = memory_budget / 4;
+  CheckBudget(limit > kBufferHeader + kBufferHeader);
+  const std::size_t capacity = (limit - kBufferHeader) / sizeof(T);
+  const int cols = std::min<std::size_t>(a.GetCols(),
+                                         capacity / kStep * kStep);
+  CheckBudget(cols > 0);
+  const int rows =
+      std::min<std::size_t>(a.GetRows(), capacity / PaddedCols<T>(cols));
+  std::vector<Tile> tiles;
+  for (int row = 0; row < a.GetRows(); row += rows)
+    for (int col = 0; col < a.GetCols(); col += cols)
+      tiles.push_back({row, col, std::min(rows, a.GetRows() - row),
+                       std::min(cols, a.GetCols() - col)});
+  MatrixFile<T> result(result_path, a.GetRows(), a.GetCols());
+  S21BasicMatrix<T> a_tiles[2] = {{rows, cols}, {rows, cols}};
+  S21BasicMatrix<T> b_tiles[2] = {{rows, cols}, {rows, cols}};
+  OutOfCoreStats stats;
+  stats.buffer_bytes = 4 * BufferBytes(a_tiles[0]);
+  Pipeline(
+      tiles.size(),
+      [&](int step, int slot) {
+        return a.Read(tiles[step], a_tiles[slot]) +
+               b.Read(tiles[step], b_tiles[slot]);
+      },
+      [&](int step, int slot) {
+        const Tile &tile = tiles[step];
+        S21BasicMatrixView<T> sum = a_tiles[slot].Block(0, 0, tile.rows,
+                                                        tile.cols);
+        if (subtract)
+          sum.SubMatrix(b_tiles[slot].Block(0, 0, tile.rows, tile.cols));
+        else
+          sum.SumMatrix(b_tiles[slot].Block(0, 0, tile.rows, tile.cols));
+        stats.bytes_written += result.Write(tile, a_tiles[slot]);
+      },
+      stats);
+  return stats;
+}
+
+}  // namespace
+
+template <typename T>
+OutOfCoreStats SumMatrixFiles(const std::string &a, const std::string &b,
+                              const std::string &result,
+                              std::size_t memory_budget) {
+  return ElementwiseFiles<T>(a, b, result, memory_budget, false);
+}
+
+template <typename T>
+OutOfCoreStats SubMatrixFiles(const std::string &a, const std::string &b,
+                              const std::string &result,
+                              std::size_t memory_budget) {
+  return ElementwiseFiles<T>(a, b, result, memory_budget, true);
+}
+
+// Пять буферов t x t: по два для плиток a и b и один для плитки
+// результата. Шаг конвейера — пара плиток a(i, p) и b(p, j); на последнем
+// p плитка результата записывается, пока читается следующая пара.
+template <typename T>
+OutOfCoreStats MulMatrixFiles(const std::string &a_path,
+                              const std::string &b_path,
+                              const std::string &result_path,
+                              std::size_t memory_budget) {
+  CheckPaths(a_path, b_path, result_path);
+  MatrixFile<T> a(a_path), b(b_path);
+  if (a.GetCols() != b.GetRows())
+    throw std::logic_error(
+        "The columns number of the first matrix is not equal to the rows "
+        "number of the second matrix");
+  if (a.GetRows() == 0) {
+    MatrixFile<T> result(result_path, 0, b.GetCols());
+    return OutOfCoreStats();
+  }
+  const int largest =
+      std::max(std::max(a.GetRows(), a.GetCols()), b.GetCols());
+  int side = std::min<double>(
+      largest, std::sqrt(memory_budget / 5.0 / sizeof(T)));
+  while (side > 0 &&
+         5 * (side * PaddedCols<T>(side) * sizeof(T) + kBufferHeader) >
+             memory_budget)
+    --side;
+  CheckBudget(side > 0);
+  struct Step {
+    Tile a, b;
+    bool first, last;  //первая и последняя пара для плитки результата
+  };
+  std::vector<Step> steps;
+  for (int row = 0; row < a.GetRows(); row += side)
+    for (int col = 0; col < b.GetCols(); col += side)
+      for (int inner = 0; inner < a.GetCols(); inner += side) {
+        const int rows = std::min(side, a.GetRows() - row);
+        const int cols = std::min(side, b.GetCols() - col);
+        const int depth = std::min(side, a.GetCols() - inner);
+        steps.push_back({{row, inner, rows, depth},
+                         {inner, col, depth, cols},
+                         inner == 0,
+                         inner + side >= a.GetCols()});
+      }
+  MatrixFile<T> result(result_path, a.GetRows(), b.GetCols());
+  const int a_rows = std::min(side, a.GetRows());
+  const int depth = std::min(side, a.GetCols());
+  const int b_cols = std::min(side, b.GetCols());
+  S21BasicMatrix<T> a_tiles[2] = {{a_rows, depth}, {a_rows, depth}};
+  S21BasicMatrix<T> b_tiles[2] = {{depth, b_cols}, {depth, b_cols}};
+  S21BasicMatrix<T> c_tile(a_rows, b_cols);
+  OutOfCoreStats stats;
+  stats.buffer_bytes = 2 * BufferBytes(a_tiles[0]) +
+                       2 * BufferBytes(b_tiles[0]) + BufferBytes(c_tile);
+  Pipeline(
+      steps.size(),
+      [&](int step, int slot) {
+        return a.Read(steps[step].a, a_tiles[slot]) +
+               b.Read(steps[step].b, b_tiles[slot]);
+      },
+      [&](int step, int slot) {
+        const Step &current = steps[step];
+        Gemm(current.a.rows, current.b.cols, current.a.cols, T(1),
+             a_tiles[slot].GetData(), a_tiles[slot].GetStride(),
+             b_tiles[slot].GetData(), b_tiles[slot].GetStride(),
+             current.first ? T(0) : T(1), c_tile.GetData(),
+             c_tile.GetStride());
+        if (current.last)
+          stats.bytes_written +=
+              result.Write({current.a.row, current.b.col, current.a.rows,
+                            current.b.cols},
+                           c_tile);
+      },
+      stats);
+  return stats;
+}
+
+#define S21_INSTANTIATE_OUT_OF_CORE(T)                                      \
+  template OutOfCoreStats SumMatrixFiles<T>(                                \
+      const std::string &, const std::string &, const std::string &,        \
+      std::size_t);                                                         \
+  template OutOfCoreStats SubMatrixFiles<T>(                                \
+      const std::string &, const std::string &, const std::string &,        \
+      std::size_t);                                                         \
+  template OutOfCoreStats MulMatrixFiles<T>(                                \
+      const std::string &, const std::string &, const std::string &,        \
+      std::size_t);
+
+S21_INSTANTIATE_OUT_OF_CORE(float)
+S21_INSTANTIATE_OUT_OF_CORE(double)
+S21_INSTANTIATE_OUT_OF_CORE(long double)
+
+}  // namespace s21
@@ -0,0 +1,50 @@
+#ifndef S21_OUT_OF_CORE
+#define S21_OUT_OF_CORE
+
+#include <cstddef>
+#include <string>
+
+#include "s21_matrix_io.h"
+
+// Операции над матрицами, которые лежат в файлах формата s21_matrix_io.h и
+// не помещаются в память. Операнды читаются плитками в буферы общим
+// объёмом не больше memory_budget байт, результат записывается в новый
+// файл по мере готовности плиток. Следующие плитки читаются в отдельном
+// потоке, пока считаются текущие, так что чтение с диска перекрывается
+// вычислениями; сами вычисления идут в пуле потоков библиотеки.
+//
+// Файлы операндов должны хранить элементы типа T в порядке байтов этой
+// машины, иначе std::runtime_error (как при отображении файла). Размеры,
+// не подходящие для операции, — std::logic_error, бюджет меньше
+// нескольких строк плитки — std::invalid_argument.
+namespace s21 {
+
+struct OutOfCoreStats {
+  std::size_t buffer_bytes = 0;  //память буферов плиток
+  std::size_t bytes_read = 0;
+  std::size_t bytes_written = 0;
+  double wait_seconds = 0;  //ожидание чтения, не перекрытого вычислениями
+};
+
+// result = a + b и result = a - b: плитки из целых строк, пока строка
+// помещается в бюджет, поэтому каждый операнд читается один раз.
+template <typename T>
+OutOfCoreStats SumMatrixFiles(const std::string &a, const std::string &b,
+                              const std::string &result,
+                              std::size_t memory_budget);
+template <typename T>
+OutOfCoreStats SubMatrixFiles(const std::string &a, const std::string &b,
+                              const std::string &result,
+                              std::size_t memory_budget);
+
+// result = a * b квадратными плитками: каждая плитка результата
+// накапливается в памяти по всем плиткам общего измерения. a читается
+// cols(b) / t раз, b — rows(a) / t раз, где t — сторона плитки.
+template <typename T>
+OutOfCoreStats MulMatrixFiles(const std::string &a, const std::string &b,
+                              const std::string &result,
+                              std::size_t memory_budget);
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,261 @@
+#include "s21_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+namespace {
+
+// Верхняя граница числа рабочих потоков: очереди выделяются один раз и
+// не переезжают, пока потоки их читают.
+constexpr int kMaxWorkers = 255;
+// Кусков на поток: запас для перехвата работы при неравных кусках.
+constexpr int kChunksPerThread = 4;
+
+std::atomic<int> global_thread_count{0};
+thread_local int scope_thread_count = 0;
+// Глубина параллельных тел в текущем потоке: вложенные вызовы идут
+// последовательно, иначе поток мог бы ждать сам себя.
+thread_local int parallel_depth = 0;
+
+int DefaultThreadCount() {
+  if (const char *value = std::getenv("S21_NUM_THREADS")) {
+    int count = std::atoi(value);
+    if (count > 0) return std::min(count, kMaxWorkers + 1);
+  }
+  int hardware = static_cast<int>(std::thread::hardware_concurrency());
+  return std::clamp(hardware, 1, kMaxWorkers + 1);
+}
+
+struct Job {
+  parallel::RangeFunction function;
+  const void *body;
+  int participants;  //вызывающий поток и рабочие 0 .. participants - 2
+  std::atomic<int> pending;
+  std::mutex mutex;
+  std::condition_variable done;
+  std::exception_ptr error;
+};
+
+struct Task {
+  Job *job;
+  int first, last;
+};
+
+// Пул с очередью на каждый рабочий поток: владелец берёт задачи с конца
+// своей очереди, остальные перехватывают их с начала. Рабочий w участвует
+// только в заданиях, где разрешено больше w + 1 потоков, так что
+// ThreadCountScope действительно ограничивает параллелизм.
+class ThreadPool {
+ public:
+  static ThreadPool &Instance() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) worker.join();
+  }
+
+  void Run(Job &job, const std::vector<Task> &tasks) {
+    EnsureWorkers(job.participants - 1);
+    job.pending.store(static_cast<int>(tasks.size()));
+    // Первый кусок выполняет вызывающий поток, остальные раздаются по кругу.
+    for (std::size_t i = 1; i < tasks.size(); ++i) {
+      Queue &queue = queues_[(i - 1) % (job.participants - 1)];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(tasks[i]);
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      queued_.fetch_add(static_cast<int>(tasks.size()) - 1);
+    }
+    wake_.notify_all();
+
+    Execute(tasks[0]);
+    Task task;
+    while (StealOwn(job, task)) Execute(task);
+    std::unique_lock<std::mutex> lock(job.mutex);
+    job.done.wait(lock, [&] { return job.pending.load() == 0; });
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  ThreadPool() : queues_(new Queue[kMaxWorkers]) {}
+
+  void EnsureWorkers(int count) {
+    if (worker_count_.load() >= count) return;
+    std::lock_guard<std::mutex> lock(grow_mutex_);
+    for (int w = worker_count_.load(); w < count; ++w) {
+      workers_.emplace_back([this, w] { WorkerLoop(w); });
+      worker_count_.store(w + 1);
+    }
+  }
+
+  static bool Eligible(const Task &task, int worker) {
+    return worker + 1 < task.job->participants;
+  }
+
+  void Execute(const Task &task) {
+    Job &job = *task.job;
+    ++parallel_depth;
+    try {
+      job.function(job.body, task.first, task.last);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(job.mutex);
+      if (!job.error) job.error = std::current_exception();
+    }
+    --parallel_depth;
+    // Счётчик уменьшается под мьютексом задания: иначе вызывающий поток мог
+    // бы увидеть ноль и уничтожить задание до notify_all.
+    std::lock_guard<std::mutex> lock(job.mutex);
+    if (--job.pending == 0) job.done.notify_all();
+  }
+
+  bool PopFront(Queue &queue, int worker, const Job *only, Task &task) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    const Task &front = queue.tasks.front();
+    if (only != nullptr ? front.job != only : !Eligible(front, worker))
+      return false;
+    task = front;
+    queue.tasks.pop_front();
+    queued_.fetch_sub(1);
+    return true;
+  }
+
+  bool PopBack(Queue &queue, Task &task) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    queued_.fetch_sub(1);
+    return true;
+  }
+
+  // Вызывающий поток помогает только своему заданию.
+  bool StealOwn(const Job &job, Task &task) {
+    for (int w = 0; w < job.participants - 1; ++w)
+      if (PopFront(queues_[w], -1, &job, task)) return true;
+    return false;
+  }
+
+  bool FindWork(int worker, Task &task) {
+    if (PopBack(queues_[worker], task)) return true;
+    int count = worker_count_.load();
+    for (int offset = 1; offset < count; ++offset) {
+      int victim = (worker + offset) % count;
+      if (PopFront(queues_[victim], worker, nullptr, task)) return true;
+    }
+    return false;
+  }
+
+  void WorkerLoop(int worker) {
+    Task task;
+    while (true) {
+      if (FindWork(worker, task)) {
+        Execute(task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      if (stop_) return;
+      // Проверка под sleep_mutex_: задачи добавляются до захвата этого
+      // мьютекса, так что пробуждение не теряется.
+      if (queued_.load() > 0 && HasEligibleWork(worker)) continue;
+      wake_.wait(lock);
+    }
+  }
+
+  bool HasEligibleWork(int worker) {
+    int count = worker_count_.load();
+    for (int w = 0; w < count; ++w) {
+      std::lock_guard<std::mutex> lock(queues_[w].mutex);
+      if (queues_[w].tasks.empty()) continue;
+      if (w == worker || Eligible(queues_[w].tasks.front(), worker))
+        return true;
+    }
+    return false;
+  }
+
+  std::unique_ptr<Queue[]> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<int> worker_count_{0};
+  std::mutex grow_mutex_;
+  std::atomic<int> queued_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+};
+
+}  // namespace
+
+int GetThreadCount() {
+  if (parallel_depth > 0) return 1;
+  if (scope_thread_count > 0) return scope_thread_count;
+  int count = global_thread_count.load();
+  if (count > 0) return count;
+  static const int default_count = DefaultThreadCount();
+  return default_count;
+}
+
+void SetThreadCount(int count) {
+  if (count < 0) throw std::logic_error("Thread count can't be negative");
+  global_thread_count.store(std::min(count, kMaxWorkers + 1));
+}
+
+ThreadCountScope::ThreadCountScope(int count)
+    : previous_(scope_thread_count) {
+  if (count <= 0) throw std::logic_error("Thread count must be positive");
+  scope_thread_count = std::min(count, kMaxWorkers + 1);
+}
+
+ThreadCountScope::~ThreadCountScope() { scope_thread_count = previous_; }
+
+namespace parallel {
+
+void Run(int begin, int end, int grain, RangeFunction function,
+         const void *body) {
+  if (begin >= end) return;
+  grain = std::max(grain, 1);
+  long length = static_cast<long>(end) - begin;
+  int threads = GetThreadCount();
+  long chunks = std::min<long>(static_cast<long>(threads) * kChunksPerThread,
+                               length / grain);
+  if (threads <= 1 || chunks <= 1) {
+    function(body, begin, end);
+    return;
+  }
+
+  Job job;
+  job.function = function;
+  job.body = body;
+  job.participants = threads;
+  std::vector<Task> tasks(chunks);
+  for (long i = 0; i < chunks; ++i)
+    tasks[i] = {&job, static_cast<int>(begin + length * i / chunks),
+                static_cast<int>(begin + length * (i + 1) / chunks)};
+  ThreadPool::Instance().Run(job, tasks);
+  if (job.error) std::rethrow_exception(job.error);
+}
+
+}  // namespace parallel
+
+}  // namespace s21
@@ -0,0 +1,61 @@
+#ifndef S21_PARALLEL
+#define S21_PARALLEL
+
+namespace s21 {
+
+// Операции делятся между потоками кусками примерно по этому числу
+// элементов или операций: меньшие куски упираются в накладные расходы пула.
+constexpr int kParallelGrain = 1 << 15;
+
+// Число потоков для операций библиотеки. По умолчанию берётся из
+// переменной окружения S21_NUM_THREADS, иначе по числу ядер. Внутри
+// параллельного тела всегда 1.
+int GetThreadCount();
+
+// Задаёт число потоков для всех последующих вызовов; 0 — значение
+// по умолчанию.
+void SetThreadCount(int count);
+
+// Ограничивает число потоков для вызовов из текущего потока, пока объект
+// жив. Области могут вкладываться.
+class ThreadCountScope {
+ public:
+  explicit ThreadCountScope(int count);
+  ~ThreadCountScope();
+  ThreadCountScope(const ThreadCountScope &) = delete;
+  ThreadCountScope &operator=(const ThreadCountScope &) = delete;
+
+ private:
+  int previous_;
+};
+
+// Выполняет body(first, last) для кусков диапазона [begin, end) в пуле
+// потоков с перехватом работы. Куски не короче grain; если диапазон меньше
+// двух кусков или разрешён один поток, body вызывается один раз в текущем
+// потоке, как и вложенные вызовы изнутри параллельного тела.
+// Первое исключение из тела пробрасывается после завершения всех кусков.
+template <typename Body>
+void ParallelFor(int begin, int end, int grain, const Body &body);
+
+namespace parallel {
+
+typedef void (*RangeFunction)(const void *body, int first, int last);
+
+void Run(int begin, int end, int grain, RangeFunction function,
+         const void *body);
+
+}  // namespace parallel
+
+template <typename Body>
+void ParallelFor(int begin, int end, int grain, const Body &body) {
+  parallel::Run(
+      begin, end, grain,
+      [](const void *context, int first, int last) {
+        (*static_cast<const Body *>(context))(first, last);
+      },
+      &body);
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,177 @@
+#include "s21_profile.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace s21 {
+namespace {
+
+const char *const kOperationNames[kOperationCount] = {
+    "sum_matrix",  "sub_matrix",       "mul_number",
+    "mul_matrix",  "eq_matrix",        "transpose",
+    "determinant", "calc_complements", "inverse_matrix"};
+
+struct Counters {
+  std::atomic<std::uint64_t> calls{0};
+  std::atomic<std::uint64_t> nanoseconds{0};
+  std::atomic<std::uint64_t> bytes_allocated{0};
+  std::atomic<std::uint64_t> flops{0};
+  std::atomic<std::uint64_t> latency_buckets[kLatencyBuckets] = {};
+};
+
+Counters counters[kOperationCount];
+
+thread_local int depth = 0;  //открытых замеров в потоке
+thread_local std::uint64_t thread_bytes = 0;
+
+std::int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int BucketOf(std::uint64_t nanoseconds) {
+  int bucket = 0;
+  for (std::uint64_t bound = 1000;
+       bucket + 1 < kLatencyBuckets && nanoseconds > bound; bound *= 10)
+    ++bucket;
+  return bucket;
+}
+
+}  // namespace
+
+bool IsProfilingEnabled() {
+#ifdef S21_INSTRUMENTATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+const char *OperationName(Operation operation) {
+  return kOperationNames[static_cast<int>(operation)];
+}
+
+double LatencyBucketBound(int bucket) {
+  if (bucket + 1 >= kLatencyBuckets)
+    return std::numeric_limits<double>::infinity();
+  double bound = 1e-6;
+  for (int i = 0; i < bucket; ++i) bound *= 10;
+  return bound;
+}
+
+ProfileSnapshot GetProfileSnapshot() {
+  ProfileSnapshot snapshot;
+  for (int i = 0; i < kOperationCount; ++i) {
+    OperationProfile &profile = snapshot.operations[i];
+    profile.calls = counters[i].calls.load();
+    profile.nanoseconds = counters[i].nanoseconds.load();
+    profile.bytes_allocated = counters[i].bytes_allocated.load();
+    profile.flops = counters[i].flops.load();
+    for (int bucket = 0; bucket < kLatencyBuckets; ++bucket)
+      profile.latency_buckets[bucket] =
+          counters[i].latency_buckets[bucket].load();
+  }
+  return snapshot;
+}
+
+void ResetProfile() {
+  for (Counters &operation : counters) {
+    operation.calls.store(0);
+    operation.nanoseconds.store(0);
+    operation.bytes_allocated.store(0);
+    operation.flops.store(0);
+    for (std::atomic<std::uint64_t> &bucket : operation.latency_buckets)
+      bucket.store(0);
+  }
+}
+
+std::string FormatProfile(const ProfileSnapshot &snapshot) {
+  struct Total {
+    const char *name, *help;
+    std::uint64_t OperationProfile::*field;
+  };
+  const Total totals[] = {
+      {"s21_matrix_calls_total", "Calls of the operation",
+       &OperationProfile::calls},
+      {"s21_matrix_bytes_allocated_total",
+       "Bytes of matrix buffers allocated by the operation",
+       &OperationProfile::bytes_allocated},
+      {"s21_matrix_flops_total", "Estimated floating point operations",
+       &OperationProfile::flops}};
+  std::ostringstream out;
+  for (const Total &total : totals) {
+    out << "# HELP " << total.name << ' ' << total.help << '\n'
+        << "# TYPE " << total.name << " counter\n";
+    for (int i = 0; i < kOperationCount; ++i)
+      out << total.name << "{op=\"" << kOperationNames[i] << "\"} "
+          << snapshot.operations[i].*total.field << '\n';
+  }
+  out << "# HELP s21_matrix_latency_seconds Latency of the operation\n"
+      << "# TYPE s21_matrix_latency_seconds histogram\n";
+  for (int i = 0; i < kOperationCount; ++i) {
+    const OperationProfile &profile = snapshot.operations[i];
+    std::uint64_t cumulative = 0;
+    for (int bucket = 0; bucket < kLatencyBuckets; ++bucket) {
+      cumulative += profile.latency_buckets[bucket];
+      out << "s21_matrix_latency_seconds_bucket{op=\"" << kOperationNames[i]
+          << "\",le=\"";
+      if (bucket + 1 < kLatencyBuckets)
+        out << LatencyBucketBound(bucket);
+      else
+        out << "+Inf";
+      out << "\"} " << cumulative << '\n';
+    }
+    out << "s21_matrix_latency_seconds_sum{op=\"" << kOperationNames[i]
+        << "\"} " << profile.nanoseconds * 1e-9 << '\n'
+        << "s21_matrix_latency_seconds_count{op=\"" << kOperationNames[i]
+        << "\"} " << profile.calls << '\n';
+  }
+  return out.str();
+}
+
+void WriteProfile(const std::string &path) {
+  const std::string text = FormatProfile(GetProfileSnapshot());
+  const std::string temporary = path + ".tmp";
+  std::FILE *file = std::fopen(temporary.c_str(), "w");
+  if (file == nullptr) throw std::runtime_error("Can't open " + temporary);
+  const bool written =
+      std::fwrite(text.data(), 1, text.size(), file) == text.size();
+  if (std::fclose(file) != 0 || !written ||
+      std::rename(temporary.c_str(), path.c_str()) != 0) {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("Can't write " + path);
+  }
+}
+
+namespace profile {
+
+Scope::Scope(Operation operation, double flops)
+    : operation_(operation),
+      flops_(flops),
+      outer_(depth++ == 0),
+      start_(outer_ ? Now() : 0),
+      bytes_(thread_bytes) {}
+
+Scope::~Scope() {
+  --depth;
+  if (!outer_) return;
+  const std::uint64_t nanoseconds = Now() - start_;
+  Counters &operation = counters[static_cast<int>(operation_)];
+  operation.calls.fetch_add(1, std::memory_order_relaxed);
+  operation.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+  operation.bytes_allocated.fetch_add(thread_bytes - bytes_,
+                                      std::memory_order_relaxed);
+  operation.flops.fetch_add(flops_, std::memory_order_relaxed);
+  operation.latency_buckets[BucketOf(nanoseconds)].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+void CountAllocation(std::size_t bytes) { thread_bytes += bytes; }
+
+}  // namespace profile
+}  // namespace s21
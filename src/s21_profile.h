@@ -0,0 +1,102 @@
+#ifndef S21_PROFILE
+#define S21_PROFILE
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Счётчики операций матриц: число вызовов, суммарное время и гистограмма
+// задержек, объём выделенных буферов и оценка числа операций с плавающей
+// точкой. Включаются сборкой библиотеки с -DS21_INSTRUMENTATION
+// (make PROFILE_FLAGS=-DS21_INSTRUMENTATION); без флага замеры в
+// операциях исчезают при компиляции, а снимок всегда нулевой. С флагом
+// замер стоит два чтения steady_clock и несколько атомарных сложений на
+// вызов, порядка 0.1 мкс: заметно только на матрицах в несколько элементов.
+//
+// Учитывается только внешний вызов: если InverseMatrix считает
+// определитель, время попадает в InverseMatrix, а Determinant не растёт.
+// Выделения считаются в потоке, вызвавшем операцию.
+namespace s21 {
+
+enum class Operation {
+  kSumMatrix,  //и +=
+  kSubMatrix,  //и -=
+  kMulNumber,  //и *= на число
+  kMulMatrix,  //MulMatrix, * и *=
+  kEqMatrix,   //и ==
+  kTranspose,
+  kDeterminant,
+  kCalcComplements,
+  kInverseMatrix,
+  kCount
+};
+
+constexpr int kOperationCount = static_cast<int>(Operation::kCount);
+// Корзины задержек по декадам: до 1 мкс, 10 мкс, ..., до 10 с и больше.
+constexpr int kLatencyBuckets = 9;
+
+const char *OperationName(Operation operation);  //"mul_matrix"
+// Верхняя граница корзины в секундах; у последней — бесконечность.
+double LatencyBucketBound(int bucket);
+
+struct OperationProfile {
+  std::uint64_t calls = 0;
+  std::uint64_t nanoseconds = 0;
+  std::uint64_t bytes_allocated = 0;
+  std::uint64_t flops = 0;
+  std::uint64_t latency_buckets[kLatencyBuckets] = {};  //не накопительные
+};
+
+struct ProfileSnapshot {
+  OperationProfile operations[kOperationCount];
+
+  const OperationProfile &operator[](Operation operation) const {
+    return operations[static_cast<int>(operation)];
+  }
+};
+
+bool IsProfilingEnabled();  //собрана ли библиотека с замерами
+
+ProfileSnapshot GetProfileSnapshot();
+void ResetProfile();
+
+// Снимок в текстовом формате Prometheus: счётчики *_total и гистограмма
+// s21_matrix_latency_seconds с меткой op.
+std::string FormatProfile(const ProfileSnapshot &snapshot);
+// Записывает FormatProfile(GetProfileSnapshot()) во временный файл и
+// переименовывает его в path, так что читатель не увидит файл
+// наполовину. Ошибка записи — std::runtime_error.
+void WriteProfile(const std::string &path);
+
+namespace profile {
+
+// Замер одной операции от конструктора до деструктора.
+class Scope {
+ public:
+  Scope(Operation operation, double flops);
+  ~Scope();
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+
+ private:
+  Operation operation_;
+  double flops_;
+  bool outer_;  //не вложен в другой замер этого потока
+  std::int64_t start_;
+  std::uint64_t bytes_;  //выделено потоком к началу замера
+};
+
+// Вызывается распределителем для каждого выделенного буфера.
+void CountAllocation(std::size_t bytes);
+
+}  // namespace profile
+}  // namespace s21
+
+#ifdef S21_INSTRUMENTATION
+#define S21_PROFILE_OPERATION(operation, flops) \
+  s21::profile::Scope s21_profile_scope((operation), (flops))
+#else
+#define S21_PROFILE_OPERATION(operation, flops) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,541 @@
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+
+#include "s21_kernels.h"
+#include "s21_parallel.h"
+
+namespace {
+// Сколько строк брать в кусок, если на lines строк приходится work
+// операций.
+int GrainFor(long work, int lines) {
+  long per_line = work / std::max(lines, 1) + 1;
+  return static_cast<int>(s21::kParallelGrain / per_line + 1);
+}
+
+// Смещения по числу элементов в каждой строке: counts[line] хранится в
+// offsets[line + 1], после суммы offsets[line] — начало строки.
+void PrefixSum(std::vector<std::size_t> &offsets) {
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+}
+}  // namespace
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix()
+    : rows_(0),
+      cols_(0),
+      layout_(s21::SparseLayout::kRows),
+      offsets_(1, 0),
+      indices_(),
+      values_() {}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(int rows, int cols)
+    : rows_(rows),
+      cols_(cols),
+      layout_(s21::SparseLayout::kRows),
+      offsets_(),
+      indices_(),
+      values_() {
+  if (rows_ <= 0 || cols_ <= 0)
+    throw std::invalid_argument("Rows and columns can't be non-positive");
+  offsets_.assign(rows_ + 1, 0);
+}
+
+// Элементы раскладываются по строкам подсчётом, затем каждая строка
+// сортируется по индексу и повторы складываются.
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, const std::vector<Entry> &entries,
+    s21::SparseLayout layout)
+    : S21BasicSparseMatrix(rows, cols) {
+  layout_ = layout;
+  const bool by_rows = layout_ == s21::SparseLayout::kRows;
+  offsets_.assign(Lines() + 1, 0);
+  for (const Entry &entry : entries) {
+    if (entry.row < 0 || entry.col < 0 || entry.row >= rows_ ||
+        entry.col >= cols_)
+      throw std::out_of_range("Index is out of range");
+    ++offsets_[(by_rows ? entry.row : entry.col) + 1];
+  }
+  PrefixSum(offsets_);
+  std::vector<std::pair<int, T>> placed(entries.size());
+  std::vector<std::size_t> next(offsets_.begin(), offsets_.end() - 1);
+  for (const Entry &entry : entries) {
+    int line = by_rows ? entry.row : entry.col;
+    placed[next[line]++] = {by_rows ? entry.col : entry.row, entry.value};
+  }
+  indices_.reserve(entries.size());
+  values_.reserve(entries.size());
+  std::size_t begin = 0;
+  for (int line = 0; line < Lines(); ++line) {
+    std::size_t end = offsets_[line + 1];
+    std::sort(placed.begin() + begin, placed.begin() + end,
+              [](const std::pair<int, T> &lhs, const std::pair<int, T> &rhs) {
+                return lhs.first < rhs.first;
+              });
+    for (std::size_t k = begin; k < end; ++k) {
+      if (k > begin && placed[k].first == placed[k - 1].first)
+        values_.back() += placed[k].second;
+      else {
+        indices_.push_back(placed[k].first);
+        values_.push_back(placed[k].second);
+      }
+    }
+    begin = end;
+    offsets_[line + 1] = values_.size();
+  }
+}
+
+// Два прохода по строкам: подсчёт ненулевых и заполнение, оба в потоках.
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(const S21BasicMatrix<T> &dense,
+                                              s21::SparseLayout layout)
+    : S21BasicSparseMatrix(dense.GetRows(), dense.GetCols()) {
+  const int rows = rows_, cols = cols_;
+  const int grain = GrainFor(static_cast<long>(rows) * cols, rows);
+  s21::ParallelFor(0, rows, grain, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      const T *row = dense[i];
+      offsets_[i + 1] = cols - std::count(row, row + cols, T(0));
+    }
+  });
+  PrefixSum(offsets_);
+  indices_.resize(offsets_[rows]);
+  values_.resize(offsets_[rows]);
+  s21::ParallelFor(0, rows, grain, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      const T *row = dense[i];
+      std::size_t k = offsets_[i];
+      for (int j = 0; j < cols; ++j) {
+        if (row[j] == 0) continue;
+        indices_[k] = j;
+        values_[k++] = row[j];
+      }
+    }
+  });
+  if (layout != layout_) *this = WithLayout(layout);
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::Lines() const {
+  return layout_ == s21::SparseLayout::kRows ? rows_ : cols_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::LineSize() const {
+  return layout_ == s21::SparseLayout::kRows ? cols_ : rows_;
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::CheckSize(
+    const S21BasicSparseMatrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_)
+    throw std::logic_error("Matrix sizes are different");
+}
+
+template <typename T>
+const S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::InRows(
+    S21BasicSparseMatrix &storage) const {
+  if (layout_ == s21::SparseLayout::kRows) return *this;
+  storage = WithLayout(s21::SparseLayout::kRows);
+  return storage;
+}
+
+// Перепаковка подсчётом: элементы строки line попадают в столбцы по
+// возрастанию line, поэтому индексы в новых строках сразу отсортированы.
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::WithLayout(
+    s21::SparseLayout layout) const {
+  if (layout == layout_) return *this;
+  S21BasicSparseMatrix result;
+  result.rows_ = rows_;
+  result.cols_ = cols_;
+  result.layout_ = layout;
+  result.offsets_.assign(LineSize() + 1, 0);
+  for (int index : indices_) ++result.offsets_[index + 1];
+  PrefixSum(result.offsets_);
+  result.indices_.resize(indices_.size());
+  result.values_.resize(values_.size());
+  std::vector<std::size_t> next(result.offsets_.begin(),
+                                result.offsets_.end() - 1);
+  for (int line = 0; line < Lines(); ++line) {
+    for (std::size_t k = offsets_[line]; k < offsets_[line + 1]; ++k) {
+      std::size_t target = next[indices_[k]]++;
+      result.indices_[target] = line;
+      result.values_[target] = values_[k];
+    }
+  }
+  return result;
+}
+
+// Элементы разных строк (столбцов) не пересекаются, поэтому строки можно
+// раскладывать в потоках при любом сжатии.
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> dense(rows_, cols_);
+  AddTo(dense, 1);
+  return dense;
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::AddTo(S21BasicMatrix<T> &dense,
+                                    T factor) const {
+  if (dense.GetRows() != rows_ || dense.GetCols() != cols_)
+    throw std::logic_error("Matrix sizes are different");
+  const bool by_rows = layout_ == s21::SparseLayout::kRows;
+  T *data = dense.GetData();
+  const std::size_t ld = dense.GetStride();
+  s21::ParallelFor(
+      0, Lines(), GrainFor(values_.size(), Lines()), [&](int first, int last) {
+        for (int line = first; line < last; ++line) {
+          for (std::size_t k = offsets_[line]; k < offsets_[line + 1]; ++k) {
+            std::size_t row = by_rows ? line : indices_[k];
+            std::size_t col = by_rows ? indices_[k] : line;
+            data[row * ld + col] += factor * values_[k];
+          }
+        }
+      });
+}
+
+// Строки сравниваются слиянием: отсутствующий элемент равен нулю, так что
+// явно хранимые нули не мешают равенству.
+template <typename T>
+bool S21BasicSparseMatrix<T>::EqMatrix(
+    const S21BasicSparseMatrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  if (other.layout_ != layout_)
+    return EqMatrix(other.WithLayout(layout_));
+  std::atomic<bool> equal{true};
+  s21::ParallelFor(
+      0, Lines(), GrainFor(values_.size() + other.values_.size(), Lines()),
+      [&](int first, int last) {
+        for (int line = first;
+             line < last && equal.load(std::memory_order_relaxed); ++line) {
+          std::size_t a = offsets_[line], a_end = offsets_[line + 1];
+          std::size_t b = other.offsets_[line],
+                      b_end = other.offsets_[line + 1];
+          while (a < a_end || b < b_end) {
+            int a_index = a < a_end ? indices_[a] : LineSize();
+            int b_index = b < b_end ? other.indices_[b] : LineSize();
+            T lhs = a_index <= b_index ? values_[a++] : T(0);
+            T rhs = b_index <= a_index ? other.values_[b++] : T(0);
+            if (lhs != rhs) {
+              equal.store(false, std::memory_order_relaxed);
+              break;
+            }
+          }
+        }
+      });
+  return equal.load();
+}
+
+// Слияние строк в два прохода: сначала длины строк результата, затем
+// заполнение по готовым смещениям. Точно сократившиеся элементы не
+// хранятся.
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Merge(
+    const S21BasicSparseMatrix &other, T factor) const {
+  CheckSize(other);
+  S21BasicSparseMatrix lhs_rows, rhs_rows;
+  const S21BasicSparseMatrix &lhs = InRows(lhs_rows);
+  const S21BasicSparseMatrix &rhs = other.InRows(rhs_rows);
+  S21BasicSparseMatrix result(rows_, cols_);
+  auto merge_row = [&](int i, int *indices, T *values) {
+    std::size_t a = lhs.offsets_[i], a_end = lhs.offsets_[i + 1];
+    std::size_t b = rhs.offsets_[i], b_end = rhs.offsets_[i + 1];
+    std::size_t count = 0;
+    while (a < a_end || b < b_end) {
+      int a_index = a < a_end ? lhs.indices_[a] : cols_;
+      int b_index = b < b_end ? rhs.indices_[b] : cols_;
+      int index = std::min(a_index, b_index);
+      T value = 0;
+      if (a_index == index) value += lhs.values_[a++];
+      if (b_index == index) value += factor * rhs.values_[b++];
+      if (value == 0) continue;
+      if (indices != nullptr) {
+        indices[count] = index;
+        values[count] = value;
+      }
+      ++count;
+    }
+    return count;
+  };
+  const int grain = GrainFor(lhs.values_.size() + rhs.values_.size(), rows_);
+  s21::ParallelFor(0, rows_, grain, [&](int first, int last) {
+    for (int i = first; i < last; ++i)
+      result.offsets_[i + 1] = merge_row(i, nullptr, nullptr);
+  });
+  PrefixSum(result.offsets_);
+  result.indices_.resize(result.offsets_[rows_]);
+  result.values_.resize(result.offsets_[rows_]);
+  s21::ParallelFor(0, rows_, grain, [&](int first, int last) {
+    for (int i = first; i < last; ++i)
+      merge_row(i, result.indices_.data() + result.offsets_[i],
+                result.values_.data() + result.offsets_[i]);
+  });
+  return result;
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SumMatrix(const S21BasicSparseMatrix &other) {
+  *this = Merge(other, 1);
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SubMatrix(const S21BasicSparseMatrix &other) {
+  *this = Merge(other, -1);
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::MulNumber(const T num) {
+  s21::GetElementwiseKernels<T>().scale(values_.data(), num, values_.size());
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::MulMatrix(const S21BasicSparseMatrix &other) {
+  *this = *this * other;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const {
+  S21BasicSparseMatrix result(*this);
+  std::swap(result.rows_, result.cols_);
+  result.layout_ = layout_ == s21::SparseLayout::kRows
+                       ? s21::SparseLayout::kColumns
+                       : s21::SparseLayout::kRows;
+  return result;
+}
+
+// В CSR каждая строка даёт один элемент результата; в CSC столбец j
+// добавляет x[j], умноженный на столбец, поэтому считается в одном потоке.
+template <typename T>
+std::vector<T> S21BasicSparseMatrix<T>::Multiply(
+    const std::vector<T> &vector) const {
+  if (static_cast<int>(vector.size()) != cols_)
+    throw std::logic_error(
+        "The vector size is not equal to the columns number of the matrix");
+  std::vector<T> result(rows_);
+  if (layout_ == s21::SparseLayout::kColumns) {
+    for (int j = 0; j < cols_; ++j)
+      for (std::size_t k = offsets_[j]; k < offsets_[j + 1]; ++k)
+        result[indices_[k]] += values_[k] * vector[j];
+    return result;
+  }
+  s21::ParallelFor(0, rows_, GrainFor(values_.size(), rows_),
+                   [&](int first, int last) {
+                     for (int i = first; i < last; ++i) {
+                       T sum = 0;
+                       for (std::size_t k = offsets_[i]; k < offsets_[i + 1];
+                            ++k)
+                         sum += values_[k] * vector[indices_[k]];
+                       result[i] = sum;
+                     }
+                   });
+  return result;
+}
+
+// Строка результата i — сумма строк other, взятых с весами из строки i:
+// каждая ненулевая a_ip добавляет a_ip * other[p] векторным ядром.
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::Multiply(
+    const S21BasicMatrix<T> &other) const {
+  if (cols_ != other.GetRows())
+    throw std::logic_error(
+        "The columns number of the first matrix is ​​not equal to the rows "
+        "number of the second matrix");
+  if (layout_ != s21::SparseLayout::kRows)
+    return WithLayout(s21::SparseLayout::kRows).Multiply(other);
+  const int n = other.GetCols();
+  S21BasicMatrix<T> result(rows_, n);
+  const s21::BasicElementwiseKernels<T> &kernels =
+      s21::GetElementwiseKernels<T>();
+  const long work = static_cast<long>(values_.size()) * n;
+  s21::ParallelFor(0, rows_, GrainFor(work, rows_), [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      T *row = result[i];
+      for (std::size_t k = offsets_[i]; k < offsets_[i + 1]; ++k)
+        kernels.add_scaled(row, other[indices_[k]], values_[k], n);
+    }
+  });
+  return result;
+}
+
+// Элемент other[i][p] рассыпается по строке p этой матрицы в строку i
+// результата; нули other пропускаются.
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::MultiplyLeft(
+    const S21BasicMatrix<T> &other) const {
+  if (other.GetCols() != rows_)
+    throw std::logic_error(
+        "The columns number of the first matrix is ​​not equal to the rows "
+        "number of the second matrix");
+  if (layout_ != s21::SparseLayout::kRows)
+    return WithLayout(s21::SparseLayout::kRows).MultiplyLeft(other);
+  const int m = other.GetRows();
+  S21BasicMatrix<T> result(m, cols_);
+  const long work = static_cast<long>(m) * (rows_ + values_.size());
+  s21::ParallelFor(0, m, GrainFor(work, m), [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      const T *row = other[i];
+      T *result_row = result[i];
+      for (int p = 0; p < rows_; ++p) {
+        const T factor = row[p];
+        if (factor == 0) continue;
+        for (std::size_t k = offsets_[p]; k < offsets_[p + 1]; ++k)
+          result_row[indices_[k]] += factor * values_[k];
+      }
+    }
+  });
+  return result;
+}
+
+template <typename T>
+T S21BasicSparseMatrix<T>::operator()(int row_index, int col_index) const {
+  if (row_index < 0 || col_index < 0 || row_index >= rows_ ||
+      col_index >= cols_)
+    throw std::out_of_range("Index is out of range");
+  const bool by_rows = layout_ == s21::SparseLayout::kRows;
+  int line = by_rows ? row_index : col_index;
+  int index = by_rows ? col_index : row_index;
+  auto begin = indices_.begin() + offsets_[line];
+  auto end = indices_.begin() + offsets_[line + 1];
+  auto found = std::lower_bound(begin, end, index);
+  if (found == end || *found != index) return 0;
+  return values_[found - indices_.begin()];
+}
+
+template <typename T>
+bool S21BasicSparseMatrix<T>::operator==(
+    const S21BasicSparseMatrix &other) const {
+  return EqMatrix(other);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator+(
+    const S21BasicSparseMatrix &other) const {
+  return Merge(other, 1);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator-(
+    const S21BasicSparseMatrix &other) const {
+  return Merge(other, -1);
+}
+
+// Алгоритм Густавсона в два прохода. Первый считает число различных
+// столбцов в каждой строке результата по меткам, второй копит строку в
+// плотном аккумуляторе и записывает её по возрастанию столбцов.
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicSparseMatrix &other) const {
+  if (cols_ != other.rows_)
+    throw std::logic_error(
+        "The columns number of the first matrix is ​​not equal to the rows "
+        "number of the second matrix");
+  if (layout_ != s21::SparseLayout::kRows)
+    return WithLayout(s21::SparseLayout::kRows) * other;
+  if (other.layout_ != s21::SparseLayout::kRows)
+    return *this * other.WithLayout(s21::SparseLayout::kRows);
+  const int n = other.cols_;
+  S21BasicSparseMatrix result(rows_, n);
+  long work = 0;
+  for (int p : indices_)
+    work += other.offsets_[p + 1] - other.offsets_[p];
+  const int grain = GrainFor(work, rows_);
+  s21::ParallelFor(0, rows_, grain, [&](int first, int last) {
+    std::vector<int> marker(n, -1);
+    for (int i = first; i < last; ++i) {
+      std::size_t count = 0;
+      for (std::size_t k = offsets_[i]; k < offsets_[i + 1]; ++k) {
+        int p = indices_[k];
+        for (std::size_t q = other.offsets_[p]; q < other.offsets_[p + 1];
+             ++q) {
+          int j = other.indices_[q];
+          if (marker[j] == i) continue;
+          marker[j] = i;
+          ++count;
+        }
+      }
+      result.offsets_[i + 1] = count;
+    }
+  });
+  PrefixSum(result.offsets_);
+  result.indices_.resize(result.offsets_[rows_]);
+  result.values_.resize(result.offsets_[rows_]);
+  s21::ParallelFor(0, rows_, grain, [&](int first, int last) {
+    std::vector<int> marker(n, -1);
+    std::vector<T> accumulator(n);
+    for (int i = first; i < last; ++i) {
+      int *columns = result.indices_.data() + result.offsets_[i];
+      std::size_t count = 0;
+      for (std::size_t k = offsets_[i]; k < offsets_[i + 1]; ++k) {
+        int p = indices_[k];
+        const T factor = values_[k];
+        for (std::size_t q = other.offsets_[p]; q < other.offsets_[p + 1];
+             ++q) {
+          int j = other.indices_[q];
+          if (marker[j] != i) {
+            marker[j] = i;
+            accumulator[j] = 0;
+            columns[count++] = j;
+          }
+          accumulator[j] += factor * other.values_[q];
+        }
+      }
+      std::sort(columns, columns + count);
+      T *values = result.values_.data() + result.offsets_[i];
+      for (std::size_t k = 0; k < count; ++k)
+        values[k] = accumulator[columns[k]];
+    }
+  });
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const T num) const {
+  S21BasicSparseMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrix<T> &other) const {
+  return Multiply(other);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator+=(
+    const S21BasicSparseMatrix &other) {
+  SumMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator-=(
+    const S21BasicSparseMatrix &other) {
+  SubMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator*=(
+    const S21BasicSparseMatrix &other) {
+  MulMatrix(other);
+  return *this;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> &S21BasicSparseMatrix<T>::operator*=(const T num) {
+  MulNumber(num);
+  return *this;
+}
+
+template class S21BasicSparseMatrix<float>;
+template class S21BasicSparseMatrix<double>;
+template class S21BasicSparseMatrix<long double>;
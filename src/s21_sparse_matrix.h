@@ -0,0 +1,160 @@
+#ifndef S21_SPARSE_MATRIX
+#define S21_SPARSE_MATRIX
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace s21 {
+
+// Как сжаты элементы: по строкам (CSR) или по столбцам (CSC).
+enum class SparseLayout { kRows, kColumns };
+
+}  // namespace s21
+
+// Разреженная матрица: хранятся только ненулевые элементы, сжатые по
+// строкам (CSR) или по столбцам (CSC). Строка (столбец) line занимает
+// [offsets[line], offsets[line + 1]) в indices и values, индексы внутри
+// неё возрастают. Матрица в CSR — это её транспонированная в CSC с теми же
+// массивами, поэтому Transpose() только копирует массивы.
+//
+// Операции с плотной матрицей идут разреженным путём и возвращают
+// S21BasicMatrix: стоимость пропорциональна числу ненулевых элементов, а не
+// n * m. Сложение и умножение двух разреженных дают разреженную. Операнды в
+// CSC перед умножением и сложением переупаковываются в CSR за O(nnz).
+template <typename T>
+class S21BasicSparseMatrix {
+ public:
+  typedef T Scalar;
+
+  // Элемент для сборки матрицы; повторы одной позиции суммируются.
+  struct Entry {
+    int row, col;
+    T value;
+  };
+
+ private:
+  int rows_, cols_;
+  s21::SparseLayout layout_;
+  std::vector<std::size_t> offsets_;  //начала строк (столбцов), lines + 1
+  std::vector<int> indices_;  //столбцы (строки) элементов по возрастанию
+  std::vector<T> values_;
+
+  int Lines() const;  //число сжатых строк или столбцов
+  int LineSize() const;  //длина одной строки или столбца
+  void CheckSize(const S21BasicSparseMatrix &other) const;
+  const S21BasicSparseMatrix &InRows(
+      S21BasicSparseMatrix &storage) const;  //эта же или копия в CSR
+  S21BasicSparseMatrix Merge(const S21BasicSparseMatrix &other,
+                             T factor) const;  //this + factor * other
+
+ public:
+  S21BasicSparseMatrix();                                //пустая 0 x 0
+  S21BasicSparseMatrix(int rows, int cols);              //нулевая матрица
+  S21BasicSparseMatrix(int rows, int cols, const std::vector<Entry> &entries,
+                       s21::SparseLayout layout = s21::SparseLayout::kRows);
+  explicit S21BasicSparseMatrix(
+      const S21BasicMatrix<T> &dense,
+      s21::SparseLayout layout = s21::SparseLayout::kRows);  //без нулей
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  s21::SparseLayout GetLayout() const { return layout_; }
+  std::size_t GetNonZeros() const { return values_.size(); }
+  const std::vector<std::size_t> &GetOffsets() const { return offsets_; }
+  const std::vector<int> &GetIndices() const { return indices_; }
+  const std::vector<T> &GetValues() const { return values_; }
+
+  S21BasicSparseMatrix WithLayout(
+      s21::SparseLayout layout) const;  //переупаковка за O(nnz)
+  S21BasicMatrix<T> ToDense() const;    //плотная копия
+
+  bool EqMatrix(const S21BasicSparseMatrix &other) const;  //с учётом нулей
+  void SumMatrix(const S21BasicSparseMatrix &other);
+  void SubMatrix(const S21BasicSparseMatrix &other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicSparseMatrix &other);
+  S21BasicSparseMatrix Transpose() const;  //те же массивы, другое сжатие
+
+  std::vector<T> Multiply(const std::vector<T> &vector) const;  //A * x
+  S21BasicMatrix<T> Multiply(
+      const S21BasicMatrix<T> &other) const;  //this * плотная
+  S21BasicMatrix<T> MultiplyLeft(
+      const S21BasicMatrix<T> &other) const;  //плотная * this
+  void AddTo(S21BasicMatrix<T> &dense,
+             T factor) const;  //dense += factor * this на месте
+
+  T operator()(int row_index, int col_index) const;
+  bool operator==(const S21BasicSparseMatrix &other) const;
+  S21BasicSparseMatrix operator+(const S21BasicSparseMatrix &other) const;
+  S21BasicSparseMatrix operator-(const S21BasicSparseMatrix &other) const;
+  S21BasicSparseMatrix operator*(const S21BasicSparseMatrix &other) const;
+  S21BasicSparseMatrix operator*(const T num) const;
+  S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &other) const;
+  S21BasicSparseMatrix &operator+=(const S21BasicSparseMatrix &other);
+  S21BasicSparseMatrix &operator-=(const S21BasicSparseMatrix &other);
+  S21BasicSparseMatrix &operator*=(const S21BasicSparseMatrix &other);
+  S21BasicSparseMatrix &operator*=(const T num);
+};
+
+typedef S21BasicSparseMatrix<double> S21SparseMatrix;
+typedef S21BasicSparseMatrix<float> S21SparseMatrixF;
+typedef S21BasicSparseMatrix<long double> S21SparseMatrixLD;
+
+extern template class S21BasicSparseMatrix<float>;
+extern template class S21BasicSparseMatrix<double>;
+extern template class S21BasicSparseMatrix<long double>;
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T> &lhs,
+                            const S21BasicSparseMatrix<T> &rhs) {
+  return rhs.MultiplyLeft(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator+(const S21BasicMatrix<T> &lhs,
+                            const S21BasicSparseMatrix<T> &rhs) {
+  S21BasicMatrix<T> result(lhs);
+  rhs.AddTo(result, 1);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> operator+(const S21BasicSparseMatrix<T> &lhs,
+                            const S21BasicMatrix<T> &rhs) {
+  return rhs + lhs;
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(const S21BasicMatrix<T> &lhs,
+                            const S21BasicSparseMatrix<T> &rhs) {
+  S21BasicMatrix<T> result(lhs);
+  rhs.AddTo(result, -1);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(const S21BasicSparseMatrix<T> &lhs,
+                            const S21BasicMatrix<T> &rhs) {
+  S21BasicMatrix<T> result = rhs * T(-1);
+  lhs.AddTo(result, 1);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> &operator+=(S21BasicMatrix<T> &lhs,
+                              const S21BasicSparseMatrix<T> &rhs) {
+  rhs.AddTo(lhs, 1);
+  return lhs;
+}
+
+template <typename T>
+S21BasicMatrix<T> &operator-=(S21BasicMatrix<T> &lhs,
+                              const S21BasicSparseMatrix<T> &rhs) {
+  rhs.AddTo(lhs, -1);
+  return lhs;
+}
+
+#endif
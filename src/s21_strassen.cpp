@@ -0,0 +1,218 @@
+#include "s21_strassen.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_parallel.h"
+#include "s21_profile.h"
+
+namespace s21 {
+namespace {
+
+// Ниже этого числа элементов сложение блоков не делится между потоками.
+constexpr long kParallelElements = 1L << 16;
+
+// Уровней рекурсии: размеры делятся пополам, пока все больше порога.
+int Depth(int m, int n, int k, int crossover) {
+  int depth = 0;
+  while (std::min({m, n, k}) > crossover) {
+    m = (m + 1) / 2;
+    n = (n + 1) / 2;
+    k = (k + 1) / 2;
+    ++depth;
+  }
+  return depth;
+}
+
+int PadTo(int size, int depth) {
+  const int block = 1 << depth;
+  return (size + block - 1) / block * block;
+}
+
+// Временные блоки всех уровней рекурсии для дополненных размеров.
+std::size_t LevelWorkspace(int m, int n, int k, int depth) {
+  std::size_t total = 0;
+  for (; depth > 0; --depth) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    total += static_cast<std::size_t>(m) * std::max(k, n) +
+             static_cast<std::size_t>(k) * n;
+  }
+  return total;
+}
+
+// z = x + y или z = x - y для блоков rows x cols; z может совпадать с x
+// или y.
+template <typename T>
+void Combine(int rows, int cols, const T *x, int ldx, const T *y, int ldy,
+             bool subtract, T *z, int ldz) {
+  const int grain = static_cast<int>(kParallelElements / cols + 1);
+  ParallelFor(0, rows, grain, [&](int first, int last) {
+    for (int i = first; i < last; ++i) {
+      const T *x_row = x + static_cast<std::size_t>(i) * ldx;
+      const T *y_row = y + static_cast<std::size_t>(i) * ldy;
+      T *z_row = z + static_cast<std::size_t>(i) * ldz;
+      if (subtract)
+        for (int j = 0; j < cols; ++j) z_row[j] = x_row[j] - y_row[j];
+      else
+        for (int j = 0; j < cols; ++j) z_row[j] = x_row[j] + y_row[j];
+    }
+  });
+}
+
+// C = A * B для размеров, кратных 2^depth. Порядок шагов — схема с двумя
+// временными блоками: X (m/2 x max(k/2, n/2)) для сумм блоков A и
+// произведения P1, Y (k/2 x n/2) для сумм блоков B; остальные
+// промежуточные значения живут в четвертях C. work — блоки X и Y этого
+// уровня, за ними — память следующих.
+template <typename T>
+void Winograd(int m, int n, int k, const T *a, int lda, const T *b, int ldb,
+              T *c, int ldc, int depth, T *work) {
+  if (depth == 0) {
+    Gemm(m, n, k, T(1), a, lda, b, ldb, T(0), c, ldc);
+    return;
+  }
+  const int mh = m / 2, nh = n / 2, kh = k / 2, next = depth - 1;
+  const T *a11 = a, *a12 = a + kh;
+  const T *a21 = a + static_cast<std::size_t>(mh) * lda, *a22 = a21 + kh;
+  const T *b11 = b, *b12 = b + nh;
+  const T *b21 = b + static_cast<std::size_t>(kh) * ldb, *b22 = b21 + nh;
+  T *c11 = c, *c12 = c + nh;
+  T *c21 = c + static_cast<std::size_t>(mh) * ldc, *c22 = c21 + nh;
+  const int ldx = std::max(kh, nh), ldy = nh;
+  T *x = work, *y = x + static_cast<std::size_t>(mh) * ldx;
+  T *rest = y + static_cast<std::size_t>(kh) * ldy;
+
+  Combine(mh, kh, a11, lda, a21, lda, true, x, ldx);  //S3
+  Combine(kh, nh, b22, ldb, b12, ldb, true, y, ldy);  //T3
+  Winograd(mh, nh, kh, x, ldx, y, ldy, c21, ldc, next, rest);  //P7
+  Combine(mh, kh, a21, lda, a22, lda, false, x, ldx);  //S1
+  Combine(kh, nh, b12, ldb, b11, ldb, true, y, ldy);   //T1
+  Winograd(mh, nh, kh, x, ldx, y, ldy, c22, ldc, next, rest);  //P5
+  Combine(mh, kh, x, ldx, a11, lda, true, x, ldx);  //S2 = S1 - A11
+  Combine(kh, nh, b22, ldb, y, ldy, true, y, ldy);  //T2 = B22 - T1
+  Winograd(mh, nh, kh, x, ldx, y, ldy, c12, ldc, next, rest);  //P6
+  Combine(mh, kh, a12, lda, x, ldx, true, x, ldx);  //S4 = A12 - S2
+  Winograd(mh, nh, kh, x, ldx, b22, ldb, c11, ldc, next, rest);    //P3
+  Winograd(mh, nh, kh, a11, lda, b11, ldb, x, ldx, next, rest);    //P1
+  Combine(mh, nh, x, ldx, c12, ldc, false, c12, ldc);    //U2 = P1 + P6
+  Combine(mh, nh, c12, ldc, c21, ldc, false, c21, ldc);  //U3 = U2 + P7
+  Combine(mh, nh, c12, ldc, c22, ldc, false, c12, ldc);  //U4 = U2 + P5
+  Combine(mh, nh, c21, ldc, c22, ldc, false, c22, ldc);  //C22 = U3 + P5
+  Combine(mh, nh, c12, ldc, c11, ldc, false, c12, ldc);  //C12 = U4 + P3
+  Combine(kh, nh, y, ldy, b21, ldb, true, y, ldy);       //T4 = T2 - B21
+  Winograd(mh, nh, kh, a22, lda, y, ldy, c11, ldc, next, rest);  //P4
+  Combine(mh, nh, c21, ldc, c11, ldc, true, c21, ldc);  //C21 = U3 - P4
+  Winograd(mh, nh, kh, a12, lda, b21, ldb, c11, ldc, next, rest);  //P2
+  Combine(mh, nh, x, ldx, c11, ldc, false, c11, ldc);  //C11 = P1 + P2
+}
+
+template <typename T>
+void CopyBlock(int rows, int cols, const T *src, int lds, T *dst, int ldd) {
+  for (int i = 0; i < rows; ++i)
+    std::copy(src + static_cast<std::size_t>(i) * lds,
+              src + static_cast<std::size_t>(i) * lds + cols,
+              dst + static_cast<std::size_t>(i) * ldd);
+}
+
+template <typename T>
+void WinogradGemm(int m, int n, int k, const T *a, int lda, const T *b,
+                  int ldb, T *c, int ldc, int crossover) {
+  if (m <= 0 || n <= 0) return;
+  crossover = std::max(crossover, 1);
+  const int depth = k > 0 ? Depth(m, n, k, crossover) : 0;
+  if (depth == 0) {
+    Gemm(m, n, k, T(1), a, lda, b, ldb, T(0), c, ldc);
+    return;
+  }
+  // Дополнение нулями: копии операндов и результата лежат в начале
+  // рабочей памяти, временные блоки рекурсии — за ними.
+  const int pm = PadTo(m, depth), pn = PadTo(n, depth), pk = PadTo(k, depth);
+  std::vector<T> workspace(StrassenWorkspace(m, n, k, crossover));
+  T *spare = workspace.data();
+  if (pm != m || pk != k) {
+    CopyBlock(m, k, a, lda, spare, pk);
+    a = spare;
+    lda = pk;
+    spare += static_cast<std::size_t>(pm) * pk;
+  }
+  if (pk != k || pn != n) {
+    CopyBlock(k, n, b, ldb, spare, pn);
+    b = spare;
+    ldb = pn;
+    spare += static_cast<std::size_t>(pk) * pn;
+  }
+  T *result = c;
+  int ldr = ldc;
+  if (pm != m || pn != n) {
+    result = spare;
+    ldr = pn;
+    spare += static_cast<std::size_t>(pm) * pn;
+  }
+  Winograd(pm, pn, pk, a, lda, b, ldb, result, ldr, depth, spare);
+  if (result != c) CopyBlock(m, n, result, ldr, c, ldc);
+}
+
+}  // namespace
+
+void StrassenGemm(int m, int n, int k, const float *a, int lda,
+                  const float *b, int ldb, float *c, int ldc, int crossover) {
+  WinogradGemm(m, n, k, a, lda, b, ldb, c, ldc, crossover);
+}
+
+void StrassenGemm(int m, int n, int k, const double *a, int lda,
+                  const double *b, int ldb, double *c, int ldc,
+                  int crossover) {
+  WinogradGemm(m, n, k, a, lda, b, ldb, c, ldc, crossover);
+}
+
+void StrassenGemm(int m, int n, int k, const long double *a, int lda,
+                  const long double *b, int ldb, long double *c, int ldc,
+                  int crossover) {
+  WinogradGemm(m, n, k, a, lda, b, ldb, c, ldc, crossover);
+}
+
+std::size_t StrassenWorkspace(int m, int n, int k, int crossover) {
+  if (m <= 0 || n <= 0 || k <= 0) return 0;
+  const int depth = Depth(m, n, k, std::max(crossover, 1));
+  if (depth == 0) return 0;
+  const int pm = PadTo(m, depth), pn = PadTo(n, depth), pk = PadTo(k, depth);
+  std::size_t total = LevelWorkspace(pm, pn, pk, depth);
+  if (pm != m || pk != k) total += static_cast<std::size_t>(pm) * pk;
+  if (pk != k || pn != n) total += static_cast<std::size_t>(pk) * pn;
+  if (pm != m || pn != n) total += static_cast<std::size_t>(pm) * pn;
+  return total;
+}
+
+template <typename T>
+S21BasicMatrix<T> StrassenMultiply(const S21BasicMatrix<T> &a,
+                                   const S21BasicMatrix<T> &b,
+                                   int crossover) {
+  if (a.GetCols() != b.GetRows())
+    throw std::logic_error(
+        "The columns number of the first matrix is not equal to the rows "
+        "number of the second matrix");
+  if (crossover < 1)
+    throw std::invalid_argument("Crossover size must be positive");
+  S21_PROFILE_OPERATION(s21::Operation::kMulMatrix,
+                        2.0 * a.GetRows() * b.GetCols() * a.GetCols());
+  S21BasicMatrix<T> result(a.GetRows(), b.GetCols());
+  StrassenGemm(a.GetRows(), b.GetCols(), a.GetCols(), a.GetData(),
+               a.GetStride(), b.GetData(), b.GetStride(), result.GetData(),
+               result.GetStride(), crossover);
+  return result;
+}
+
+template S21BasicMatrix<float> StrassenMultiply(const S21BasicMatrix<float> &,
+                                                const S21BasicMatrix<float> &,
+                                                int);
+template S21BasicMatrix<double> StrassenMultiply(
+    const S21BasicMatrix<double> &, const S21BasicMatrix<double> &, int);
+template S21BasicMatrix<long double> StrassenMultiply(
+    const S21BasicMatrix<long double> &, const S21BasicMatrix<long double> &,
+    int);
+
+}  // namespace s21
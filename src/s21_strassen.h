@@ -0,0 +1,54 @@
+#ifndef S21_STRASSEN
+#define S21_STRASSEN
+
+#include <cstddef>
+
+#include "s21_matrix_oop.h"
+
+// Умножение по схеме Штрассена–Винограда: 7 произведений половинных
+// блоков и 15 сложений вместо 8 произведений, так что число операций
+// растёт как n^2.81 вместо n^3. Блоки делятся пополам, пока все три
+// размера произведения больше порога crossover, дальше перемножаются
+// классическим Gemm. Размеры дополняются нулями до кратных 2^глубины,
+// поэтому подходит любая форма, но выигрыш есть только у больших и
+// близких к квадрату произведений.
+//
+// Рабочая память — два временных блока на каждом уровне рекурсии, вместе
+// не больше (m * max(k, n) + k * n) / 3 элементов, и копии операндов
+// и результата, если размеры пришлось дополнять.
+//
+// Погрешность оценивается только по норме: max|C - AB| растёт с глубиной
+// рекурсии как max|A| * max|B| * eps, а не поэлементно, как у
+// классического умножения. Элементы C, много меньшие произведения норм,
+// теряют относительную точность; для таких матриц нужен MulMatrix.
+namespace s21 {
+
+// Порог по умолчанию: с меньшим сложения блоков съедают выигрыш, на
+// матрицах 4096 Штрассен быстрее Gemm примерно на 20%.
+constexpr int kStrassenCrossover = 1024;
+
+// C = A * B для матриц, хранящихся построчно: A — m x k с шагом lda,
+// B — k x n с шагом ldb, C — m x n с шагом ldc. Порог меньше 1
+// считается равным 1.
+void StrassenGemm(int m, int n, int k, const float *a, int lda,
+                  const float *b, int ldb, float *c, int ldc, int crossover);
+void StrassenGemm(int m, int n, int k, const double *a, int lda,
+                  const double *b, int ldb, double *c, int ldc,
+                  int crossover);
+void StrassenGemm(int m, int n, int k, const long double *a, int lda,
+                  const long double *b, int ldb, long double *c, int ldc,
+                  int crossover);
+
+// Рабочая память StrassenGemm в элементах, с копиями для дополнения.
+std::size_t StrassenWorkspace(int m, int n, int k, int crossover);
+
+// a * b по Штрассену–Винограду. Несовпадение размеров —
+// std::logic_error, порог меньше 1 — std::invalid_argument.
+template <typename T>
+S21BasicMatrix<T> StrassenMultiply(const S21BasicMatrix<T> &a,
+                                   const S21BasicMatrix<T> &b,
+                                   int crossover = kStrassenCrossover);
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,246 @@
+#include "s21_transpose.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_cpu.h"
+#include "s21_parallel.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define S21_TRANSPOSE_X86_DISPATCH 1
+#endif
+
+namespace s21 {
+namespace {
+
+// Плитка 32 x 32 double (8 КБ) вместе с плиткой результата помещается в L1;
+// для float и long double размер тот же, чтобы не плодить варианты.
+constexpr int kTile = 32;
+constexpr int kMicro = 4;
+
+// Четыре элемента в регистре и маска перестановки той же ширины: целые
+// того же размера, что и T.
+template <typename T>
+struct Quad {
+  typedef T Vec __attribute__((vector_size(4 * sizeof(T))));
+  typedef decltype(Vec() != Vec()) Mask;
+};
+
+#define S21_TRANSPOSE_BODY inline __attribute__((always_inline))
+
+// Блок 4 x 4 из src транспонируется в регистрах и пишется в dst. Сначала
+// читаются все строки, поэтому dst может совпадать с src. Для long double
+// векторных типов нет, блок переставляется через локальную копию.
+template <typename T>
+S21_TRANSPOSE_BODY void Micro4(const T *src, std::size_t lds, T *dst,
+                               std::size_t ldd) {
+  if constexpr (std::is_same<T, long double>::value) {
+    T block[kMicro][kMicro];
+    for (int r = 0; r < kMicro; ++r)
+      for (int c = 0; c < kMicro; ++c) block[c][r] = src[r * lds + c];
+    for (int r = 0; r < kMicro; ++r)
+      std::memcpy(dst + r * ldd, block[r], kMicro * sizeof(T));
+  } else {
+    typedef typename Quad<T>::Vec Vec4;
+    typedef typename Quad<T>::Mask Mask4;
+    Vec4 r0, r1, r2, r3;
+    std::memcpy(&r0, src, sizeof(Vec4));
+    std::memcpy(&r1, src + lds, sizeof(Vec4));
+    std::memcpy(&r2, src + 2 * lds, sizeof(Vec4));
+    std::memcpy(&r3, src + 3 * lds, sizeof(Vec4));
+    const Mask4 even = {0, 4, 2, 6}, odd = {1, 5, 3, 7};
+    const Mask4 low = {0, 1, 4, 5}, high = {2, 3, 6, 7};
+    Vec4 t0 = __builtin_shuffle(r0, r1, even);  //a0 b0 a2 b2
+    Vec4 t1 = __builtin_shuffle(r0, r1, odd);   //a1 b1 a3 b3
+    Vec4 t2 = __builtin_shuffle(r2, r3, even);  //c0 d0 c2 d2
+    Vec4 t3 = __builtin_shuffle(r2, r3, odd);   //c1 d1 c3 d3
+    Vec4 o0 = __builtin_shuffle(t0, t2, low);
+    Vec4 o1 = __builtin_shuffle(t1, t3, low);
+    Vec4 o2 = __builtin_shuffle(t0, t2, high);
+    Vec4 o3 = __builtin_shuffle(t1, t3, high);
+    std::memcpy(dst, &o0, sizeof(Vec4));
+    std::memcpy(dst + ldd, &o1, sizeof(Vec4));
+    std::memcpy(dst + 2 * ldd, &o2, sizeof(Vec4));
+    std::memcpy(dst + 3 * ldd, &o3, sizeof(Vec4));
+  }
+}
+
+// Обмен блоков 4 x 4 с транспонированием: p = q^T, q = p^T. Для p == q
+// блок просто транспонируется на месте.
+template <typename T>
+S21_TRANSPOSE_BODY void SwapMicro4(T *p, T *q, std::size_t ld) {
+  T block[kMicro * kMicro];
+  Micro4(p, ld, block, kMicro);
+  Micro4(q, ld, p, ld);
+  for (int r = 0; r < kMicro; ++r)
+    std::memcpy(q + r * ld, block + r * kMicro, kMicro * sizeof(T));
+}
+
+// Плитка src [row0, row1) x [col0, col1) в dst.
+template <typename T>
+S21_TRANSPOSE_BODY void TileBody(const T *src, std::size_t lds, T *dst,
+                                 std::size_t ldd, int row0, int row1, int col0,
+                                 int col1) {
+  int row4 = row0 + (row1 - row0) / kMicro * kMicro;
+  int col4 = col0 + (col1 - col0) / kMicro * kMicro;
+  for (int i = row0; i < row4; i += kMicro)
+    for (int j = col0; j < col4; j += kMicro)
+      Micro4(src + i * lds + j, lds, dst + j * ldd + i, ldd);
+  for (int i = row0; i < row1; ++i) {
+    int first_col = i < row4 ? col4 : col0;
+    for (int j = first_col; j < col1; ++j)
+      dst[j * ldd + i] = src[i * lds + j];
+  }
+}
+
+template <typename T>
+S21_TRANSPOSE_BODY void TransposeRowsBody(int rows, const T *src,
+                                          std::size_t lds, T *dst,
+                                          std::size_t ldd, int col_first,
+                                          int col_last) {
+  for (int col0 = col_first; col0 < col_last; col0 += kTile)
+    for (int row0 = 0; row0 < rows; row0 += kTile)
+      TileBody(src, lds, dst, ldd, row0, std::min(row0 + kTile, rows), col0,
+               std::min(col0 + kTile, col_last));
+}
+
+// Пары плиток (I, J) и (J, I) для J >= I меняются местами с
+// транспонированием; блоки на краях меньше 4 x 4 обмениваются поэлементно.
+template <typename T>
+S21_TRANSPOSE_BODY void SquareRowsBody(int n, T *data, std::size_t ld,
+                                       int tile_first, int tile_last) {
+  int n4 = n / kMicro * kMicro;
+  for (int tile = tile_first; tile < tile_last; ++tile) {
+    int row0 = tile * kTile, row1 = std::min(row0 + kTile, n4);
+    for (int col0 = row0; col0 < n4; col0 += kTile) {
+      int col1 = std::min(col0 + kTile, n4);
+      for (int i = row0; i < row1; i += kMicro)
+        for (int j = std::max(col0, i); j < col1; j += kMicro)
+          SwapMicro4(data + i * ld + j, data + j * ld + i, ld);
+    }
+    for (int i = tile * kTile; i < std::min(tile * kTile + kTile, n); ++i)
+      for (int j = std::max(i + 1, n4); j < n; ++j)
+        std::swap(data[i * ld + j], data[j * ld + i]);
+  }
+}
+
+template <typename T>
+using TransposeRowsFunction = void (*)(int, const T *, std::size_t, T *,
+                                       std::size_t, int, int);
+template <typename T>
+using SquareRowsFunction = void (*)(int, T *, std::size_t, int, int);
+
+template <typename T>
+void TransposeRowsGeneric(int rows, const T *src, std::size_t lds, T *dst,
+                          std::size_t ldd, int col_first, int col_last) {
+  TransposeRowsBody(rows, src, lds, dst, ldd, col_first, col_last);
+}
+
+template <typename T>
+void SquareRowsGeneric(int n, T *data, std::size_t ld, int tile_first,
+                       int tile_last) {
+  SquareRowsBody(n, data, ld, tile_first, tile_last);
+}
+
+#ifdef S21_TRANSPOSE_X86_DISPATCH
+template <typename T>
+__attribute__((target("avx2"))) void TransposeRowsAvx2(
+    int rows, const T *src, std::size_t lds, T *dst, std::size_t ldd,
+    int col_first, int col_last) {
+  TransposeRowsBody(rows, src, lds, dst, ldd, col_first, col_last);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) void SquareRowsAvx2(int n, T *data,
+                                                    std::size_t ld,
+                                                    int tile_first,
+                                                    int tile_last) {
+  SquareRowsBody(n, data, ld, tile_first, tile_last);
+}
+#endif
+
+bool UseAvx2() {
+#ifdef S21_TRANSPOSE_X86_DISPATCH
+  return GetSimdLevel() >= SimdLevel::kAvx2;
+#else
+  return false;
+#endif
+}
+
+template <typename T>
+void TransposeImpl(int rows, int cols, const T *src, int lds, T *dst, int ldd) {
+  if (rows <= 0 || cols <= 0) return;
+  TransposeRowsFunction<T> kernel = TransposeRowsGeneric<T>;
+#ifdef S21_TRANSPOSE_X86_DISPATCH
+  if (UseAvx2()) kernel = TransposeRowsAvx2<T>;
+#endif
+  // Каждый поток пишет свои плиточные строки результата.
+  int tile_cols = (cols + kTile - 1) / kTile;
+  long tile_elements = static_cast<long>(rows) * kTile;
+  int grain = static_cast<int>(kParallelGrain / tile_elements + 1);
+  ParallelFor(0, tile_cols, grain, [&](int first, int last) {
+    kernel(rows, src, lds, dst, ldd, first * kTile,
+           std::min(last * kTile, cols));
+  });
+}
+
+template <typename T>
+void TransposeSquareImpl(int n, T *data, int ld) {
+  if (n <= 1) return;
+  SquareRowsFunction<T> kernel = SquareRowsGeneric<T>;
+#ifdef S21_TRANSPOSE_X86_DISPATCH
+  if (UseAvx2()) kernel = SquareRowsAvx2<T>;
+#endif
+  // Строки плиток делят треугольник неравномерно, но кусков у пула в
+  // несколько раз больше, чем потоков.
+  int tiles = (n + kTile - 1) / kTile;
+  long tile_elements = static_cast<long>(n) * kTile;
+  int grain = static_cast<int>(kParallelGrain / tile_elements + 1);
+  ParallelFor(0, tiles, grain, [&](int first, int last) {
+    kernel(n, data, ld, first, last);
+  });
+}
+
+// Элемент с индексом k = i * cols + j переходит на место j * rows + i.
+// Циклы перестановки обходятся по одному разу, пройденные отмечаются.
+template <typename T>
+void TransposeDenseImpl(int rows, int cols, T *data) {
+  if (rows <= 1 || cols <= 1) return;
+  std::size_t count = static_cast<std::size_t>(rows) * cols;
+  std::vector<bool> visited(count);
+  for (std::size_t start = 1; start + 1 < count; ++start) {
+    if (visited[start]) continue;
+    std::size_t current = start;
+    T carried = data[start];
+    do {
+      std::size_t next = current % cols * rows + current / cols;
+      std::swap(carried, data[next]);
+      visited[next] = true;
+      current = next;
+    } while (current != start);
+  }
+}
+
+}  // namespace
+
+#define S21_DEFINE_TRANSPOSE(T)                                             \
+  void Transpose(int rows, int cols, const T *src, int lds, T *dst,         \
+                 int ldd) {                                                 \
+    TransposeImpl(rows, cols, src, lds, dst, ldd);                          \
+  }                                                                         \
+  void TransposeSquareInPlace(int n, T *data, int ld) {                     \
+    TransposeSquareImpl(n, data, ld);                                       \
+  }                                                                         \
+  void TransposeDenseInPlace(int rows, int cols, T *data) {                 \
+    TransposeDenseImpl(rows, cols, data);                                   \
+  }
+
+S21_DEFINE_TRANSPOSE(float)
+S21_DEFINE_TRANSPOSE(double)
+S21_DEFINE_TRANSPOSE(long double)
+
+}  // namespace s21
@@ -0,0 +1,30 @@
+#ifndef S21_TRANSPOSE
+#define S21_TRANSPOSE
+
+namespace s21 {
+
+// dst = src^T: src — rows x cols с шагом lds, dst — cols x rows с шагом ldd.
+// Матрица обходится плитками, помещающимися в L1, внутри плитки блоки 4x4
+// транспонируются в регистрах (для long double — через локальную копию).
+void Transpose(int rows, int cols, const float *src, int lds, float *dst,
+               int ldd);
+void Transpose(int rows, int cols, const double *src, int lds, double *dst,
+               int ldd);
+void Transpose(int rows, int cols, const long double *src, int lds,
+               long double *dst, int ldd);
+
+// Транспонирует квадратную матрицу n x n с шагом ld на месте.
+void TransposeSquareInPlace(int n, float *data, int ld);
+void TransposeSquareInPlace(int n, double *data, int ld);
+void TransposeSquareInPlace(int n, long double *data, int ld);
+
+// Транспонирует плотную (шаг равен числу столбцов) матрицу rows x cols на
+// месте обходом циклов перестановки: дополнительная память — один бит на
+// элемент.
+void TransposeDenseInPlace(int rows, int cols, float *data);
+void TransposeDenseInPlace(int rows, int cols, double *data);
+void TransposeDenseInPlace(int rows, int cols, long double *data);
+
+}  // namespace s21
+
+#endif
@@ -1,5 +1,34 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "s21_allocator.h"
+#include "s21_cpu.h"
+#include "s21_fixed_matrix.h"
+#include "s21_lu.h"
+#include "s21_maintained_inverse.h"
+#include "s21_matrix_chain.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_io.h"
 #include "s21_matrix_oop.h"
+#include "s21_out_of_core.h"
+#include "s21_parallel.h"
+#include "s21_profile.h"
+#include "s21_sparse_matrix.h"
+#include "s21_strassen.h"
 
 TEST(MatrixConstructorSuite, BasicTest) {
   S21Matrix testMatrix;
@@ -79,6 +108,113 @@ TEST(MatrixConstructorSuite, SetWrongTest) {
   ASSERT_ANY_THROW(testMatrix.SetRows(0));
 }
 
+TEST(MatrixConstructorSuite, ContiguousStorageTest) {
+  S21Matrix testMatrix(3, 100);
+  EXPECT_GE(testMatrix.GetStride(), testMatrix.GetCols());
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(testMatrix.GetData()) % 64, 0u);
+  EXPECT_EQ(testMatrix[1], testMatrix.GetData() + testMatrix.GetStride());
+  EXPECT_DOUBLE_EQ(testMatrix(2, 99), 0.0);
+
+  double **rows = testMatrix.GetMatrix();
+  rows[2][99] = 4.2;
+  EXPECT_DOUBLE_EQ(testMatrix(2, 99), 4.2);
+
+  S21Matrix copy(testMatrix);
+  EXPECT_DOUBLE_EQ(copy(2, 99), 4.2);
+  copy(2, 99) = 1.5;
+  testMatrix = copy;
+  EXPECT_DOUBLE_EQ(testMatrix(2, 99), 1.5);
+
+  double *data = testMatrix.GetData();
+  testMatrix.SetCols(10);
+  EXPECT_EQ(testMatrix.GetData(), data);  //уменьшение на месте
+  testMatrix.SetRows(4);
+  EXPECT_EQ(testMatrix.GetStride(), 104);
+  EXPECT_DOUBLE_EQ(testMatrix(3, 9), 0.0);
+  EXPECT_EQ(testMatrix.GetMatrix()[3], testMatrix[3]);
+  const S21Matrix shared(64, 8);
+  std::atomic<int> same{0};
+  s21::ParallelFor(0, 64, 1, [&](int first, int last) {
+    for (int i = first; i < last; ++i)
+      same += shared.GetMatrix()[i] == shared[i];
+  });
+  EXPECT_EQ(same.load(), 64);
+  testMatrix.ShrinkToFit();
+  EXPECT_EQ(testMatrix.GetStride(), 10);
+  EXPECT_DOUBLE_EQ(testMatrix(2, 9), 0.0);
+}
+
+TEST(MatrixConstructorSuite, CapacityTest) {
+  S21Matrix matrix(1, 3);
+  const double row[] = {1, 2, 3};
+  s21::ResetAllocationStats();
+  for (int i = 1; i < 1000; i++) matrix.AppendRow(row);
+  //запас растёт вдвое: 2, 4, ..., 1024 строк
+  EXPECT_EQ(s21::GetAllocationStats().allocations, 10u);
+  EXPECT_EQ(matrix.GetRows(), 1000);
+  EXPECT_EQ(matrix.GetRowCapacity(), 1024);
+  EXPECT_DOUBLE_EQ(matrix(999, 2), 3);
+  EXPECT_DOUBLE_EQ(matrix(0, 2), 0);
+
+  // Уменьшение и рост в пределах запаса — без выделений, новое обнулено.
+  s21::ResetAllocationStats();
+  matrix.SetRows(10);
+  matrix.SetCols(2);
+  matrix.SetCols(3);
+  matrix.SetRows(20);
+  EXPECT_EQ(s21::GetAllocationStats().allocations, 0u);
+  EXPECT_DOUBLE_EQ(matrix(5, 2), 0);
+  EXPECT_DOUBLE_EQ(matrix(15, 0), 0);
+  EXPECT_DOUBLE_EQ(matrix(5, 1), 2);
+
+  matrix.Reserve(2000, 70);
+  EXPECT_EQ(matrix.GetRowCapacity(), 2000);
+  EXPECT_GE(matrix.GetColCapacity(), 70);
+  EXPECT_DOUBLE_EQ(matrix(5, 1), 2);
+  s21::ResetAllocationStats();
+  matrix.SetCols(70);
+  matrix.SetRows(2000);
+  EXPECT_EQ(s21::GetAllocationStats().allocations, 0u);
+  EXPECT_DOUBLE_EQ(matrix(1999, 69), 0);
+  EXPECT_DOUBLE_EQ(matrix(5, 69), 0);
+  matrix.SetCols(matrix.GetColCapacity() + 1);
+  EXPECT_EQ(s21::GetAllocationStats().allocations, 1u);
+  EXPECT_GE(matrix.GetColCapacity(), 140);
+  matrix.SetRows(3);
+  matrix.ShrinkToFit();
+  EXPECT_EQ(matrix.GetRowCapacity(), 3);
+  EXPECT_EQ(matrix.GetColCapacity(), matrix.GetStride());
+  EXPECT_DOUBLE_EQ(matrix(2, 1), 2);
+
+  S21Matrix empty;
+  EXPECT_ANY_THROW(empty.AppendRow(row));
+  EXPECT_ANY_THROW(empty.Reserve(2, 0));
+  EXPECT_ANY_THROW(matrix.Reserve(-1, 2));
+
+  // Поток строк с нуля: пустая матрица после Reserve — 0 x 3.
+  S21Matrix stream;
+  stream.Reserve(100, 3);
+  EXPECT_EQ(stream.GetRows(), 0);
+  EXPECT_EQ(stream.GetCols(), 3);
+  EXPECT_EQ(stream.GetRowCapacity(), 100);
+  EXPECT_FALSE(stream == S21Matrix());
+  EXPECT_EQ(S21MatrixF(stream).GetCols(), 3);
+  s21::ResetAllocationStats();
+  for (int i = 0; i < 100; i++) stream.AppendRow(row);
+  EXPECT_EQ(s21::GetAllocationStats().allocations, 0u);
+  EXPECT_EQ(stream.GetRows(), 100);
+  EXPECT_DOUBLE_EQ(stream(99, 2), 3);
+  S21Matrix unreserved;
+  unreserved.Reserve(0, 3);
+  unreserved.AppendRow(row);
+  EXPECT_DOUBLE_EQ(unreserved(0, 1), 2);
+  S21Matrix no_rows;
+  no_rows.Reserve(4, 3);
+  EXPECT_EQ(no_rows.Transpose().GetRows(), 0);
+  no_rows.TransposeInPlace();
+  EXPECT_EQ(no_rows.GetCols(), 0);
+}
+
 TEST(MatrixArithmeticSuite, EqualTest) {
   S21Matrix testMatrix;
   S21Matrix testMatrix2;
@@ -93,6 +229,57 @@ TEST(MatrixArithmeticSuite, NotEqualTest) {
   EXPECT_FALSE(testMatrix == testMatrix2);
 }
 
+TEST(MatrixArithmeticSuite, ToleranceEqualTest) {
+  S21Matrix matrix(5, 5), identity(5, 5);
+  for (int i = 0; i < 5; i++) {
+    identity(i, i) = 1;
+    for (int j = 0; j < 5; j++) matrix(i, j) = (i == j) * 4 + std::sin(i + j);
+  }
+  S21Matrix product = matrix * matrix.InverseMatrix();
+  EXPECT_TRUE(product.EqMatrix(identity, 1e-12));
+  EXPECT_FALSE(product.EqMatrix(identity, 0, 1e-12));  //нули вне диагонали
+
+  S21Matrix large(1, 67), shifted(1, 67);  //бесконечность в векторной части
+  large(0, 0) = shifted(0, 0) = INFINITY;
+  large(0, 40) = 1e6;
+  shifted(0, 40) = 1e6 + 1e-4;
+  EXPECT_FALSE(large.EqMatrix(shifted, 1e-9));
+  EXPECT_TRUE(large.EqMatrix(shifted, 0, 1e-9));
+  EXPECT_TRUE(large.EqMatrix(shifted, 1e-9, 1e-9));
+  shifted(0, 0) = -INFINITY;
+  EXPECT_FALSE(large.EqMatrix(shifted, 1e-9, 1e-9));
+  shifted(0, 0) = large(0, 0) = NAN;
+  EXPECT_FALSE(large.EqMatrix(shifted, 1e6, 1));
+  EXPECT_FALSE(large.EqMatrix(S21Matrix(67, 1), 1));
+  EXPECT_THROW(large.EqMatrix(shifted, -1), std::invalid_argument);
+  S21MatrixF single(product), single_identity(identity);
+  EXPECT_TRUE(single.EqMatrix(single_identity, 1e-5f));
+}
+
+TEST(MatrixArithmeticSuite, HashTest) {
+  S21Matrix matrix(6, 70), copy;
+  for (int i = 0; i < 6; i++)
+    for (int j = 0; j < 70; j++) matrix(i, j) = std::sin(i * 70 + j);
+  copy = matrix;
+  EXPECT_EQ(matrix.Hash(), copy.Hash());
+  copy.Reserve(6, 150);  //другой шаг строк
+  EXPECT_EQ(matrix.Hash(), copy.Hash());
+  copy(5, 69) += 1e-12;
+  EXPECT_NE(matrix.Hash(), copy.Hash());
+  EXPECT_EQ(matrix.Hash(1e-6), copy.Hash(1e-6));
+  EXPECT_NE(matrix.Hash(1e-6), matrix.Transpose().Hash(1e-6));
+  EXPECT_NE(S21Matrix(2, 3).Hash(), S21Matrix(3, 2).Hash());
+  S21Matrix zero(1, 1), negative_zero(1, 1);
+  negative_zero(0, 0) = -0.0;
+  EXPECT_EQ(zero.Hash(), negative_zero.Hash());
+  EXPECT_THROW(matrix.Hash(-1), std::invalid_argument);
+
+  std::unordered_set<S21Matrix> unique = {matrix, copy, matrix, zero,
+                                          negative_zero};
+  EXPECT_EQ(unique.size(), 3u);
+  EXPECT_EQ(S21MatrixLD(zero).Hash(), S21MatrixLD(negative_zero).Hash());
+}
+
 TEST(MatrixArithmeticSuite, NotEqualColCountTest) {
   S21Matrix testMatrix(2, 2);
   S21Matrix testMatrix2(2, 3);
@@ -161,6 +348,74 @@ TEST(MatrixArithmeticSuite, MulMatrixErrorTest) {
   ASSERT_ANY_THROW(testMatrix.MulMatrix(testMatrix2));
 }
 
+TEST(MatrixArithmeticSuite, MulMatrixBlockedTest) {
+  const int rows = 131, inner = 300, cols = 263;
+  S21Matrix testMatrix(rows, inner);
+  S21Matrix testMatrix2(inner, cols);
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < inner; j++) testMatrix[i][j] = (i * 7 + j * 3) % 11 - 5;
+  for (int i = 0; i < inner; i++)
+    for (int j = 0; j < cols; j++) testMatrix2[i][j] = (i * 5 + j) % 9 - 4;
+
+  S21Matrix result = testMatrix * testMatrix2;
+  ASSERT_EQ(result.GetRows(), rows);
+  ASSERT_EQ(result.GetCols(), cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      double expected = 0;
+      for (int k = 0; k < inner; k++)
+        expected += testMatrix(i, k) * testMatrix2(k, j);
+      ASSERT_DOUBLE_EQ(result(i, j), expected);
+    }
+  }
+
+  testMatrix.MulMatrix(testMatrix2);
+  EXPECT_TRUE(testMatrix == result);
+}
+
+TEST(MatrixArithmeticSuite, SimdLevelsTest) {
+  const int rows = 7, cols = 67;
+  S21Matrix base(rows, cols), other(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      base[i][j] = i * 0.5 - j * 0.25;
+      other[i][j] = (i * j) % 5 - 2.0;
+    }
+  }
+  const s21::SimdLevel levels[] = {s21::SimdLevel::kScalar,
+                                   s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2,
+                                   s21::SimdLevel::kAvx512};
+  for (s21::SimdLevel level : levels) {
+    s21::SetSimdLevelLimit(level);
+    S21Matrix sum(base), difference(base), scaled(base), fused(base);
+    sum.SumMatrix(other);
+    difference.SubMatrix(other);
+    scaled.MulNumber(-1.5);
+    fused.SumScaledMatrix(other, 3.0);
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) {
+        ASSERT_DOUBLE_EQ(sum(i, j), base(i, j) + other(i, j));
+        ASSERT_DOUBLE_EQ(difference(i, j), base(i, j) - other(i, j));
+        ASSERT_DOUBLE_EQ(scaled(i, j), base(i, j) * -1.5);
+        ASSERT_DOUBLE_EQ(fused(i, j), base(i, j) + other(i, j) * 3.0);
+      }
+    }
+    S21Matrix copy(base);
+    EXPECT_TRUE(copy == base);
+    copy[rows - 1][cols - 1] += 1e-12;
+    EXPECT_FALSE(copy == base);
+    EXPECT_TRUE(copy.EqMatrix(base, 1e-9));
+    EXPECT_FALSE(copy.EqMatrix(base, 1e-13));
+    EXPECT_TRUE(copy.EqMatrix(base, 0, 1e-9));
+    copy = base;
+    copy[0][0] = NAN;
+    EXPECT_FALSE(copy == copy);
+    EXPECT_FALSE(copy.EqMatrix(copy, 1));
+  }
+  s21::SetSimdLevelLimit(s21::SimdLevel::kAvx512);
+  EXPECT_ANY_THROW(base.SumScaledMatrix(S21Matrix(rows, cols + 1), 2.0));
+}
+
 TEST(MatrixFunctionSuite, TransposeTest) {
   S21Matrix testMatrix(2, 3);
   testMatrix[0][2] = 3;
@@ -171,6 +426,41 @@ TEST(MatrixFunctionSuite, TransposeTest) {
   EXPECT_DOUBLE_EQ(result(2, 0), 3.0);
 }
 
+TEST(MatrixFunctionSuite, TransposeTiledTest) {
+  const int sizes[][2] = {{67, 45}, {131, 130}, {1, 90}, {33, 1}};
+  for (const auto &size : sizes) {
+    S21Matrix matrix(size[0], size[1]);
+    for (int i = 0; i < size[0]; i++)
+      for (int j = 0; j < size[1]; j++) matrix[i][j] = i * 1000 + j;
+    S21Matrix result = matrix.Transpose();
+    ASSERT_EQ(result.GetRows(), size[1]);
+    ASSERT_EQ(result.GetCols(), size[0]);
+    for (int i = 0; i < size[0]; i++)
+      for (int j = 0; j < size[1]; j++)
+        ASSERT_DOUBLE_EQ(result(j, i), i * 1000 + j);
+    EXPECT_TRUE(result.Transpose() == matrix);
+  }
+}
+
+TEST(MatrixFunctionSuite, TransposeInPlaceTest) {
+  const int sizes[][2] = {{5, 5},  {70, 70}, {99, 99}, {3, 100},
+                          {100, 70}, {64, 3}, {1, 7},   {8, 1}};
+  for (const auto &size : sizes) {
+    S21Matrix matrix(size[0], size[1]);
+    for (int i = 0; i < size[0]; i++)
+      for (int j = 0; j < size[1]; j++) matrix[i][j] = i * 1000 + j;
+    S21Matrix expected = matrix.Transpose();
+    matrix.TransposeInPlace();
+    ASSERT_EQ(matrix.GetRows(), size[1]);
+    ASSERT_EQ(matrix.GetCols(), size[0]);
+    EXPECT_TRUE(matrix == expected);
+    EXPECT_DOUBLE_EQ(matrix[size[1] - 1][size[0] - 1],
+                     (size[0] - 1) * 1000 + size[1] - 1);
+    matrix.TransposeInPlace();
+    EXPECT_TRUE(matrix == expected.Transpose());
+  }
+}
+
 TEST(MatrixFunctionSuite, DeterminantNormalTest) {
   S21Matrix testMatrix(1, 1);
   testMatrix[0][0] = 1;
@@ -190,6 +480,22 @@ TEST(MatrixFunctionSuite, DeterminantNormalTest) {
   testMatrix1[2][2] = 47;
   myDet = testMatrix1.Determinant();
   EXPECT_DOUBLE_EQ(myDet, -396.4554);
+
+  S21Matrix sequence(4, 4);  //ранг 2
+  for (int i = 0; i < 16; i++) sequence[i / 4][i % 4] = i + 1;
+  EXPECT_EQ(sequence.Determinant(), 0.0);
+  EXPECT_EQ(S21Matrix().Determinant(), 0.0);
+
+  for (int size : {3, 4, 7}) {  //плохой масштаб не делает матрицу вырожденной
+    S21Matrix large(size, size), small(size, size);
+    for (int i = 0; i < size; i++) large[i][i] = small[i][i] = 1;
+    large[0][0] = 1e20;
+    small[size - 1][size - 1] = 1e-16;
+    EXPECT_DOUBLE_EQ(large.Determinant(), 1e20);
+    EXPECT_DOUBLE_EQ(small.Determinant(), 1e-16);
+    S21LU lu(large);
+    EXPECT_FALSE(lu.HasZeroPivot());
+  }
 }
 
 TEST(MatrixFunctionSuite, DeterminantNotSquareTest) {
@@ -266,9 +572,78 @@ TEST(MatrixFunctionSuite, CalcComplements2Test) {
   ASSERT_TRUE(res == expected);
 }
 
+S21Matrix CofactorsByMinors(const S21Matrix &given) {
+  S21Matrix result(given.GetRows(), given.GetCols());
+  for (int i = 0; i < given.GetRows(); i++)
+    for (int j = 0; j < given.GetCols(); j++)
+      result[i][j] = ((i + j) % 2 ? -1 : 1) * given.Minor(i, j).Determinant();
+  return result;
+}
+
+TEST(MatrixFunctionSuite, CalcComplementsLargeTest) {
+  const int size = 9;
+  S21Matrix given(size, size);
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++)
+      given[i][j] = (i * 5 + j * 3) % 7 - 3 + (i == j ? 10 : 0);
+
+  S21Matrix expected = CofactorsByMinors(given);
+  S21Matrix result = given.CalcComplements();
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++)
+      EXPECT_NEAR(result(i, j), expected(i, j),
+                  1e-9 * (1 + std::fabs(expected(i, j))));
+}
+
+TEST(MatrixFunctionSuite, CalcComplementsSingularTest) {
+  const int size = 6;
+  S21Matrix given(size, size);
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++) given[i][j] = (i * 7 + j * 2) % 5 + 1;
+  for (int j = 0; j < size; j++) given[4][j] = given[1][j] - 2 * given[3][j];
+
+  S21Matrix expected = CofactorsByMinors(given);
+  S21Matrix result = given.CalcComplements();
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++)
+      EXPECT_NEAR(result(i, j), expected(i, j),
+                  1e-9 * (1 + std::fabs(expected(i, j))));
+
+  for (int j = 0; j < size; j++) given[5][j] = given[0][j] + given[2][j];
+  result = given.CalcComplements();
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++) EXPECT_NEAR(result(i, j), 0.0, 1e-9);
+
+  S21Matrix single(1, 1);
+  single[0][0] = 5;
+  EXPECT_DOUBLE_EQ(single.CalcComplements()(0, 0), 1.0);
+
+  S21Matrix scaled(4, 4);  //плохой масштаб, ранг 4, затем ранг 3
+  for (int i = 0; i < 4; i++) scaled[i][i] = 1;
+  scaled[0][0] = 1e20;
+  EXPECT_EQ(S21CompleteLU(scaled).GetRank(), 4);
+  result = scaled.CalcComplements();
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+      EXPECT_DOUBLE_EQ(result(i, j), i != j ? 0.0 : i == 0 ? 1.0 : 1e20);
+  scaled[3][3] = 0;
+  EXPECT_EQ(S21CompleteLU(scaled).GetRank(), 3);
+  result = scaled.CalcComplements();
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+      EXPECT_DOUBLE_EQ(result(i, j), i == 3 && j == 3 ? 1e20 : 0.0);
+}
+
 TEST(MatrixFunctionSuite, InverseMatrixErrorTest) {
   S21Matrix testMatrix(3, 3);
   EXPECT_ANY_THROW(testMatrix.InverseMatrix());
+
+  for (int size : {4, 7}) {  //целые строки 1..size^2, ранг 2
+    S21Matrix sequence(size, size);
+    for (int i = 0; i < size * size; i++)
+      sequence[i / size][i % size] = i + 1;
+    EXPECT_THROW(sequence.InverseMatrix(), std::logic_error);
+  }
 }
 
 TEST(MatrixFunctionSuite, InverseMatrixBasicTest) {
@@ -328,6 +703,277 @@ TEST(MatrixFunctionSuite, InverseMatrixNormalTest) {
   given[2][2] = -3.0;
 
   ASSERT_TRUE(given.InverseMatrix() == expected);
+
+  for (int n : {3, 4, 7}) {  //плохой масштаб не делает матрицу вырожденной
+    S21Matrix scaled(n, n);
+    for (int i = 0; i < n; i++) scaled[i][i] = 1;
+    scaled[0][0] = 1e20;
+    scaled[n - 1][1] = 2;
+    S21Matrix inverse = scaled.InverseMatrix();
+    EXPECT_DOUBLE_EQ(inverse[0][0], 1e-20);
+    EXPECT_DOUBLE_EQ(inverse[n - 1][1], -2.0);
+    EXPECT_DOUBLE_EQ(inverse[n - 1][n - 1], 1.0);
+  }
+}
+
+TEST(MatrixLUSuite, ReconstructTest) {
+  const int size = 150;
+  S21Matrix given(size, size);
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++)
+      given[i][j] = std::sin(i * 1.3 + j * 0.7) + (i == j ? 2.0 : 0.0);
+
+  S21LU lu(given);
+  S21Matrix left = lu.GetP() * given;
+  S21Matrix right = lu.GetL() * lu.GetU();
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++) EXPECT_NEAR(left(i, j), right(i, j), 1e-12);
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_FALSE(lu.HasZeroPivot());
+  EXPECT_NEAR(lu.Determinant(), given.Determinant(), 0.0);
+  EXPECT_NEAR(std::log(std::fabs(lu.Determinant())), lu.LogAbsDeterminant(),
+              1e-9);
+}
+
+TEST(MatrixLUSuite, DeterminantTest) {
+  const int size = 5;
+  S21Matrix given(size, size);
+  const double values[size][size] = {{2, -1, 0, 3, 1},
+                                     {4, 0, 1, -2, 2},
+                                     {-3, 5, 2, 1, 0},
+                                     {1, 1, -1, 4, 3},
+                                     {0, 2, 3, -1, 5}};
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++) given[i][j] = values[i][j];
+  EXPECT_NEAR(given.Determinant(), 922.0, 1e-9);
+
+  S21LU lu(given);
+  EXPECT_EQ(lu.GetSize(), size);
+  EXPECT_EQ(std::abs(lu.GetSign()), 1);
+  EXPECT_NEAR(lu.Determinant(), 922.0, 1e-9);
+
+  S21Matrix swapped(given);
+  for (int j = 0; j < size; j++) std::swap(swapped[0][j], swapped[3][j]);
+  EXPECT_NEAR(swapped.Determinant(), -922.0, 1e-9);
+}
+
+TEST(MatrixLUSuite, SingularTest) {
+  const int size = 80;
+  S21Matrix given(size, size);
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++) given[i][j] = i + j;
+  S21LU lu(given);
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_TRUE(lu.HasZeroPivot());
+  EXPECT_NEAR(lu.Determinant(), 0.0, 1e-6);
+  EXPECT_EQ(given.Determinant(), 0.0);
+  EXPECT_THROW(given.InverseMatrix(), std::logic_error);
+  EXPECT_THROW(given.Solve(S21Matrix(size, 1)), std::logic_error);
+
+  S21Matrix zero(size, size);
+  S21LU zero_lu(zero);
+  EXPECT_TRUE(zero_lu.IsSingular());
+  EXPECT_EQ(zero_lu.Determinant(), 0.0);
+  EXPECT_EQ(zero.Determinant(), 0.0);
+
+  EXPECT_ANY_THROW(S21LU(S21Matrix(2, 3)));
+}
+
+TEST(MatrixLUSuite, HugeDeterminantTest) {
+  const int size = 400;
+  S21Matrix given(size, size);
+  for (int i = 0; i < size; i++) given[i][size - 1 - i] = 16.0;
+  S21LU lu(given);
+  EXPECT_TRUE(std::isinf(lu.Determinant()));
+  EXPECT_NEAR(lu.LogAbsDeterminant(), size * std::log(16.0), 1e-9);
+  given.MulNumber(1.0 / 16.0);
+  EXPECT_DOUBLE_EQ(std::fabs(given.Determinant()), 1.0);
+}
+
+TEST(MatrixLUSuite, SolveTest) {
+  const int size = 130, rhs_count = 17;
+  S21Matrix given(size, size);
+  S21Matrix rhs(size, rhs_count);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++)
+      given[i][j] = std::cos(i * 0.9 - j * 1.7) + (i == j ? 3.0 : 0.0);
+    for (int j = 0; j < rhs_count; j++) rhs[i][j] = (i + 2 * j) % 7 - 3;
+  }
+
+  S21Matrix solution = given.Solve(rhs);
+  ASSERT_EQ(solution.GetRows(), size);
+  ASSERT_EQ(solution.GetCols(), rhs_count);
+  S21Matrix check = given * solution;
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < rhs_count; j++)
+      EXPECT_NEAR(check(i, j), rhs(i, j), 1e-10);
+
+  EXPECT_ANY_THROW(given.Solve(S21Matrix(size - 1, 1)));
+  EXPECT_ANY_THROW(S21Matrix(4, 4).Solve(S21Matrix(4, 1)));
+}
+
+TEST(MatrixLUSuite, InverseTest) {
+  const int size = 100;
+  S21Matrix given(size, size);
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++)
+      given[i][j] = std::sin(i * 2.1 + j * 0.3) + (i == j ? 4.0 : 0.0);
+
+  S21Matrix product = given * given.InverseMatrix();
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++)
+      EXPECT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-12);
+
+  EXPECT_ANY_THROW(S21Matrix(size, size).InverseMatrix());
+}
+
+TEST(MatrixParallelSuite, ParallelForTest) {
+  s21::ThreadCountScope scope(4);
+  EXPECT_EQ(s21::GetThreadCount(), 4);
+  const int size = 100000;
+  std::vector<int> hits(size);
+  std::atomic<int> chunks{0}, nested_threads{0};
+  s21::ParallelFor(0, size, 1000, [&](int first, int last) {
+    EXPECT_GE(last - first, 1000);
+    ++chunks;
+    nested_threads += s21::GetThreadCount();
+    for (int i = first; i < last; ++i) hits[i]++;
+  });
+  for (int i = 0; i < size; ++i) ASSERT_EQ(hits[i], 1);
+  EXPECT_GT(chunks.load(), 1);
+  EXPECT_EQ(nested_threads.load(), chunks.load());
+
+  int calls = 0;
+  s21::ParallelFor(0, 10, 1000, [&](int first, int last) {
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(last, 10);
+    ++calls;
+  });
+  EXPECT_EQ(calls, 1);
+
+  EXPECT_THROW(s21::ParallelFor(0, size, 100,
+                                [&](int first, int last) {
+                                  if (first <= 500 && 500 < last)
+                                    throw std::logic_error("chunk");
+                                }),
+               std::logic_error);
+  {
+    s21::ThreadCountScope inner(1);
+    EXPECT_EQ(s21::GetThreadCount(), 1);
+  }
+  EXPECT_EQ(s21::GetThreadCount(), 4);
+  EXPECT_ANY_THROW(s21::ThreadCountScope(0));
+  EXPECT_ANY_THROW(s21::SetThreadCount(-1));
+}
+
+TEST(MatrixParallelSuite, ThreadCountsTest) {
+  const int size = 300;
+  S21Matrix a(size, size), b(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      a[i][j] = (i * 7 + j * 3) % 11 - 5.0 + (i == j ? 40 : 0);
+      b[i][j] = (i + 2 * j) % 13 * 0.25;
+    }
+  }
+  S21Matrix serial_product, serial_transpose, serial_sum, serial_inverse;
+  double serial_log_determinant;
+  {
+    s21::ThreadCountScope scope(1);
+    serial_product = a * b;
+    serial_transpose = b.Transpose();
+    serial_sum = a + b * 2.0;
+    serial_inverse = a.InverseMatrix();
+    serial_log_determinant = S21LU(a).LogAbsDeterminant();
+  }
+  for (int threads : {2, 3, 8}) {
+    s21::ThreadCountScope scope(threads);
+    //разбиение не меняет порядок суммирования
+    EXPECT_TRUE((a * b).EqMatrix(serial_product));
+    EXPECT_TRUE(b.Transpose().EqMatrix(serial_transpose));
+    EXPECT_TRUE(S21Matrix(a + b * 2.0).EqMatrix(serial_sum));
+    S21Matrix inverse = a.InverseMatrix();
+    for (int i = 0; i < size; i++)
+      for (int j = 0; j < size; j++)
+        ASSERT_NEAR(inverse(i, j), serial_inverse(i, j), 1e-12);
+    EXPECT_NEAR(S21LU(a).LogAbsDeterminant(), serial_log_determinant, 1e-9);
+  }
+}
+
+TEST(MatrixAllocatorSuite, PoolTest) {
+  s21::PoolAllocator pool;
+  s21::AllocatorScope scope(pool);
+  S21Matrix a(50, 70);
+  a[3][4] = 2;
+  auto temporaries = [&] {
+    S21Matrix transpose = a.Transpose();
+    S21Matrix minor = a.Minor(2, 2);
+    S21Matrix sum = a + a * 2.0;
+    EXPECT_DOUBLE_EQ(transpose(4, 3) + minor(2, 3) + sum(3, 4), 10);
+  };
+  temporaries();
+  EXPECT_GT(pool.GetCachedBytes(), 0u);
+
+  s21::ResetAllocationStats();
+  const s21::AllocationStats before = s21::GetAllocationStats();
+  for (int i = 0; i < 20; i++) temporaries();
+  const s21::AllocationStats after = s21::GetAllocationStats();
+  EXPECT_EQ(after.allocations, 60u);
+  EXPECT_EQ(after.deallocations, 60u);
+  EXPECT_EQ(after.system_allocations, 0u);
+  EXPECT_EQ(after.bytes_in_use, before.bytes_in_use);
+  EXPECT_GE(after.peak_bytes_in_use, before.bytes_in_use + 2 * 50 * 72 * 8);
+
+  pool.Trim();
+  EXPECT_EQ(pool.GetCachedBytes(), 0u);
+}
+
+TEST(MatrixAllocatorSuite, ArenaTest) {
+  S21Matrix a(40, 40), survivor;
+  a[1][2] = 3;
+  s21::ResetAllocationStats();
+  {
+    s21::ArenaScope arena(1 << 16);
+    for (int i = 0; i < 100; i++) {
+      S21Matrix product = a * a;
+      S21Matrix transpose = a.Transpose();
+      EXPECT_DOUBLE_EQ(transpose(2, 1), 3);
+    }
+    //все матрицы освобождались, арена переиспользует первый кусок
+    EXPECT_EQ(arena.GetReservedBytes(), std::size_t(1) << 16);
+    survivor = a + a;
+  }
+  EXPECT_LE(s21::GetAllocationStats().system_allocations, 2u);
+  //куски арены живут, пока жива survivor
+  EXPECT_DOUBLE_EQ(survivor(1, 2), 6);
+  //последний буфер из арены освобождает её куски
+  survivor.SetRows(1);
+  survivor.ShrinkToFit();
+  EXPECT_DOUBLE_EQ(survivor(0, 0), 0);
+}
+
+TEST(MatrixAllocatorSuite, CustomAllocatorTest) {
+  struct CountingAllocator : s21::SystemAllocator {
+    int allocations = 0, deallocations = 0;
+    void *Allocate(std::size_t bytes) override {
+      allocations++;
+      return s21::SystemAllocator::Allocate(bytes);
+    }
+    void Deallocate(void *buffer, std::size_t bytes) noexcept override {
+      deallocations++;
+      s21::SystemAllocator::Deallocate(buffer, bytes);
+    }
+  } counting;
+  S21Matrix before(2, 2);
+  s21::SetAllocator(&counting);
+  {
+    S21Matrix a(3, 3), b(a);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.GetData()) % 64, 0u);
+  }
+  before.SetCols(3);
+  s21::SetAllocator(nullptr);
+  EXPECT_EQ(counting.allocations, 3);
+  //before освобождён системой, а не counting
+  EXPECT_EQ(counting.deallocations, 2);
 }
 
 TEST(MatrixOperatorSuite, BracesOutOfIndexTest) {
@@ -365,6 +1011,849 @@ TEST(MatrixOperatorSuite, PlusMinusTest) {
   EXPECT_DOUBLE_EQ(resultMatrix(2, 2), -4.0);
 }
 
+TEST(MatrixOperatorSuite, ExpressionChainTest) {
+  const int rows = 4, cols = 70;
+  S21Matrix a(rows, cols), b(rows, cols), c(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      a[i][j] = i + j;
+      b[i][j] = i * j;
+      c[i][j] = j - i;
+    }
+  }
+
+  S21Matrix result = a + b - c * 2.0;
+  S21Matrix scaled = 0.5 * (a - b) + c;
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      EXPECT_DOUBLE_EQ(result(i, j), a(i, j) + b(i, j) - c(i, j) * 2.0);
+      EXPECT_DOUBLE_EQ(scaled(i, j), 0.5 * (a(i, j) - b(i, j)) + c(i, j));
+    }
+  }
+
+  result += b * 3.0;
+  result -= a + c;
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < cols; j++)
+      EXPECT_DOUBLE_EQ(result(i, j), 4 * b(i, j) - 3 * c(i, j));
+
+  S21Matrix square(cols, 2);
+  square[1][1] = 1;
+  S21Matrix product = (a + b) * square;
+  EXPECT_EQ(product.GetCols(), 2);
+  EXPECT_DOUBLE_EQ(product(2, 1), a(2, 1) + b(2, 1));
+
+  EXPECT_ANY_THROW(S21Matrix(a + S21Matrix(rows, cols + 1)));
+  EXPECT_ANY_THROW(result += S21Matrix(1, 1) * 2.0);
+  S21Matrix empty = S21Matrix() + S21Matrix();
+  EXPECT_EQ(empty.GetRows(), 0);
+}
+
+TEST(MatrixOperatorSuite, ExpressionAsMatrixTest) {
+  S21Matrix a(4, 4), b(4, 4), c(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      a[i][j] = (i == j) * 5 + i - j;
+      b[i][j] = i * j;
+      c[i][j] = a[i][j] + b[i][j];
+    }
+  }
+  EXPECT_TRUE((a + b) == c);
+  EXPECT_TRUE(c == (a + b));
+  EXPECT_TRUE((a + b) == (c - b + b));
+  EXPECT_TRUE((a + b) != a);
+  EXPECT_TRUE(a != c);
+  EXPECT_FALSE(a != a);
+  EXPECT_TRUE((a + b).EqMatrix(c));
+  EXPECT_TRUE((c + b * 1e-12).EqMatrix(c, 1e-9));
+  EXPECT_DOUBLE_EQ((a * 2.0)(1, 0), 2 * a(1, 0));
+  EXPECT_TRUE((a + b).Transpose() == c.Transpose());
+  EXPECT_TRUE((a + b).InverseMatrix().EqMatrix(c.InverseMatrix(), 1e-12));
+  EXPECT_DOUBLE_EQ((a - b + b).Determinant(), a.Determinant());
+  EXPECT_TRUE((a * 1.0).CalcComplements() == a.CalcComplements());
+  EXPECT_TRUE((a * 1.0).Minor(1, 2) == a.Minor(1, 2));
+  EXPECT_TRUE((a + b) * (a - b) == c * (a - b));
+  EXPECT_FALSE((a + b) == S21Matrix(4, 3));
+}
+
+TEST(MatrixOperatorSuite, ExpressionAliasingTest) {
+  S21Matrix a(3, 3), b(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      a[i][j] = i * 3 + j;
+      b[i][j] = 1;
+    }
+  }
+  S21Matrix original(a);
+
+  a = b - a;
+  EXPECT_DOUBLE_EQ(a(2, 2), 1 - original(2, 2));
+  a = original;
+  a += b + a;
+  EXPECT_DOUBLE_EQ(a(1, 2), 2 * original(1, 2) + 1);
+  a = original;
+  a = a * 2.0 + a;
+  EXPECT_DOUBLE_EQ(a(2, 1), 3 * original(2, 1));
+
+  S21Matrix resized(1, 1);
+  resized = original + b;
+  EXPECT_EQ(resized.GetRows(), 3);
+  EXPECT_DOUBLE_EQ(resized(2, 2), original(2, 2) + 1);
+}
+
+TEST(MatrixViewSuite, BlockTest) {
+  const int size = 70;
+  S21Matrix a(size, size), b(size, size);
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++) {
+      a[i][j] = i * 0.5 - j;
+      b[i][j] = (i * 3 + j) % 11;
+    }
+  S21MatrixView block = a.Block(3, 5, 10, 12);
+  S21Matrix copy = block;
+  EXPECT_EQ(block.GetStride(), a.GetStride());
+  EXPECT_DOUBLE_EQ(copy(9, 11), a(12, 16));
+  EXPECT_TRUE(block == copy);
+  EXPECT_TRUE(block.Transpose() == copy.Transpose());
+  S21Matrix square = a.Block(2, 1, 12, 10) * b.Block(40, 7, 10, 12);
+  S21Matrix expected = S21Matrix(a.Block(2, 1, 12, 10)) *
+                       S21Matrix(b.Block(40, 7, 10, 12));
+  EXPECT_TRUE(square == expected);
+
+  block += b.Block(0, 0, 10, 12);
+  block *= 2.0;
+  EXPECT_DOUBLE_EQ(a(12, 16), 2 * (copy(9, 11) + b(9, 11)));
+  EXPECT_DOUBLE_EQ(a(2, 16), 1 - 16.0);
+  block(0, 0) = 100;
+  EXPECT_DOUBLE_EQ(a(3, 5), 100);
+  EXPECT_FALSE(block == copy);
+  EXPECT_THROW(a.Block(60, 0, 11, 1), std::out_of_range);
+  EXPECT_THROW(block = a.Block(0, 0, 2, 2), std::logic_error);
+}
+
+TEST(MatrixViewSuite, MinorViewTest) {
+  const int size = 5;
+  S21Matrix given(size, size);
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++)
+      given[i][j] = (i * 7 + j * 3) % 5 - 2 + (i == j ? 4 : 0);
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++) {
+      S21MatrixView minor = given.MinorView(i, j);
+      S21Matrix copy = given.Minor(i, j);
+      EXPECT_TRUE(minor == copy);
+      EXPECT_NEAR(minor.Determinant(), copy.Determinant(), 1e-9);
+      EXPECT_NEAR(copy.MinorView(1, 2).Determinant(),
+                  copy.Minor(1, 2).Determinant(), 1e-9);
+      EXPECT_TRUE(minor.Transpose() == copy.Transpose());
+      EXPECT_TRUE(minor.Block(1, 1, 3, 2) == copy.View().Block(1, 1, 3, 2));
+      EXPECT_TRUE(S21Matrix(minor + minor) == copy * 2.0);
+    }
+
+  S21Matrix original(given);
+  S21MatrixView minor = given.MinorView(2, 1);
+  minor = S21Matrix(4, 4);
+  for (int j = 0; j < size; j++) EXPECT_DOUBLE_EQ(given(2, j), original(2, j));
+  for (int i = 0; i < size; i++) EXPECT_DOUBLE_EQ(given(i, 1), original(i, 1));
+  EXPECT_DOUBLE_EQ(given(4, 4), 0);
+  EXPECT_THROW(given.MinorView(5, 0), std::out_of_range);
+  EXPECT_THROW(S21Matrix(1, 1).Minor(0, 0), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(1, 3).Minor(0, 1), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(1, 1).Minor(1, 0), std::out_of_range);
+  EXPECT_THROW(minor.MinorView(0, 0), std::logic_error);
+}
+
+TEST(MatrixViewSuite, OverlapTest) {
+  S21Matrix a(5, 4);
+  for (int i = 0; i < 5; i++)
+    for (int j = 0; j < 4; j++) a[i][j] = i * 4 + j;
+  S21Matrix original(a);
+
+  a.Block(1, 0, 4, 4) = a.Block(0, 0, 4, 4);
+  for (int i = 1; i < 5; i++)
+    for (int j = 0; j < 4; j++) EXPECT_DOUBLE_EQ(a(i, j), original(i - 1, j));
+
+  a = original;
+  S21MatrixView left = a.Block(0, 0, 5, 3), right = a.Block(0, 1, 5, 3);
+  left = right * 2.0 + left;
+  for (int i = 0; i < 5; i++)
+    for (int j = 0; j < 3; j++)
+      EXPECT_DOUBLE_EQ(a(i, j), 2 * original(i, j + 1) + original(i, j));
+  EXPECT_DOUBLE_EQ(a(4, 3), original(4, 3));
+}
+
+template <typename Lhs, typename Rhs, typename = void>
+struct CanAdd : std::false_type {};
+
+template <typename Lhs, typename Rhs>
+struct CanAdd<Lhs, Rhs,
+              std::void_t<decltype(std::declval<Lhs>() + std::declval<Rhs>())>>
+    : std::true_type {};
+
+template <typename Lhs, typename Rhs, typename = void>
+struct CanMultiply : std::false_type {};
+
+template <typename Lhs, typename Rhs>
+struct CanMultiply<
+    Lhs, Rhs, std::void_t<decltype(std::declval<Lhs>() * std::declval<Rhs>())>>
+    : std::true_type {};
+
+static_assert(CanAdd<S21FixedMatrix<2, 3>, S21FixedMatrix<2, 3>>::value, "");
+static_assert(!CanAdd<S21FixedMatrix<2, 3>, S21FixedMatrix<3, 2>>::value, "");
+static_assert(CanMultiply<S21FixedMatrix<2, 3>, S21FixedMatrix<3, 4>>::value,
+              "");
+static_assert(!CanMultiply<S21FixedMatrix<2, 3>, S21FixedMatrix<2, 3>>::value,
+              "");
+
+TEST(MatrixFixedSuite, ArithmeticTest) {
+  S21FixedMatrix<2, 3> a(1, 2, 3, 4, 5, 6), b(6, 5, 4, 3, 2, 1);
+  EXPECT_EQ(sizeof(a), 6 * sizeof(double));
+  EXPECT_DOUBLE_EQ((a.At<1, 2>()), 6);
+  EXPECT_TRUE(a + b == (S21FixedMatrix<2, 3>(7, 7, 7, 7, 7, 7)));
+  EXPECT_TRUE(a - a == (S21FixedMatrix<2, 3>()));
+  EXPECT_TRUE(2.0 * a == a + a);
+  a *= 0.5;
+  EXPECT_DOUBLE_EQ(a(1, 0), 2);
+  a *= 2.0;
+
+  S21FixedMatrix<3, 2> t = b.Transpose();
+  EXPECT_DOUBLE_EQ(t(2, 0), 4);
+  S21FixedMatrix<2, 2> product = a * t;
+  EXPECT_TRUE(product == S21Matrix(a) * S21Matrix(t));
+  S21FixedMatrix<2, 2> square(1, 2, 3, 4);
+  square *= S21FixedMatrix<2, 2>(0, 1, 1, 0);
+  EXPECT_TRUE(square == (S21FixedMatrix<2, 2>(2, 1, 4, 3)));
+  EXPECT_THROW(a(2, 0), std::out_of_range);
+  EXPECT_THROW(a.Minor(0, 3), std::out_of_range);
+}
+
+template <int N>
+void CheckFixedInverse() {
+  S21FixedMatrix<N, N> fixed;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++) fixed(i, j) = (i * 3 + j * 5) % 7 - 3 + 2 * N;
+  for (int i = 0; i < N; i++) fixed(i, i) += 4;
+  S21Matrix dynamic = fixed;
+  EXPECT_NEAR(fixed.Determinant(), dynamic.Determinant(),
+              1e-9 * std::fabs(dynamic.Determinant()));
+  S21FixedMatrix<N, N> complements = fixed.CalcComplements();
+  S21FixedMatrix<N, N> inverse = fixed.InverseMatrix();
+  S21Matrix expected_complements = dynamic.CalcComplements();
+  S21Matrix expected_inverse = dynamic.InverseMatrix();
+  S21FixedMatrix<N, N> identity = fixed * inverse;
+  for (int i = 0; i < N; i++)
+    for (int j = 0; j < N; j++) {
+      EXPECT_NEAR(complements(i, j), expected_complements(i, j),
+                  1e-9 * (1 + std::fabs(expected_complements(i, j))));
+      EXPECT_NEAR(inverse(i, j), expected_inverse(i, j), 1e-12);
+      EXPECT_NEAR(identity(i, j), i == j ? 1 : 0, 1e-12);
+    }
+}
+
+TEST(MatrixFixedSuite, DeterminantInverseTest) {
+  CheckFixedInverse<1>();
+  CheckFixedInverse<2>();
+  CheckFixedInverse<3>();
+  CheckFixedInverse<4>();
+  CheckFixedInverse<6>();
+  EXPECT_THROW((S21FixedMatrix<4, 4>().InverseMatrix()), std::logic_error);
+  EXPECT_DOUBLE_EQ((S21FixedMatrix<2, 2>(1, 2, 3, 4).Determinant()), -2);
+}
+
+TEST(MatrixFixedSuite, InteropTest) {
+  S21FixedMatrix<3, 3> fixed(1, 2, 3, 4, 5, 6, 7, 8, 10);
+  S21Matrix dynamic = fixed;
+  EXPECT_EQ(dynamic.GetRows(), 3);
+  EXPECT_TRUE(dynamic == fixed);
+  EXPECT_TRUE(fixed == dynamic);
+  EXPECT_TRUE((S21FixedMatrix<3, 3>(dynamic) == fixed));
+  EXPECT_THROW((S21FixedMatrix<2, 3>(dynamic)), std::logic_error);
+
+  S21Matrix sum = fixed + dynamic, difference = dynamic - fixed;
+  EXPECT_DOUBLE_EQ(sum(2, 2), 20);
+  EXPECT_DOUBLE_EQ(difference(1, 1), 0);
+  S21Matrix product = fixed * dynamic, reversed = dynamic * fixed;
+  EXPECT_TRUE(product == dynamic * dynamic);
+  EXPECT_TRUE(reversed == product);
+  EXPECT_THROW(fixed + S21Matrix(2, 2), std::logic_error);
+
+  S21FixedMatrix<2, 2> from_view(dynamic.Block(1, 1, 2, 2));
+  EXPECT_TRUE(from_view == (S21FixedMatrix<2, 2>(5, 6, 8, 10)));
+  dynamic.Block(0, 0, 2, 2) = from_view.View();
+  EXPECT_DOUBLE_EQ(dynamic(1, 1), 10);
+  dynamic.SumMatrix(fixed);
+  EXPECT_DOUBLE_EQ(dynamic(2, 2), 20);
+}
+
+static_assert(CanAdd<S21MatrixF, S21MatrixF>::value, "");
+static_assert(!CanAdd<S21MatrixF, S21Matrix>::value, "");
+static_assert(!CanAdd<S21Matrix, S21MatrixLD>::value, "");
+static_assert(std::is_constructible<S21MatrixF, S21Matrix>::value, "");
+static_assert(!std::is_convertible<S21Matrix, S21MatrixF>::value, "");
+static_assert(!std::is_convertible<S21MatrixView, S21MatrixLD>::value, "");
+
+// Целые элементы и суммы меньше 2^24 точны даже во float, поэтому
+// результаты сравниваются точно. Размер 70 задевает неполные полосы
+// упакованного умножения и плитки транспонирования.
+template <typename T>
+void CheckPrecision() {
+  const int n = 70;
+  S21BasicMatrix<T> a(n, n), b(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      a[i][j] = (i * 7 + j * 3) % 11 - 5;
+      b[i][j] = (i * 5 + j) % 9 - 4;
+    }
+  }
+  S21BasicMatrix<T> product = a * b;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      T expected = 0;
+      for (int k = 0; k < n; k++) expected += a(i, k) * b(k, j);
+      ASSERT_EQ(product(i, j), expected);
+    }
+  }
+  S21BasicMatrix<T> fused = a + b * 2 - a;
+  EXPECT_TRUE(fused == b + b);
+  S21BasicMatrix<T> transposed = a.Transpose();
+  a.TransposeInPlace();
+  EXPECT_TRUE(a == transposed);
+  EXPECT_EQ(a(3, 5), transposed(3, 5));
+
+  const int m = 6;
+  S21BasicMatrix<T> dominant(m, m);
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < m; j++) dominant[i][j] = i == j ? 10 : (i + j) % 3;
+  S21BasicMatrix<T> identity = dominant * dominant.InverseMatrix();
+  const T tolerance = 64 * std::numeric_limits<T>::epsilon();
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < m; j++)
+      EXPECT_NEAR(static_cast<double>(identity(i, j)), i == j ? 1.0 : 0.0,
+                  static_cast<double>(tolerance));
+  T determinant = dominant.Determinant();
+  EXPECT_NEAR(static_cast<double>(determinant),
+              static_cast<double>(S21BasicLU<T>(dominant).Determinant()),
+              static_cast<double>(std::fabs(determinant) * tolerance));
+}
+
+TEST(MatrixPrecisionSuite, FloatTest) {
+  CheckPrecision<float>();
+  const s21::SimdLevel levels[] = {s21::SimdLevel::kScalar,
+                                   s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2,
+                                   s21::SimdLevel::kAvx512};
+  S21MatrixF base(5, 37), other(5, 37);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 37; j++) {
+      base[i][j] = i * 0.5f - j * 0.25f;
+      other[i][j] = (i * j) % 5 - 2.0f;
+    }
+  }
+  for (s21::SimdLevel level : levels) {
+    s21::SetSimdLevelLimit(level);
+    S21MatrixF sum(base);
+    sum.SumScaledMatrix(other, 3);
+    for (int j = 0; j < 37; j++)
+      ASSERT_EQ(sum(4, j), base(4, j) + other(4, j) * 3.0f);
+    sum = base;
+    EXPECT_TRUE(sum == base);
+    sum[4][36] += 1;
+    EXPECT_FALSE(sum == base);
+  }
+  s21::SetSimdLevelLimit(s21::SimdLevel::kAvx512);
+}
+
+TEST(MatrixPrecisionSuite, LongDoubleTest) {
+  CheckPrecision<long double>();
+  S21MatrixLD precise(2, 2);
+  precise[0][0] = 1 + 1e-17L;
+  precise[1][1] = 1;
+  EXPECT_NE(precise.Determinant(), 1.0L);
+  S21Matrix rounded(precise);
+  EXPECT_EQ(rounded(0, 0), 1.0);
+  EXPECT_FALSE(S21MatrixLD(rounded) == precise);
+  S21MatrixF narrow(rounded);
+  EXPECT_EQ(narrow.GetCols(), 2);
+  EXPECT_EQ(narrow(1, 1), 1.0f);
+  S21FixedMatrix<2, 2, float> fixed(narrow);
+  EXPECT_TRUE(fixed == narrow);
+  EXPECT_EQ(fixed.InverseMatrix()(1, 1), 1.0f);
+}
+
+// Примерно каждый седьмой элемент ненулевой; целые значения делают
+// произведения точными.
+S21Matrix SparseSample(int rows, int cols, int seed) {
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < cols; j++)
+      if ((i * 31 + j * 17 + seed) % 7 == 0) matrix[i][j] = (i + j) % 5 - 2;
+  return matrix;
+}
+
+TEST(MatrixSparseSuite, ConversionTest) {
+  S21Matrix dense = SparseSample(40, 30, 1);
+  S21SparseMatrix rows(dense);
+  S21SparseMatrix columns(dense, s21::SparseLayout::kColumns);
+  EXPECT_EQ(rows.GetLayout(), s21::SparseLayout::kRows);
+  EXPECT_LT(rows.GetNonZeros(), 40u * 30u / 5u);
+  EXPECT_EQ(rows.GetNonZeros(), columns.GetNonZeros());
+  EXPECT_EQ(columns.GetOffsets().size(), 31u);
+  EXPECT_TRUE(rows.ToDense() == dense);
+  EXPECT_TRUE(columns.ToDense() == dense);
+  EXPECT_TRUE(rows == columns);
+  EXPECT_DOUBLE_EQ(columns(7, 2), dense(7, 2));
+  EXPECT_THROW(rows(40, 0), std::out_of_range);
+
+  S21SparseMatrix transposed = rows.Transpose();
+  EXPECT_EQ(transposed.GetRows(), 30);
+  EXPECT_EQ(transposed.GetLayout(), s21::SparseLayout::kColumns);
+  EXPECT_TRUE(transposed.ToDense() == dense.Transpose());
+  EXPECT_TRUE(transposed.WithLayout(s21::SparseLayout::kRows) == transposed);
+
+  std::vector<S21SparseMatrix::Entry> entries = {
+      {2, 1, 1.5}, {0, 3, 2}, {2, 1, 0.5}, {2, 0, -1}};
+  S21SparseMatrix built(3, 4, entries);
+  EXPECT_EQ(built.GetNonZeros(), 3u);
+  EXPECT_EQ(built.GetIndices()[1], 0);
+  EXPECT_DOUBLE_EQ(built(2, 1), 2);
+  EXPECT_DOUBLE_EQ(built(1, 1), 0);
+  entries.push_back({3, 0, 1});
+  EXPECT_THROW(S21SparseMatrix(3, 4, entries), std::out_of_range);
+  EXPECT_THROW(S21SparseMatrix(0, 4), std::invalid_argument);
+}
+
+TEST(MatrixSparseSuite, ArithmeticTest) {
+  S21Matrix a = SparseSample(40, 30, 1), b = SparseSample(30, 25, 3);
+  S21Matrix c = SparseSample(40, 30, 5);
+  S21SparseMatrix sparse_a(a), sparse_b(b, s21::SparseLayout::kColumns);
+  S21SparseMatrix sparse_c(c);
+
+  EXPECT_TRUE(sparse_a * b == a * b);
+  EXPECT_TRUE(a.Transpose() * sparse_a == a.Transpose() * a);
+  EXPECT_TRUE((sparse_a * sparse_b).ToDense() == a * b);
+  EXPECT_TRUE((sparse_b.Transpose() * sparse_a.Transpose()).ToDense() ==
+              (a * b).Transpose());
+  std::vector<double> x(30);
+  for (int j = 0; j < 30; j++) x[j] = j % 4 - 1;
+  std::vector<double> y = sparse_a.Multiply(x);
+  for (int i = 0; i < 40; i++) {
+    double expected = 0;
+    for (int j = 0; j < 30; j++) expected += a(i, j) * x[j];
+    ASSERT_DOUBLE_EQ(y[i], expected);
+  }
+  EXPECT_EQ(sparse_a.Transpose().Multiply(y).size(), 30u);
+
+  EXPECT_TRUE((sparse_a + sparse_c).ToDense() == a + c);
+  EXPECT_TRUE((sparse_a - sparse_c).ToDense() == a - c);
+  EXPECT_TRUE((sparse_a.Transpose() + sparse_c.Transpose()).ToDense() ==
+              S21Matrix(a + c).Transpose());
+  EXPECT_EQ((sparse_a - sparse_a).GetNonZeros(), 0u);
+  EXPECT_TRUE(sparse_a + c == a + c);
+  EXPECT_TRUE(a - sparse_c == a - c);
+  EXPECT_TRUE(sparse_a - c == a - c);
+  S21Matrix accumulated(a);
+  accumulated += sparse_c;
+  EXPECT_TRUE(accumulated == a + c);
+  sparse_c *= 2;
+  sparse_c -= sparse_a;
+  EXPECT_TRUE(sparse_c.ToDense() == c * 2.0 - a);
+
+  EXPECT_THROW(sparse_a * sparse_a, std::logic_error);
+  EXPECT_THROW(sparse_a * a, std::logic_error);
+  EXPECT_THROW(sparse_a + sparse_b, std::logic_error);
+  EXPECT_THROW(sparse_a.Multiply(y), std::logic_error);
+  S21SparseMatrixF narrow(S21MatrixF(a), s21::SparseLayout::kColumns);
+  EXPECT_TRUE((narrow * S21MatrixF(b)) == S21MatrixF(a * b));
+}
+
+// Матрицы пакета с диагональным преобладанием, чтобы все были обратимы.
+S21MatrixBatch BatchSample(int count, int rows, int cols, int seed) {
+  S21MatrixBatch batch(count, rows, cols);
+  for (int b = 0; b < count; b++)
+    for (int i = 0; i < rows; i++)
+      for (int j = 0; j < cols; j++)
+        batch(b, i, j) = (b * 7 + i * 5 + j * 3 + seed) % 9 - 4 +
+                         (i == j) * (20 + b % 3);
+  return batch;
+}
+
+TEST(MatrixBatchSuite, OperationsTest) {
+  // 21 матрица — две полные группы double и неполная третья.
+  const int sizes[] = {2, 3, 5, 16};
+  for (s21::SimdLevel level : {s21::SimdLevel::kScalar,
+                               s21::SimdLevel::kAvx512}) {
+    s21::SetSimdLevelLimit(level);
+    for (int n : sizes) {
+      S21MatrixBatch a = BatchSample(21, n, n, 1);
+      S21MatrixBatch b = BatchSample(21, n, n, 4);
+      S21MatrixBatch product = a * b, transposed = a.Transpose();
+      S21MatrixBatch inverse = a.InverseMatrix();
+      std::vector<double> determinants = a.Determinant();
+      ASSERT_EQ(determinants.size(), 21u);
+      for (int k = 0; k < 21; k++) {
+        S21Matrix matrix = a.Get(k);
+        EXPECT_TRUE(product.Get(k) == matrix * b.Get(k));
+        EXPECT_TRUE(transposed.Get(k) == matrix.Transpose());
+        double determinant = matrix.Determinant();
+        EXPECT_NEAR(determinants[k], determinant,
+                    std::fabs(determinant) * 1e-12);
+        S21Matrix identity = matrix * inverse.Get(k);
+        for (int i = 0; i < n; i++)
+          for (int j = 0; j < n; j++)
+            ASSERT_NEAR(identity(i, j), i == j ? 1.0 : 0.0, 1e-12);
+      }
+    }
+  }
+}
+
+TEST(MatrixBatchSuite, ShapesAndErrorsTest) {
+  S21MatrixBatch tall = BatchSample(3, 4, 2, 0), wide = BatchSample(3, 2, 4, 1);
+  S21MatrixBatch square = tall * wide;
+  EXPECT_EQ(square.GetRows(), 4);
+  EXPECT_TRUE(square.Get(2) == tall.Get(2) * wide.Get(2));
+  EXPECT_TRUE(tall.Transpose().Get(1) == tall.Get(1).Transpose());
+  S21Matrix before = tall.Get(0);
+  S21MatrixBatch rotation = BatchSample(3, 2, 2, 5);
+  tall *= rotation;
+  EXPECT_TRUE(tall.Get(0) == before * rotation.Get(0));
+
+  S21Matrix singular(3, 3);
+  singular(0, 0) = 1;
+  S21MatrixBatch batch = BatchSample(10, 3, 3, 2);
+  batch.Set(9, singular);
+  EXPECT_DOUBLE_EQ(batch.Determinant()[9], 0);
+  EXPECT_THROW(batch.InverseMatrix(), std::logic_error);
+  EXPECT_THROW(square.InverseMatrix(), std::logic_error);
+  EXPECT_THROW(wide.Determinant(), std::logic_error);
+  EXPECT_THROW(batch * square, std::logic_error);
+  EXPECT_THROW(wide * wide, std::logic_error);
+  EXPECT_THROW(batch.Set(0, S21Matrix(2, 3)), std::logic_error);
+  EXPECT_THROW(batch(10, 0, 0), std::out_of_range);
+  EXPECT_THROW(batch.Get(-1), std::out_of_range);
+  EXPECT_THROW(S21MatrixBatch(0, 3, 3), std::invalid_argument);
+
+  S21MatrixBatchF narrow(5, 4, 4);
+  S21MatrixBatchLD precise(5, 4, 4);
+  for (int k = 0; k < 5; k++) {
+    for (int i = 0; i < 4; i++) {
+      narrow(k, i, i) = 2;
+      precise(k, i, i) = 4;
+    }
+  }
+  EXPECT_EQ(narrow.InverseMatrix()(4, 3, 3), 0.5f);
+  EXPECT_EQ((precise * precise).Determinant()[4], 65536.0L);
+}
+
+S21Matrix IoSample(int rows, int cols) {
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < cols; j++) matrix[i][j] = i * 0.5 - j / 3.0;
+  return matrix;
+}
+
+TEST(MatrixIoSuite, ReadWriteTest) {
+  const std::string path = testing::TempDir() + "s21_io_test.s21m";
+  S21Matrix matrix = IoSample(37, 70);
+  s21::WriteMatrix(path, matrix);
+  s21::FileHeader header = s21::ReadFileHeader(path);
+  EXPECT_EQ(header.rows, 37u);
+  EXPECT_EQ(header.stride, static_cast<std::uint64_t>(matrix.GetStride()));
+  EXPECT_EQ(header.element_type, s21::ElementType::kDouble);
+  EXPECT_GE(header.payload_offset, 4096u);  //данные с новой страницы
+  EXPECT_EQ(header.payload_offset % sysconf(_SC_PAGESIZE), 0u);
+  EXPECT_TRUE(s21::ReadMatrix<double>(path) == matrix);
+  EXPECT_TRUE(s21::ReadMatrix<float>(path) == S21MatrixF(matrix));
+  s21::WriteMatrix(path, S21MatrixLD(matrix));
+  EXPECT_TRUE(s21::ReadMatrix<double>(path) == matrix);
+  s21::WriteMatrix(path, S21Matrix());
+  EXPECT_EQ(s21::ReadMatrix<double>(path).GetRows(), 0);
+  S21Matrix reserved;  //0 x 3 после Reserve читается с тем же числом столбцов
+  reserved.Reserve(10, 3);
+  s21::WriteMatrix(path, reserved);
+  S21MatrixF streamed = s21::ReadMatrix<float>(path);
+  EXPECT_EQ(streamed.GetRows(), 0);
+  EXPECT_EQ(streamed.GetCols(), 3);
+  const float row[3] = {1, 2, 3};
+  streamed.AppendRow(row);
+  EXPECT_EQ(streamed(0, 2), 3.0f);
+
+  // Файл с другой машины: заголовок и элементы в обратном порядке байтов.
+  auto reversed = [](auto value) {
+    unsigned char *bytes = reinterpret_cast<unsigned char *>(&value);
+    std::reverse(bytes, bytes + sizeof(value));
+    return value;
+  };
+  header.byte_order = reversed(s21::kByteOrderMark);
+  header.version = reversed(s21::kFileVersion);
+  header.element_type = reversed(s21::ElementType::kFloat);
+  header.element_size = reversed(std::uint32_t(4));
+  header.rows = reversed(std::uint64_t(2));
+  header.cols = header.stride = reversed(std::uint64_t(3));
+  header.payload_offset = reversed(std::uint64_t(sizeof(header)));
+  std::ofstream foreign(path, std::ios::binary);
+  foreign.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  for (int k = 0; k < 6; k++) {
+    float value = reversed(k * 1.5f);
+    foreign.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+  foreign.close();
+  S21Matrix swapped = s21::ReadMatrix<double>(path);
+  EXPECT_EQ(swapped.GetCols(), 3);
+  EXPECT_DOUBLE_EQ(swapped(1, 2), 7.5);
+  EXPECT_THROW(S21MatrixF(path, s21::MapMode::kReadOnly), std::runtime_error);
+
+  std::ofstream(path, std::ios::binary) << "not a matrix file at all";
+  EXPECT_THROW(s21::ReadMatrix<double>(path), std::runtime_error);
+  s21::WriteMatrix(path, matrix);
+  std::ifstream complete(path, std::ios::binary);
+  std::string bytes((std::istreambuf_iterator<char>(complete)),
+                    std::istreambuf_iterator<char>());
+  complete.close();
+  std::ofstream(path, std::ios::binary).write(bytes.data(), 5000);
+  EXPECT_THROW(s21::ReadMatrix<double>(path), std::runtime_error);
+  EXPECT_THROW(S21Matrix(path, s21::MapMode::kReadOnly), std::runtime_error);
+  EXPECT_THROW(s21::ReadMatrix<double>(path + ".missing"),
+               std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(MatrixIoSuite, MapTest) {
+  const std::string path = testing::TempDir() + "s21_map_test.s21m";
+  S21Matrix matrix = IoSample(40, 33);
+  s21::WriteMatrix(path, matrix);
+  s21::AllocationStats before = s21::GetAllocationStats();
+  {
+    S21Matrix mapped(path, s21::MapMode::kReadOnly);
+    EXPECT_EQ(s21::GetAllocationStats().system_allocations,
+              before.system_allocations);
+    EXPECT_TRUE(mapped == matrix);
+    EXPECT_EQ(mapped.GetStride(), matrix.GetStride());
+    EXPECT_TRUE(mapped * matrix.Transpose() == matrix * matrix.Transpose());
+    EXPECT_TRUE(mapped.Block(1, 2, 3, 4) == matrix.Block(1, 2, 3, 4));
+    S21Matrix copy = mapped;
+    copy *= 2.0;
+    EXPECT_DOUBLE_EQ(copy(39, 32), 2 * matrix(39, 32));
+    S21Matrix assigned(path, s21::MapMode::kReadOnly);
+    assigned = copy;  //не в страницы файла
+    EXPECT_TRUE(assigned == copy);
+    S21Matrix summed(path, s21::MapMode::kReadOnly);
+    summed = copy + copy;
+    EXPECT_DOUBLE_EQ(summed(39, 32), 4 * matrix(39, 32));
+    S21Matrix moved = std::move(mapped);
+    EXPECT_TRUE(moved == matrix);
+    EXPECT_THROW(S21MatrixF(path, s21::MapMode::kReadOnly),
+                 std::runtime_error);
+  }
+  {
+    S21Matrix writable(path, s21::MapMode::kCopyOnWrite);
+    writable *= -1.0;
+    writable.TransposeInPlace();
+    EXPECT_DOUBLE_EQ(writable(32, 39), -matrix(39, 32));
+    writable.SetRows(50);
+    EXPECT_DOUBLE_EQ(writable(32, 39), -matrix(39, 32));
+  }
+  s21::AllocationStats after = s21::GetAllocationStats();
+  EXPECT_EQ(after.bytes_in_use, before.bytes_in_use);
+  EXPECT_TRUE(s21::ReadMatrix<double>(path) == matrix);
+  s21::WriteMatrix(path, S21Matrix());
+  EXPECT_EQ(S21Matrix(path, s21::MapMode::kReadOnly).GetRows(), 0);
+  S21Matrix reserved;
+  reserved.Reserve(10, 3);
+  s21::WriteMatrix(path, reserved);
+  S21Matrix mapped(path, s21::MapMode::kReadOnly);
+  EXPECT_EQ(mapped.GetRows(), 0);
+  EXPECT_EQ(mapped.GetCols(), 3);
+  std::remove(path.c_str());
+}
+
+TEST(MatrixOutOfCoreSuite, StreamingTest) {
+  const std::string a_path = testing::TempDir() + "s21_ooc_a.s21m";
+  const std::string b_path = testing::TempDir() + "s21_ooc_b.s21m";
+  const std::string c_path = testing::TempDir() + "s21_ooc_c.s21m";
+  S21Matrix a = IoSample(45, 70), b = IoSample(70, 38), a2 = a;
+  a2 *= -3.0;
+  s21::WriteMatrix(a_path, a);
+  s21::WriteMatrix(b_path, b);
+  // Маленький бюджет дробит матрицы на много плиток.
+  const std::size_t budget = 16 << 10;
+  s21::ResetAllocationStats();
+  const std::size_t in_use = s21::GetAllocationStats().bytes_in_use;
+  s21::OutOfCoreStats stats =
+      s21::MulMatrixFiles<double>(a_path, b_path, c_path, budget);
+  EXPECT_LE(s21::GetAllocationStats().peak_bytes_in_use - in_use, budget);
+  EXPECT_LE(stats.buffer_bytes, budget);
+  EXPECT_GT(stats.bytes_read, (45 + 38) * 70 * sizeof(double));
+  EXPECT_EQ(stats.bytes_written, 45 * 38 * sizeof(double));
+  // Плитки суммируют произведение в другом порядке, чем GEMM целиком.
+  S21Matrix product = a * b, tiled = s21::ReadMatrix<double>(c_path);
+  s21::MulMatrixFiles<double>(a_path, b_path, c_path, 1 << 30);
+  S21Matrix whole = s21::ReadMatrix<double>(c_path);
+  for (int i = 0; i < 45; i++)
+    for (int j = 0; j < 38; j++) {
+      EXPECT_NEAR(tiled(i, j), product(i, j), 1e-9);
+      EXPECT_NEAR(whole(i, j), product(i, j), 1e-9);
+    }
+  s21::WriteMatrix(b_path, a2);
+  s21::SumMatrixFiles<double>(a_path, b_path, c_path, budget);
+  EXPECT_TRUE(s21::ReadMatrix<double>(c_path) == S21Matrix(a + a2));
+  s21::SubMatrixFiles<double>(a_path, b_path, c_path, 2 << 10);
+  EXPECT_TRUE(s21::ReadMatrix<double>(c_path) == S21Matrix(a - a2));
+
+  s21::WriteMatrix(b_path, b);
+  EXPECT_THROW(s21::SumMatrixFiles<double>(a_path, b_path, c_path, budget),
+               std::logic_error);
+  EXPECT_THROW(s21::MulMatrixFiles<double>(a_path, a_path, c_path, budget),
+               std::logic_error);
+  EXPECT_THROW(s21::SumMatrixFiles<double>(a_path, a_path, c_path, 256),
+               std::invalid_argument);
+  EXPECT_THROW(s21::MulMatrixFiles<double>(a_path, a_path, a_path, budget),
+               std::invalid_argument);
+  EXPECT_THROW(s21::SumMatrixFiles<float>(a_path, a_path, c_path, budget),
+               std::runtime_error);
+
+  S21Matrix no_rows;  //0 x 70 даёт результат без строк
+  no_rows.Reserve(0, 70);
+  s21::WriteMatrix(a_path, no_rows);
+  s21::SumMatrixFiles<double>(a_path, a_path, c_path, budget);
+  EXPECT_EQ(s21::ReadMatrix<double>(c_path).GetCols(), 70);
+  s21::WriteMatrix(b_path, b);
+  stats = s21::MulMatrixFiles<double>(a_path, b_path, c_path, budget);
+  EXPECT_EQ(stats.bytes_written, 0u);
+  S21Matrix empty_product = s21::ReadMatrix<double>(c_path);
+  EXPECT_EQ(empty_product.GetRows(), 0);
+  EXPECT_EQ(empty_product.GetCols(), 38);
+  s21::WriteMatrix(a_path, S21Matrix());
+  EXPECT_THROW(s21::SumMatrixFiles<double>(a_path, a_path, c_path, budget),
+               std::runtime_error);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+TEST(MatrixProfileSuite, CountersTest) {
+  S21Matrix a = IoSample(6, 5), b = IoSample(5, 4);
+  S21Matrix square(3, 3);
+  square(0, 0) = 2, square(1, 1) = 3, square(2, 2) = 4, square(0, 2) = 1;
+  s21::ResetProfile();
+  S21Matrix product = a * b;
+  S21Matrix copy = a;
+  copy += a;
+  copy.SumMatrix(a);
+  square.InverseMatrix();
+  EXPECT_TRUE(copy == copy);
+  s21::ProfileSnapshot snapshot = s21::GetProfileSnapshot();
+  const s21::OperationProfile &multiply =
+      snapshot[s21::Operation::kMulMatrix];
+  const std::uint64_t enabled = s21::IsProfilingEnabled();
+  EXPECT_EQ(multiply.calls, enabled);
+  EXPECT_EQ(multiply.flops, enabled * 2 * 6 * 4 * 5);
+  EXPECT_GE(multiply.bytes_allocated, enabled * 6 * 4 * sizeof(double));
+  EXPECT_EQ(snapshot[s21::Operation::kSumMatrix].calls, 2 * enabled);
+  EXPECT_EQ(snapshot[s21::Operation::kEqMatrix].calls, enabled);
+  // Определитель внутри InverseMatrix отдельно не считается.
+  EXPECT_EQ(snapshot[s21::Operation::kInverseMatrix].calls, enabled);
+  EXPECT_EQ(snapshot[s21::Operation::kDeterminant].calls, 0u);
+  std::uint64_t histogram = 0;
+  for (std::uint64_t bucket : multiply.latency_buckets) histogram += bucket;
+  EXPECT_EQ(histogram, multiply.calls);
+  EXPECT_EQ(std::string(s21::OperationName(s21::Operation::kMulMatrix)),
+            "mul_matrix");
+  EXPECT_DOUBLE_EQ(s21::LatencyBucketBound(1), 1e-5);
+
+  const std::string path = testing::TempDir() + "s21_profile_test.prom";
+  s21::WriteProfile(path);
+  std::ifstream file(path);
+  std::string text((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+  EXPECT_NE(text.find("s21_matrix_calls_total{op=\"sum_matrix\"} " +
+                      std::to_string(2 * enabled) + "\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("s21_matrix_latency_seconds_bucket{op=\"mul_matrix\","
+                      "le=\"+Inf\"} " +
+                      std::to_string(enabled) + "\n"),
+            std::string::npos);
+  EXPECT_THROW(s21::WriteProfile(testing::TempDir() + "missing/dir/file"),
+               std::runtime_error);
+  std::remove(path.c_str());
+  s21::ResetProfile();
+  EXPECT_EQ(s21::GetProfileSnapshot()[s21::Operation::kSumMatrix].calls, 0u);
+}
+
+TEST(MatrixOperatorSuite, MoveTest) {
+  S21Matrix a = IoSample(5, 7), b = IoSample(5, 7), copy = a;
+  b *= 3.0;
+  const S21Matrix sum = a + b, difference = a - b;
+  double *data = a.GetData();
+  S21Matrix moved;
+  moved = std::move(a);
+  EXPECT_EQ(moved.GetData(), data);
+  EXPECT_EQ(a.GetData(), nullptr);
+  EXPECT_EQ(a.GetRows(), 0);
+
+  // Временный операнд отдаёт буфер результату.
+  S21Matrix result = std::move(moved) + b;
+  EXPECT_EQ(result.GetData(), data);
+  EXPECT_TRUE(result == sum);
+  S21Matrix left = copy;
+  data = left.GetData();
+  result = std::move(left) - b;
+  EXPECT_EQ(result.GetData(), data);
+  EXPECT_TRUE(result == difference);
+  S21Matrix right = b;
+  data = right.GetData();
+  result = copy - std::move(right);
+  EXPECT_EQ(result.GetData(), data);
+  EXPECT_TRUE(result == difference);
+  right = b;
+  result = b * 2.0 - std::move(right);  //левая часть читает правую
+  EXPECT_TRUE(result == b);
+  right = b;
+  result = copy + S21Matrix(b) + std::move(right) * 0.0;
+  EXPECT_TRUE(result == sum);
+  result = std::move(result) * 2.0;
+  EXPECT_DOUBLE_EQ(result(4, 6), 2 * sum(4, 6));
+  S21MatrixF single(2, 2);
+  single = 0.5 * std::move(single);
+  EXPECT_EQ(single.GetRows(), 2);
+  EXPECT_THROW(std::move(result) + IoSample(2, 2), std::logic_error);
+}
+
+TEST(MatrixOperatorSuite, ZeroAllocationLoopTest) {
+  S21Matrix a = IoSample(30, 20), b = IoSample(20, 40), c = IoSample(30, 20);
+  S21Matrix product, transposed, sum(30, 20), x = a, temporary;
+  s21::Multiply(a, b, product);
+  EXPECT_TRUE(product == a * b);
+  s21::Transpose(product, transposed);
+  EXPECT_TRUE(transposed == (a * b).Transpose());
+
+  s21::ResetAllocationStats();
+  for (int i = 0; i < 50; i++) {
+    s21::Multiply(a, b, product);
+    s21::Transpose(product, transposed);
+    sum = a + c * 2.0;
+    sum += a;
+    temporary = std::move(x) + c;
+    x = std::move(temporary);
+    x -= c;
+  }
+  EXPECT_EQ(s21::GetAllocationStats().allocations, 0u);
+  EXPECT_TRUE(x == a);
+  EXPECT_TRUE(transposed == (a * b).Transpose());
+
+  // Меньший размер помещается в буфер результата.
+  s21::Multiply(S21Matrix(a.Block(0, 0, 10, 20)), b, product);
+  s21::ResetAllocationStats();
+  s21::Multiply(a, b, product);
+  EXPECT_EQ(s21::GetAllocationStats().allocations, 0u);
+  EXPECT_TRUE(product == a * b);
+  s21::Multiply(product, product.Transpose(), product);
+  EXPECT_EQ(product.GetRows(), 30);
+  s21::Transpose(product, product);
+  S21Matrix empty;
+  s21::Transpose(empty, product);
+  EXPECT_EQ(product.GetRows(), 0);
+  EXPECT_THROW(s21::Multiply(a, a, product), std::logic_error);
+}
+
 TEST(MatrixOperatorSuite, MultiplicationTest) {
   S21Matrix testMatrix(3, 3);
   S21Matrix testMatrix2(3, 3);
@@ -407,6 +1896,177 @@ TEST(MatrixOperatorSuite, MultiplicationTest) {
   EXPECT_DOUBLE_EQ(resultMatrix(2, 1), 36.0);
 }
 
+// Сравнивает произведение по Штрассену с классическим; погрешность
+// Штрассена оценивается только по норме, поэтому допуск общий.
+template <typename T>
+void ExpectStrassenNear(int m, int n, int k, int crossover,
+                        double tolerance) {
+  S21BasicMatrix<T> a(m, k), b(k, n);
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < k; j++) a(i, j) = std::sin(i * 0.7 + j * 1.3);
+  for (int i = 0; i < k; i++)
+    for (int j = 0; j < n; j++) b(i, j) = std::cos(i + 2.0 * j);
+  S21BasicMatrix<T> classical = a * b;
+  S21BasicMatrix<T> fast = s21::StrassenMultiply(a, b, crossover);
+  ASSERT_EQ(fast.GetRows(), m);
+  ASSERT_EQ(fast.GetCols(), n);
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < n; j++)
+      EXPECT_NEAR(fast(i, j) - classical(i, j), 0, tolerance * k);
+}
+
+TEST(MatrixStrassenSuite, MultiplyTest) {
+  // Малый порог даёт несколько уровней рекурсии и дополнение нулями.
+  ExpectStrassenNear<double>(64, 64, 64, 8, 1e-14);
+  ExpectStrassenNear<double>(67, 45, 91, 8, 1e-14);
+  ExpectStrassenNear<double>(33, 130, 40, 5, 1e-14);
+  ExpectStrassenNear<double>(8, 200, 200, 8, 1e-14);  //без рекурсии
+  ExpectStrassenNear<float>(70, 70, 70, 16, 1e-5);
+  ExpectStrassenNear<long double>(50, 40, 30, 7, 1e-17);
+
+  // Уровни 32, 16 и 8: по два блока, вместе меньше 2/3 от 64^2.
+  EXPECT_EQ(s21::StrassenWorkspace(64, 64, 64, 8), 2688u);
+  EXPECT_EQ(s21::StrassenWorkspace(64, 64, 64, 64), 0u);
+  EXPECT_GT(s21::StrassenWorkspace(65, 64, 64, 8),
+            s21::StrassenWorkspace(72, 64, 64, 8));
+
+  S21Matrix a(3, 4), b(3, 4);
+  EXPECT_THROW(s21::StrassenMultiply(a, b), std::logic_error);
+  EXPECT_THROW(s21::StrassenMultiply(a, b.Transpose(), 0),
+               std::invalid_argument);
+}
+
+TEST(MatrixChainSuite, MultiplyChainTest) {
+  // Пример из учебника Кормена: 15125 умножений при лучшем порядке.
+  const int dimensions[] = {30, 35, 15, 5, 10, 20, 25};
+  std::vector<S21Matrix> factors;
+  for (int i = 0; i < 6; i++) {
+    factors.push_back(S21Matrix(dimensions[i], dimensions[i + 1]));
+    for (int r = 0; r < dimensions[i]; r++)
+      for (int c = 0; c < dimensions[i + 1]; c++)
+        factors[i](r, c) = std::sin(r * 0.3 + c * 0.7 + i);
+  }
+  S21MatrixChain chain;
+  for (const S21Matrix &factor : factors) chain.Add(factor);
+  EXPECT_EQ(chain.GetSize(), 6);
+  EXPECT_DOUBLE_EQ(chain.GetFlops(), 2 * 15125.0);
+  EXPECT_DOUBLE_EQ(chain.GetLeftToRightFlops(), 2 * 40500.0);
+  EXPECT_EQ(chain.GetOrder(), "((A0 (A1 A2)) ((A3 A4) A5))");
+
+  S21Matrix expected = factors[0];
+  for (int i = 1; i < 6; i++) expected *= factors[i];
+  S21Matrix product = chain.Multiply();
+  ASSERT_EQ(product.GetRows(), 30);
+  ASSERT_EQ(product.GetCols(), 25);
+  for (int i = 0; i < 30; i++)
+    for (int j = 0; j < 25; j++)
+      EXPECT_NEAR(product(i, j), expected(i, j), 1e-9);
+
+  // Повторное умножение берёт буферы промежуточных и результата с
+  // прошлого раза.
+  s21::ResetAllocationStats();
+  chain.Multiply(product);
+  EXPECT_EQ(s21::GetAllocationStats().allocations, 0u);
+  S21Matrix short_product =
+      s21::MultiplyChain(factors[3], factors[4], factors[5]);
+  EXPECT_NEAR(short_product(4, 24),
+              (factors[3] * factors[4] * factors[5])(4, 24), 1e-9);
+
+  // Результат на место операнда: последнее произведение не портит его.
+  S21Matrix first = factors[0], transposed = factors[0].Transpose();
+  S21MatrixChain square;
+  square.Add(first).Add(transposed).Add(first);
+  square.Multiply(first);
+  S21Matrix gram = factors[0] * factors[0].Transpose() * factors[0];
+  EXPECT_NEAR(first(29, 34), gram(29, 34), 1e-9);
+  chain.Clear();
+  EXPECT_EQ(chain.GetFlops(), 0);
+  EXPECT_THROW(chain.Multiply(), std::logic_error);
+  chain.Add(factors[0]);
+  EXPECT_TRUE(chain.Multiply() == factors[0]);
+  EXPECT_THROW(chain.Add(factors[0]), std::logic_error);
+  EXPECT_THROW(chain.Add(S21Matrix()), std::logic_error);
+}
+
+// Отличие от обратной и определителя, посчитанных заново: у
+// определителя — относительное, у обратной — максимум модуля разности.
+double MaintainedError(const S21MaintainedInverse &maintained) {
+  const S21Matrix &matrix = maintained.GetMatrix();
+  const S21Matrix &updated = maintained.GetInverse();
+  S21Matrix inverse = matrix.InverseMatrix();
+  const double determinant = matrix.Determinant();
+  double error = std::fabs(maintained.Determinant() - determinant) /
+                 std::fabs(determinant);
+  for (int i = 0; i < inverse.GetRows(); i++)
+    for (int j = 0; j < inverse.GetCols(); j++)
+      error = std::max(error, std::fabs(updated(i, j) - inverse(i, j)));
+  return error;
+}
+
+TEST(MatrixUpdateSuite, MaintainedInverseTest) {
+  const int n = 7;
+  S21Matrix matrix(n, n);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+      matrix(i, j) = i == j ? 10 : std::sin(i * 1.7 + j * 0.9);
+  S21MaintainedInverse maintained(matrix);
+  EXPECT_EQ(maintained.GetSize(), n);
+  EXPECT_EQ(maintained.GetRefactorCount(), 1);
+  EXPECT_LT(MaintainedError(maintained), 1e-12);
+
+  double row[n], column[n], u[n], v[n];
+  for (int step = 0; step < 20; step++) {
+    for (int k = 0; k < n; k++) {
+      row[k] = std::cos(step + k * 2.1) + (k == step % n ? 9 : 0);
+      column[k] = std::sin(step * 0.3 + k) + (k == (step + 3) % n ? 8 : 0);
+      u[k] = std::cos(step * k * 0.1);
+      v[k] = 0.2 * std::sin(step + k);
+    }
+    maintained.UpdateRow(step % n, row);
+    maintained.UpdateColumn((step + 3) % n, column);
+    maintained.RankOneUpdate(u, v);
+    ASSERT_LT(MaintainedError(maintained), 1e-9) << "step " << step;
+  }
+  EXPECT_EQ(maintained.GetRefactorCount(), 1);  //обновлений хватило
+  EXPECT_LT(maintained.GetResidual(), 1e-12);
+
+  // Две равные строки: вырожденная, затем снова обратимая.
+  const double *first = maintained.GetMatrix()[0];
+  std::copy(first, first + n, row);
+  double saved[n];
+  std::copy(maintained.GetMatrix()[1], maintained.GetMatrix()[1] + n, saved);
+  maintained.UpdateRow(1, row);
+  EXPECT_EQ(maintained.Determinant(), 0);
+  EXPECT_THROW(maintained.GetInverse(), std::logic_error);
+  maintained.UpdateRow(1, saved);
+  EXPECT_LT(MaintainedError(maintained), 1e-9);
+  EXPECT_GT(maintained.GetRefactorCount(), 1);
+
+  // Нулевой порог: любая невязка ведёт к новому разложению.
+  S21MaintainedInverse strict(matrix, 0.0);
+  v[0] = 1e-3;
+  strict.RankOneUpdate(u, v);
+  EXPECT_EQ(strict.GetRefactorCount(), 2);
+  EXPECT_LT(MaintainedError(strict), 1e-12);
+
+  // Плохой масштаб не делает матрицу вырожденной.
+  S21Matrix scaled(4, 4);
+  for (int i = 0; i < 4; i++) scaled[i][i] = 1;
+  scaled[0][0] = 1e20;
+  S21MaintainedInverse badly_scaled(scaled);
+  EXPECT_DOUBLE_EQ(badly_scaled.Determinant(), 1e20);
+  EXPECT_DOUBLE_EQ(badly_scaled.GetInverse()[0][0], 1e-20);
+  const double last_row[4] = {0, 0, 2, 1e-16};
+  badly_scaled.UpdateRow(3, last_row);
+  EXPECT_NEAR(badly_scaled.Determinant(), 1e4, 1e-6);
+  EXPECT_NEAR(badly_scaled.GetInverse()[3][2], -2e16, 1e2);
+
+  EXPECT_THROW(maintained.UpdateRow(n, row), std::out_of_range);
+  EXPECT_THROW(maintained.UpdateColumn(-1, row), std::out_of_range);
+  EXPECT_THROW(S21MaintainedInverse(S21Matrix(2, 3)), std::logic_error);
+  EXPECT_THROW(S21MaintainedInverse(matrix, -1.0), std::invalid_argument);
+}
+
 int main() {
   testing::InitGoogleTest();
   // testing::GTEST_FLAG(filter) = "MatrixConstructorSuite*";